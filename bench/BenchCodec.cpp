@@ -0,0 +1,143 @@
+#include "BenchUtils.hpp"
+
+#include <fstream>
+
+/*
+ * Decoding (ImageFactory::createImageFromMemory, so the disk is not measured) and encoding (IImage::write) for every
+ * codec and size. The encoded files are written to the temporary directory. PNG encoding is also measured for every
+ * compression level and thread count, JPG encoding for several qualities and chroma subsamplings with the scalar and
+ * the AVX2 kernels.
+ */
+
+namespace Velyra::Bench {
+
+    namespace {
+
+        struct Codec {
+            const char* name;
+            VL_IMAGE_TYPE fileType;
+            VL_TYPE dataType;
+            const char* extension;
+        };
+
+        constexpr std::array<Codec, 5> CODECS = {{
+            {"PNG", VL_IMAGE_PNG, VL_UINT8, ".png"},
+            {"PNG16", VL_IMAGE_PNG, VL_UINT16, ".png"},
+            {"JPG", VL_IMAGE_JPG, VL_UINT8, ".jpg"},
+            {"BMP", VL_IMAGE_BMP, VL_UINT8, ".bmp"},
+            {"HDR", VL_IMAGE_HDR, VL_FLOAT32, ".hdr"},
+        }};
+
+        fs::path getFilePath(const Codec& codec, const ImageSize& size, const char* operation) {
+            return fs::temp_directory_path() / (std::string("VelyraImageBench-") + operation + "-" + codec.name + "-" +
+                size.name + codec.extension);
+        }
+
+        void benchmarkWrite(benchmark::State& state, const Codec codec, const ImageSize size) {
+            const UP<IImage> image = createSyntheticImage(codec.dataType, size.width, size.height, VL_CHANNEL_RGB);
+            ImageWriteDesc desc;
+            desc.fileName = getFilePath(codec, size, "write");
+            desc.fileType = codec.fileType;
+            for (auto _ : state) {
+                image->write(desc);
+            }
+            reportThroughput(state, image->getSize());
+            fs::remove(desc.fileName);
+        }
+
+        void benchmarkPngWrite(benchmark::State& state, const Codec codec, const ImageSize size, const U32 level,
+            const Size threadCount) {
+            const ExecutorScope executorScope(threadCount);
+            const UP<IImage> image = createSyntheticImage(codec.dataType, size.width, size.height, VL_CHANNEL_RGB);
+            ImageWriteDesc desc;
+            desc.fileName = getFilePath(codec, size, "write-level");
+            desc.fileType = codec.fileType;
+            desc.compressionLevel = level;
+            desc.executionPolicy = getExecutionPolicy(threadCount);
+            for (auto _ : state) {
+                image->write(desc);
+            }
+            reportThroughput(state, image->getSize());
+            state.counters["bytes"] = static_cast<double>(fs::file_size(desc.fileName));
+            fs::remove(desc.fileName);
+        }
+
+        void benchmarkJpgWrite(benchmark::State& state, const Codec codec, const ImageSize size, const U32 quality,
+            const VL_JPG_SUBSAMPLING subsampling, const VL_SIMD_MODE mode) {
+            if (!checkSimdMode(state, mode)) {
+                return;
+            }
+            const UP<IImage> image = createSyntheticImage(codec.dataType, size.width, size.height, VL_CHANNEL_RGB);
+            ImageWriteDesc desc;
+            desc.fileName = getFilePath(codec, size, "write-quality");
+            desc.fileType = codec.fileType;
+            desc.jpgQuality = quality;
+            desc.jpgSubsampling = subsampling;
+            desc.simdMode = mode;
+            for (auto _ : state) {
+                image->write(desc);
+            }
+            reportThroughput(state, image->getSize());
+            state.counters["bytes"] = static_cast<double>(fs::file_size(desc.fileName));
+            fs::remove(desc.fileName);
+        }
+
+        void benchmarkLoad(benchmark::State& state, const Codec codec, const ImageSize size) {
+            ImageWriteDesc writeDesc;
+            writeDesc.fileName = getFilePath(codec, size, "load");
+            writeDesc.fileType = codec.fileType;
+            createSyntheticImage(codec.dataType, size.width, size.height, VL_CHANNEL_RGB)->write(writeDesc);
+
+            std::ifstream file(writeDesc.fileName, std::ios::binary);
+            const std::vector<char> encoded((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            fs::remove(writeDesc.fileName);
+            const std::span<const std::byte> data(reinterpret_cast<const std::byte*>(encoded.data()), encoded.size());
+
+            ImageLoadDesc desc;
+            desc.fileName = writeDesc.fileName;
+            desc.flipOnLoad = false;
+            Size decodedBytes = 0;
+            for (auto _ : state) {
+                UP<IImage> image = ImageFactory::createImageFromMemory(data, desc);
+                decodedBytes = image->getSize();
+                benchmark::DoNotOptimize(image->getData());
+            }
+            reportThroughput(state, decodedBytes);
+        }
+
+        const bool registered = [] {
+            for (const Codec& codec : CODECS) {
+                for (const ImageSize& size : IMAGE_SIZES) {
+                    const std::string suffix = std::string(codec.name) + "/" + size.name;
+                    benchmark::RegisterBenchmark(("load/" + suffix).c_str(), benchmarkLoad, codec, size)->UseRealTime();
+                    benchmark::RegisterBenchmark(("write/" + suffix).c_str(), benchmarkWrite, codec, size)->UseRealTime();
+                    if (codec.fileType == VL_IMAGE_JPG) {
+                        for (const U32 quality : {75u, 90u, 100u}) {
+                            for (const VL_JPG_SUBSAMPLING subsampling : {VL_JPG_SUBSAMPLING_444, VL_JPG_SUBSAMPLING_420}) {
+                                for (const VL_SIMD_MODE mode : {VL_SIMD_SCALAR, VL_SIMD_AVX2}) {
+                                    const std::string name = "write/" + suffix + "/quality:" + std::to_string(quality) +
+                                        (subsampling == VL_JPG_SUBSAMPLING_444 ? "/444/" : "/420/") + getSimdModeName(mode);
+                                    benchmark::RegisterBenchmark(name.c_str(), benchmarkJpgWrite, codec, size, quality,
+                                        subsampling, mode)->UseRealTime();
+                                }
+                            }
+                        }
+                    }
+                    if (codec.fileType != VL_IMAGE_PNG) {
+                        continue;
+                    }
+                    for (const U32 level : {1u, 6u, 9u}) {
+                        for (const Size threadCount : getThreadCounts()) {
+                            const std::string name = "write/" + suffix + "/level:" + std::to_string(level) + "/threads:" +
+                                std::to_string(threadCount);
+                            benchmark::RegisterBenchmark(name.c_str(), benchmarkPngWrite, codec, size, level, threadCount)->UseRealTime();
+                        }
+                    }
+                }
+            }
+            return true;
+        }();
+
+    }
+
+}
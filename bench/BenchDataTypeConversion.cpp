@@ -0,0 +1,64 @@
+#include "BenchUtils.hpp"
+
+/*
+ * IImage::translateDataType in both directions for every type pair with kernels, size, SIMD mode and thread count.
+ * Filter with --benchmark_filter, for example "translateDataType/U8->F32/AVX2".
+ */
+
+namespace Velyra::Bench {
+
+    namespace {
+
+        struct TypePair {
+            VL_TYPE sourceType;
+            VL_TYPE targetType;
+        };
+
+        constexpr std::array<TypePair, 10> TYPE_PAIRS = {{
+            {VL_UINT8, VL_FLOAT32}, {VL_FLOAT32, VL_UINT8},
+            {VL_UINT8, VL_UINT16}, {VL_UINT16, VL_UINT8},
+            {VL_UINT16, VL_FLOAT32}, {VL_FLOAT32, VL_UINT16},
+            {VL_FLOAT16, VL_FLOAT32}, {VL_FLOAT32, VL_FLOAT16},
+            {VL_UINT8, VL_FLOAT16}, {VL_FLOAT16, VL_UINT8},
+        }};
+
+        void benchmarkTranslateDataType(benchmark::State& state, const TypePair types, const ImageSize size,
+            const VL_SIMD_MODE mode, const Size threadCount) {
+            if (!checkSimdMode(state, mode)) {
+                return;
+            }
+            const ExecutorScope executorScope(threadCount);
+            const UP<IImage> image = createSyntheticImage(types.sourceType, size.width, size.height, VL_CHANNEL_RGBA);
+
+            TranslationDesc desc;
+            desc.targetType = types.targetType;
+            desc.simdMode = mode;
+            desc.executionPolicy = getExecutionPolicy(threadCount);
+            for (auto _ : state) {
+                UP<IImage> translated = image->translateDataType(desc);
+                benchmark::DoNotOptimize(translated->getData());
+            }
+            const Size count = size.width * size.height * 4;
+            reportThroughput(state, count * (Utils::getTypeSize(types.sourceType) + Utils::getTypeSize(types.targetType)));
+        }
+
+        const bool registered = [] {
+            for (const TypePair& types : TYPE_PAIRS) {
+                for (const ImageSize& size : IMAGE_SIZES) {
+                    for (const VL_SIMD_MODE mode : SIMD_MODES) {
+                        for (const Size threadCount : getThreadCounts()) {
+                            const std::string name = std::string("translateDataType/") + getTypeName(types.sourceType) +
+                                "->" + getTypeName(types.targetType) + "/" + getSimdModeName(mode) + "/" + size.name +
+                                "/threads:" + std::to_string(threadCount);
+                            benchmark::RegisterBenchmark(name.c_str(), benchmarkTranslateDataType, types, size, mode,
+                                threadCount)->UseRealTime();
+                        }
+                    }
+                }
+            }
+            return true;
+        }();
+
+    }
+
+}
@@ -0,0 +1,60 @@
+#include "BenchUtils.hpp"
+
+/*
+ * IImage::convertToFormat for every format pair, type, size, SIMD mode and thread count.
+ * Filter with --benchmark_filter, for example "convertToFormat/U8/RGBA->BGRA/AVX2/4K".
+ */
+
+namespace Velyra::Bench {
+
+    namespace {
+
+        void benchmarkConvertToFormat(benchmark::State& state, const VL_TYPE type, const VL_CHANNEL_FORMAT sourceFormat,
+            const VL_CHANNEL_FORMAT targetFormat, const ImageSize size, const VL_SIMD_MODE mode, const Size threadCount) {
+            if (!checkSimdMode(state, mode)) {
+                return;
+            }
+            const ExecutorScope executorScope(threadCount);
+            const UP<IImage> image = createSyntheticImage(type, size.width, size.height, sourceFormat);
+
+            FormatConversionDesc desc;
+            desc.targetFormat = targetFormat;
+            desc.simdMode = mode;
+            desc.executionPolicy = getExecutionPolicy(threadCount);
+            for (auto _ : state) {
+                UP<IImage> converted = image->convertToFormat(desc);
+                benchmark::DoNotOptimize(converted->getData());
+            }
+            const Size bytesPerChannel = Utils::getTypeSize(type);
+            const Size pixelCount = size.width * size.height;
+            reportThroughput(state, pixelCount * bytesPerChannel *
+                (getChannelCountFromFormat(sourceFormat) + getChannelCountFromFormat(targetFormat)));
+        }
+
+        const bool registered = [] {
+            for (const VL_TYPE type : DATA_TYPES) {
+                for (const VL_CHANNEL_FORMAT sourceFormat : CHANNEL_FORMATS) {
+                    for (const VL_CHANNEL_FORMAT targetFormat : CHANNEL_FORMATS) {
+                        if (sourceFormat == targetFormat) {
+                            continue;
+                        }
+                        for (const ImageSize& size : IMAGE_SIZES) {
+                            for (const VL_SIMD_MODE mode : SIMD_MODES) {
+                                for (const Size threadCount : getThreadCounts()) {
+                                    const std::string name = std::string("convertToFormat/") + getTypeName(type) + "/" +
+                                        getFormatName(sourceFormat) + "->" + getFormatName(targetFormat) + "/" +
+                                        getSimdModeName(mode) + "/" + size.name + "/threads:" + std::to_string(threadCount);
+                                    benchmark::RegisterBenchmark(name.c_str(), benchmarkConvertToFormat, type, sourceFormat,
+                                        targetFormat, size, mode, threadCount)->UseRealTime();
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            return true;
+        }();
+
+    }
+
+}
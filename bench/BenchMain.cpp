@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+/*
+ * The benchmarks register themselves, every file covers one area of the library:
+ *  - BenchMemcpy: memcpy baseline
+ *  - BenchFormatConversion: IImage::convertToFormat
+ *  - BenchDataTypeConversion: IImage::translateDataType
+ *  - BenchResize: IImage::resize
+ *  - BenchCodec: loading and writing per codec
+ * Every benchmark reports its throughput in GB/s next to the throughput of memcpy for the same number of bytes.
+ */
+
+int main(int argc, char** argv) {
+    // Builds with VELYRA_IMAGE_HOT_PATH_LOGGING log every created image, which would drown the results
+    spdlog::set_level(spdlog::level::warn);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
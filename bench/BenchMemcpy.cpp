@@ -0,0 +1,38 @@
+#include "BenchUtils.hpp"
+
+#include <cstring>
+
+/*
+ * memcpy of an RGBA image of every type and size, the upper bound for the throughput of a conversion that reads
+ * and writes the same number of bytes.
+ */
+
+namespace Velyra::Bench {
+
+    namespace {
+
+        void benchmarkMemcpy(benchmark::State& state, const Size bytes) {
+            std::vector<char> source(bytes, 1);
+            std::vector<char> target(bytes, 0);
+            for (auto _ : state) {
+                std::memcpy(target.data(), source.data(), bytes);
+                benchmark::DoNotOptimize(target.data());
+                benchmark::ClobberMemory();
+            }
+            reportThroughput(state, 2 * bytes);
+        }
+
+        const bool registered = [] {
+            for (const VL_TYPE type : DATA_TYPES) {
+                for (const ImageSize& size : IMAGE_SIZES) {
+                    const Size bytes = size.width * size.height * 4 * Utils::getTypeSize(type);
+                    const std::string name = std::string("memcpy/") + getTypeName(type) + "_RGBA/" + size.name;
+                    benchmark::RegisterBenchmark(name.c_str(), benchmarkMemcpy, bytes)->UseRealTime();
+                }
+            }
+            return true;
+        }();
+
+    }
+
+}
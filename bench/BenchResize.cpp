@@ -0,0 +1,43 @@
+#include "BenchUtils.hpp"
+
+/*
+ * IImage::resize (stb_image_resize2) for every type, size and thread count, halving and doubling the size.
+ * The resize has no SIMD mode of its own, it always uses the best build of stb_image_resize2 for the CPU.
+ */
+
+namespace Velyra::Bench {
+
+    namespace {
+
+        void benchmarkResize(benchmark::State& state, const VL_TYPE type, const ImageSize size, const double scale,
+            const Size threadCount) {
+            const ExecutorScope executorScope(threadCount);
+            const UP<IImage> image = createSyntheticImage(type, size.width, size.height, VL_CHANNEL_RGBA);
+            const auto targetWidth = std::max<Size>(static_cast<Size>(static_cast<double>(size.width) * scale), 1);
+            const auto targetHeight = std::max<Size>(static_cast<Size>(static_cast<double>(size.height) * scale), 1);
+            for (auto _ : state) {
+                UP<IImage> resized = image->resize(targetWidth, targetHeight);
+                benchmark::DoNotOptimize(resized->getData());
+            }
+            const Size pixelBytes = 4 * Utils::getTypeSize(type);
+            reportThroughput(state, (size.width * size.height + targetWidth * targetHeight) * pixelBytes);
+        }
+
+        const bool registered = [] {
+            for (const VL_TYPE type : DATA_TYPES) {
+                for (const ImageSize& size : IMAGE_SIZES) {
+                    for (const double scale : {0.5, 2.0}) {
+                        for (const Size threadCount : getThreadCounts()) {
+                            const std::string name = std::string("resize/") + getTypeName(type) + "/" +
+                                (scale < 1.0 ? "half" : "double") + "/" + size.name + "/threads:" + std::to_string(threadCount);
+                            benchmark::RegisterBenchmark(name.c_str(), benchmarkResize, type, size, scale, threadCount)->UseRealTime();
+                        }
+                    }
+                }
+            }
+            return true;
+        }();
+
+    }
+
+}
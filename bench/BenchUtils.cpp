@@ -0,0 +1,188 @@
+#include "BenchUtils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <thread>
+
+namespace Velyra::Bench {
+
+    const char* getSimdModeName(const VL_SIMD_MODE mode) {
+        switch (mode) {
+            case VL_SIMD_BEST:   return "BEST";
+            case VL_SIMD_SCALAR: return "SCALAR";
+            case VL_SIMD_SSE2:   return "SSE2";
+            case VL_SIMD_SSSE3:  return "SSSE3";
+            case VL_SIMD_SSE41:  return "SSE41";
+            case VL_SIMD_AVX2:   return "AVX2";
+            case VL_SIMD_AVX512: return "AVX512";
+            default:             return "UNKNOWN";
+        }
+    }
+
+    const char* getFormatName(const VL_CHANNEL_FORMAT format) {
+        switch (format) {
+            case VL_CHANNEL_R:    return "R";
+            case VL_CHANNEL_RG:   return "RG";
+            case VL_CHANNEL_RGB:  return "RGB";
+            case VL_CHANNEL_RGBA: return "RGBA";
+            case VL_CHANNEL_BGR:  return "BGR";
+            case VL_CHANNEL_BGRA: return "BGRA";
+            default:              return "UNKNOWN";
+        }
+    }
+
+    const char* getTypeName(const VL_TYPE type) {
+        switch (type) {
+            case VL_UINT8:   return "U8";
+            case VL_UINT16:  return "U16";
+            case VL_FLOAT16: return "F16";
+            case VL_FLOAT32: return "F32";
+            default:         return "UNKNOWN";
+        }
+    }
+
+    std::vector<Size> getThreadCounts() {
+        const Size hardwareThreads = std::max<Size>(std::thread::hardware_concurrency(), 1);
+        std::vector<Size> threadCounts;
+        for (Size threads = 1; threads < hardwareThreads; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(hardwareThreads);
+        return threadCounts;
+    }
+
+    namespace {
+
+        template<typename T>
+        T toPixel(const float value) {
+            if constexpr (std::is_same_v<T, U8>) {
+                return static_cast<U8>(value * 255.0f + 0.5f);
+            }
+            else if constexpr (std::is_same_v<T, U16>) {
+                return static_cast<U16>(value * 65535.0f + 0.5f);
+            }
+            else if constexpr (std::is_same_v<T, F16>) {
+                return floatToF16(value);
+            }
+            else {
+                return value;
+            }
+        }
+
+        template<typename T>
+        std::vector<T> createPattern(const Size width, const Size height, const U32 channelCount) {
+            std::vector<T> pixels(width * height * channelCount);
+            U32 noise = 0x12345678;
+            for (Size y = 0; y < height; ++y) {
+                for (Size x = 0; x < width; ++x) {
+                    for (U32 c = 0; c < channelCount; ++c) {
+                        // xorshift noise of +-2% on top of a gradient that differs per channel
+                        noise ^= noise << 13;
+                        noise ^= noise >> 17;
+                        noise ^= noise << 5;
+                        const float gradient = static_cast<float>((x + y * (c + 1)) % 256) / 255.0f;
+                        const float jitter = (static_cast<float>(noise & 0xFF) / 255.0f - 0.5f) * 0.04f;
+                        pixels[(y * width + x) * channelCount + c] = toPixel<T>(std::clamp(gradient + jitter, 0.0f, 1.0f));
+                    }
+                }
+            }
+            return pixels;
+        }
+
+        template<typename T, typename Desc>
+        Desc createDesc(const std::vector<T>& pixels, const Size width, const Size height, const VL_CHANNEL_FORMAT format) {
+            Desc desc;
+            desc.width = width;
+            desc.height = height;
+            desc.format = format;
+            desc.data = pixels.data();
+            return desc;
+        }
+
+    }
+
+    UP<IImage> createSyntheticImage(const VL_TYPE type, const Size width, const Size height, const VL_CHANNEL_FORMAT format) {
+        const U32 channelCount = getChannelCountFromFormat(format);
+        switch (type) {
+            case VL_UINT8: {
+                const auto pixels = createPattern<U8>(width, height, channelCount);
+                return ImageFactory::createImageU8(createDesc<U8, ImageU8Desc>(pixels, width, height, format));
+            }
+            case VL_UINT16: {
+                const auto pixels = createPattern<U16>(width, height, channelCount);
+                return ImageFactory::createImageU16(createDesc<U16, ImageUI16Desc>(pixels, width, height, format));
+            }
+            case VL_FLOAT16: {
+                const auto pixels = createPattern<F16>(width, height, channelCount);
+                return ImageFactory::createImageF16(createDesc<F16, ImageF16Desc>(pixels, width, height, format));
+            }
+            default: {
+                const auto pixels = createPattern<float>(width, height, channelCount);
+                return ImageFactory::createImageF32(createDesc<float, ImageF32Desc>(pixels, width, height, format));
+            }
+        }
+    }
+
+    ExecutorScope::ExecutorScope(const Size threadCount) {
+        setExecutor(createThreadPool(threadCount));
+    }
+
+    ExecutorScope::~ExecutorScope() {
+        setExecutor(nullptr);
+    }
+
+    VL_EXECUTION_POLICY getExecutionPolicy(const Size threadCount) {
+        return threadCount > 1 ? VL_EXECUTION_PARALLEL : VL_EXECUTION_SEQUENTIAL;
+    }
+
+    bool checkSimdMode(benchmark::State& state, const VL_SIMD_MODE mode) {
+        if (!isSimdModeSupported(mode)) {
+            state.SkipWithError("SIMD mode is not supported on this machine");
+            return false;
+        }
+        return true;
+    }
+
+    namespace {
+
+        /**
+         * @brief Best of a few copies of bytes / 2 bytes (the other half is written), measured once per size.
+         */
+        double getMemcpyBytesPerSecond(const Size bytes) {
+            static std::map<Size, double> cache;
+            if (const auto it = cache.find(bytes); it != cache.end()) {
+                return it->second;
+            }
+            const Size copyBytes = std::max<Size>(bytes / 2, 1);
+            std::vector<char> source(copyBytes, 1);
+            std::vector<char> target(copyBytes, 0);
+            // Repeat small copies so the timer resolution does not matter
+            const Size repetitions = std::max<Size>(1, (64 << 20) / copyBytes);
+            double bestSeconds = 0.0;
+            for (int run = 0; run < 5; ++run) {
+                const auto start = std::chrono::steady_clock::now();
+                for (Size i = 0; i < repetitions; ++i) {
+                    std::memcpy(target.data(), source.data(), copyBytes);
+                    benchmark::ClobberMemory();
+                }
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                bestSeconds = run == 0 ? seconds : std::min(bestSeconds, seconds);
+            }
+            const double bytesPerSecond = static_cast<double>(2 * copyBytes * repetitions) / bestSeconds;
+            cache.emplace(bytes, bytesPerSecond);
+            return bytesPerSecond;
+        }
+
+    }
+
+    void reportThroughput(benchmark::State& state, const Size bytesPerIteration) {
+        const auto totalBytes = static_cast<double>(bytesPerIteration) * static_cast<double>(state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(totalBytes));
+        // kIsRate divides by the time and appends "/s" itself, so the counter is printed as GB=<value>/s
+        state.counters["GB"] = benchmark::Counter(totalBytes / 1e9, benchmark::Counter::kIsRate);
+        state.counters["memcpy_GB/s"] = getMemcpyBytesPerSecond(bytesPerIteration) / 1e9;
+    }
+
+}
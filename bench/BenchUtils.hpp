@@ -0,0 +1,90 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <VelyraImage/VelyraImage.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Velyra::Bench {
+
+    using namespace Velyra::Image;
+
+    struct ImageSize {
+        Size width;
+        Size height;
+        const char* name;
+    };
+
+    inline constexpr std::array<ImageSize, 6> IMAGE_SIZES = {{
+        {64, 64, "64x64"},
+        {256, 256, "256x256"},
+        {1024, 1024, "1024x1024"},
+        {1920, 1080, "1080p"},
+        {3840, 2160, "4K"},
+        {7680, 4320, "8K"},
+    }};
+
+    inline constexpr std::array<VL_SIMD_MODE, 7> SIMD_MODES = {
+        VL_SIMD_BEST, VL_SIMD_SCALAR, VL_SIMD_SSE2, VL_SIMD_SSSE3, VL_SIMD_SSE41, VL_SIMD_AVX2, VL_SIMD_AVX512
+    };
+
+    inline constexpr std::array<VL_CHANNEL_FORMAT, 6> CHANNEL_FORMATS = {
+        VL_CHANNEL_R, VL_CHANNEL_RG, VL_CHANNEL_RGB, VL_CHANNEL_RGBA, VL_CHANNEL_BGR, VL_CHANNEL_BGRA
+    };
+
+    inline constexpr std::array<VL_TYPE, 4> DATA_TYPES = {VL_UINT8, VL_UINT16, VL_FLOAT16, VL_FLOAT32};
+
+    const char* getSimdModeName(VL_SIMD_MODE mode);
+
+    const char* getFormatName(VL_CHANNEL_FORMAT format);
+
+    const char* getTypeName(VL_TYPE type);
+
+    /**
+     * @brief Thread counts to sweep: 1 (sequential execution), the powers of two in between and all hardware threads.
+     */
+    std::vector<Size> getThreadCounts();
+
+    /**
+     * @brief Creates an image filled with a deterministic pattern (a gradient with some noise), so codecs neither
+     *        compress it to nothing nor see pure noise.
+     */
+    UP<IImage> createSyntheticImage(VL_TYPE type, Size width, Size height, VL_CHANNEL_FORMAT format);
+
+    /**
+     * @brief Runs the parallel conversions on a thread pool with threadCount threads while alive, restores the
+     *        default executor afterwards.
+     */
+    class ExecutorScope {
+    public:
+        explicit ExecutorScope(Size threadCount);
+
+        ~ExecutorScope();
+
+        ExecutorScope(const ExecutorScope&) = delete;
+
+        ExecutorScope& operator=(const ExecutorScope&) = delete;
+    };
+
+    /**
+     * @return VL_EXECUTION_SEQUENTIAL for a single thread, VL_EXECUTION_PARALLEL otherwise
+     */
+    VL_EXECUTION_POLICY getExecutionPolicy(Size threadCount);
+
+    /**
+     * @brief Skips the benchmark if the CPU does not support mode.
+     * @return True if the benchmark can run
+     */
+    bool checkSimdMode(benchmark::State& state, VL_SIMD_MODE mode);
+
+    /**
+     * @brief Reports the throughput of the benchmark in GB/s (10^9 bytes) as the rate counter "GB", next to the
+     *        throughput of a memcpy of the same number of bytes on this machine ("memcpy_GB/s").
+     * @param bytesPerIteration Bytes read plus bytes written by one iteration
+     */
+    void reportThroughput(benchmark::State& state, Size bytesPerIteration);
+
+}
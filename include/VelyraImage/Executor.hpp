@@ -0,0 +1,46 @@
+#pragma once
+
+#include <VelyraImage/ImageDefs.hpp>
+#include <functional>
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Runs the blocks of parallel conversions. Implement this to run them on an existing job system.
+     */
+    class VL_API IExecutor {
+    public:
+        virtual ~IExecutor() = default;
+
+        /**
+         * @return Number of tasks that can run at the same time, including the calling thread
+         */
+        virtual Size getConcurrency() const = 0;
+
+        /**
+         * @brief Runs task(i) for every i in [0, taskCount) and returns once all of them have finished.
+         *        Tasks can run in any order and on any thread, including the calling thread. The call can be nested
+         *        inside a task. If tasks throw, the first exception is rethrown after all tasks have finished.
+         */
+        virtual void parallelFor(Size taskCount, const std::function<void(Size)>& task) = 0;
+    };
+
+    /**
+     * @brief Creates a work-stealing thread pool.
+     * @param threadCount Number of threads that run tasks, including the thread calling parallelFor.
+     *                    0 uses the number of hardware threads.
+     */
+    SP<IExecutor> VL_API createThreadPool(Size threadCount = 0);
+
+    /**
+     * @brief Sets the executor used by all parallel conversions.
+     * @param executor The executor, nullptr restores the default thread pool (one thread per hardware thread)
+     */
+    void VL_API setExecutor(SP<IExecutor> executor);
+
+    /**
+     * @return The executor used by parallel conversions, the default thread pool is created on first use
+     */
+    SP<IExecutor> VL_API getExecutor();
+
+}
@@ -6,6 +6,9 @@
 
 namespace Velyra::Image {
 
+    template<typename T>
+    class PixelBuffer;
+
     class VL_API IImage {
     public:
         virtual ~IImage() = default;
@@ -35,6 +38,14 @@ namespace Velyra::Image {
          */
         virtual UP<IImage> convertToFormat(const FormatConversionDesc& desc) const = 0;
 
+        /**
+         * @brief Converts this image to a different channel format. If both formats have the same channels (for example
+         *        RGBA and BGRA) the channels are reordered in place, otherwise the pixels are converted into a new buffer
+         *        that replaces the current one.
+         * @param desc Description of the format conversion, see convertToFormat
+         */
+        virtual void convertToFormatInPlace(const FormatConversionDesc& desc) = 0;
+
         /**
          * @brief Converts the image to a different data type. For example, from UI8 to F32 or from UI16 to UI8.
          * @param desc
@@ -42,6 +53,21 @@ namespace Velyra::Image {
          */
         virtual UP<IImage> translateDataType(const TranslationDesc& desc) const = 0;
 
+        /**
+         * @brief Converts the channel format and the data type and optionally flips the image in a single pass.
+         *        Gives the same result as convertToFormat followed by translateDataType, but only allocates the
+         *        returned image and reads every pixel once.
+         * @param desc Description of the transform, unset fields keep the format or type of this image
+         * @return The transformed image, or nullptr if the target type is not supported
+         */
+        virtual UP<IImage> transform(const TransformDesc& desc) const = 0;
+
+        /**
+         * @brief Reverses the order of the rows in place, without allocating a second buffer.
+         * @param desc SIMD mode and execution policy of the row swaps
+         */
+        void flipVertical(const FlipDesc& desc = {});
+
         Size getWidth() const { return m_Width; }
 
         Size getHeight() const { return m_Height; }
@@ -73,16 +99,21 @@ namespace Velyra::Image {
 
         IImage(Size width, Size height, VL_TYPE type, VL_CHANNEL_FORMAT format, const char* loggerName);
 
+        /**
+         * @brief Stores decoded pixels in the image, converting them to the requested format if necessary.
+         *        Takes ownership of loadedData (allocated by stb_image). If no conversion is needed the buffer is adopted
+         *        as is, otherwise it is converted into destinationData and released.
+         */
         template<typename T>
-        void setData(const ImageLoadDesc& desc, const T* loadedData, I32 loadedWidth, I32 loadedHeight, I32 loadedChannels,
-            std::vector<T>& destinationData);
+        void setData(const ImageLoadDesc& desc, T* loadedData, I32 loadedWidth, I32 loadedHeight, I32 loadedChannels,
+            PixelBuffer<T>& destinationData);
 
     protected:
         Size m_Width = 0;
         Size m_Height = 0;
         const VL_TYPE m_DataType = VL_TYPE_NONE;
         VL_CHANNEL_FORMAT m_Format = VL_CHANNEL_FORMAT_MAX_VALUE;
-        Utils::LogPtr m_Logger;
+        spdlog::logger* m_Logger = nullptr; // Cached handle, owned by the logger registry
 
     };
 
@@ -13,6 +13,11 @@ VL_ENUM(VL_IMAGE_TYPE, int,
     VL_IMAGE_HDR       = 0x04
 );
 
+VL_ENUM(VL_IMAGE_LOAD_MODE, int,
+    VL_LOAD_STREAM      = 0x00, // Read the file through stdio
+    VL_LOAD_MEMORY_MAP  = 0x01  // Map the file into memory and decode from the mapping
+);
+
 VL_ENUM(VL_CHANNEL_FORMAT, U8,
     VL_CHANNEL_R        = 0x01,
     VL_CHANNEL_RG       = 0x02,
@@ -30,14 +35,51 @@ VL_ENUM(VL_FORMAT_CONVERSION_FILL, int,
 VL_ENUM(VL_SIMD_MODE, int,
     VL_SIMD_BEST    = 0x00,
     VL_SIMD_SCALAR  = 0x01,
-    VL_SIMD_AVX2    = 0x02
-    // Extend later with SSE2
+    VL_SIMD_AVX2    = 0x02,
+    VL_SIMD_SSE2    = 0x03,
+    VL_SIMD_SSSE3   = 0x04,
+    VL_SIMD_SSE41   = 0x05,
+    VL_SIMD_AVX512  = 0x06
+);
+
+VL_ENUM(VL_JPG_SUBSAMPLING, int,
+    VL_JPG_SUBSAMPLING_444  = 0x00, // Chroma at full resolution
+    VL_JPG_SUBSAMPLING_422  = 0x01, // Chroma at half the width
+    VL_JPG_SUBSAMPLING_420  = 0x02  // Chroma at half the width and height, the smallest files
+);
+
+VL_ENUM(VL_EXECUTION_POLICY, int,
+    VL_EXECUTION_SEQUENTIAL = 0x00, // Run on the calling thread
+    VL_EXECUTION_PARALLEL   = 0x01  // Split large images into blocks that run on the executor, small images still run inline
 );
 
 namespace Velyra::Image {
 
     namespace fs = std::filesystem;
 
+    /**
+     * @brief IEEE 754 half precision float, stored as its bit pattern (the layout of RGBA16F textures).
+     *        It is only a storage type, use f16ToFloat and floatToF16 to do arithmetic.
+     */
+    struct F16 {
+        U16 bits;
+
+        friend constexpr bool operator==(F16 lhs, F16 rhs) = default;
+    };
+
+    static_assert(sizeof(F16) == sizeof(U16));
+
+    /**
+     * @brief Converts a half to a float, the conversion is exact.
+     */
+    float VL_API f16ToFloat(F16 value);
+
+    /**
+     * @brief Converts a float to the nearest half (ties to even), out of range values become infinity.
+     *        Gives the same results as the F16C instruction vcvtps2ph.
+     */
+    F16 VL_API floatToF16(float value);
+
     /**
      * @brief Gets the number of channels from a VL_CHANNEL_FORMAT.
      * @param format The channel format.
@@ -53,17 +95,30 @@ namespace Velyra::Image {
      */
     VL_CHANNEL_FORMAT VL_API getChannelFormatFromCount(U32 channelCount);
 
+    /**
+     * @brief Checks whether the CPU of this machine supports a SIMD mode.
+     * @param mode The SIMD mode, VL_SIMD_BEST and VL_SIMD_SCALAR are always supported
+     * @return True if conversions requested with this mode run with this mode, instead of falling back to a narrower one
+     */
+    bool VL_API isSimdModeSupported(VL_SIMD_MODE mode);
+
     struct VL_API ImageLoadDesc {
         fs::path fileName;
         bool flipOnLoad         = true;
         VL_CHANNEL_FORMAT requestedFormat = VL_CHANNEL_FORMAT_MAX_VALUE; // If UNKNOWN, load all channels available in the image
         VL_FORMAT_CONVERSION_FILL fillMode = VL_FILL_MAX; // If the requestedFormat has more channels than the image, fill the new channels with this value
+        VL_IMAGE_LOAD_MODE loadMode = VL_LOAD_STREAM; // How the file is read, ignored when loading from memory
     };
 
     struct VL_API ImageWriteDesc {
         fs::path fileName;
         bool flipOnWrite        = false;
         VL_IMAGE_TYPE fileType  = VL_IMAGE_PNG;
+        U32 compressionLevel    = 6; // PNG only: 0 (stored, fastest) to 9 (smallest file), 6 is about as fast as stb_image_write
+        VL_EXECUTION_POLICY executionPolicy = VL_EXECUTION_PARALLEL; // PNG and JPG: encode blocks of rows on the executor
+        U32 jpgQuality          = 100; // JPG only: 1 (smallest file) to 100 (best quality)
+        VL_JPG_SUBSAMPLING jpgSubsampling = VL_JPG_SUBSAMPLING_444; // JPG only: resolution of the chroma planes. R and RG images get zero chroma and load back as RGB
+        VL_SIMD_MODE simdMode   = VL_SIMD_BEST; // JPG only: SIMD mode of the colour conversion and DCT
     };
 
     struct VL_API ImageU8Desc {
@@ -90,21 +145,46 @@ namespace Velyra::Image {
         float defaultChannelValue   = 1.0f; // In case an empty image is requested, fill buffer with this value
     };
 
+    struct VL_API ImageF16Desc {
+        const F16* data             = nullptr;
+        Size width                  = 0;
+        Size height                 = 0;
+        VL_CHANNEL_FORMAT format    = VL_CHANNEL_RGBA;
+        F16 defaultChannelValue     = {0x3C00}; // 1.0, in case an empty image is requested, fill buffer with this value
+    };
+
     struct VL_API FormatConversionDesc {
         VL_CHANNEL_FORMAT targetFormat = VL_CHANNEL_FORMAT_MAX_VALUE;
         /*
          * In case of up-conversion, fill new channels with max or min value
          * For UI8, these values are 0 and 255
          * For UI16, these values are 0 and 65535
-         * For F32, these values are 0.0f and 1.0f
+         * For F16 and F32, these values are 0.0 and 1.0
          */
         VL_FORMAT_CONVERSION_FILL fillMode = VL_FILL_MAX;
+        bool flipVertical = false; // Reverse the order of the rows while converting, without an extra pass
         VL_SIMD_MODE simdMode = VL_SIMD_BEST; // SIMD mode to use for conversion
+        VL_EXECUTION_POLICY executionPolicy = VL_EXECUTION_PARALLEL;
     };
 
     struct VL_API TranslationDesc {
         VL_TYPE targetType = VL_TYPE_MAX_VALUE;
         VL_SIMD_MODE simdMode = VL_SIMD_BEST; // SIMD mode to use for translation
+        VL_EXECUTION_POLICY executionPolicy = VL_EXECUTION_PARALLEL;
+    };
+
+    struct VL_API FlipDesc {
+        VL_SIMD_MODE simdMode = VL_SIMD_BEST; // SIMD mode to use for swapping the rows
+        VL_EXECUTION_POLICY executionPolicy = VL_EXECUTION_PARALLEL;
+    };
+
+    struct VL_API TransformDesc {
+        VL_CHANNEL_FORMAT targetFormat = VL_CHANNEL_FORMAT_MAX_VALUE; // If VL_CHANNEL_FORMAT_MAX_VALUE, keep the format of the image
+        VL_FORMAT_CONVERSION_FILL fillMode = VL_FILL_MAX; // See FormatConversionDesc
+        VL_TYPE targetType = VL_TYPE_MAX_VALUE; // If VL_TYPE_MAX_VALUE, keep the data type of the image
+        bool flipVertical = false; // Reverse the order of the rows
+        VL_SIMD_MODE simdMode = VL_SIMD_BEST;
+        VL_EXECUTION_POLICY executionPolicy = VL_EXECUTION_PARALLEL;
     };
 
 }
\ No newline at end of file
@@ -1,15 +1,52 @@
 #pragma once
 
 #include <VelyraImage/IImage.hpp>
+#include <span>
+#include <vector>
 
 namespace Velyra::Image {
 
     class VL_API ImageFactory {
     public:
+        /**
+         * @brief Loads an image file. HDR files are loaded as ImageF32, 16-bit files (PNG, PNM) as ImageU16 and all
+         *        other files as ImageU8.
+         */
         static UP<IImage> createImage(const ImageLoadDesc& desc);
 
+        /**
+         * @brief Decodes an image from an encoded file in memory (for example a file inside a mapped archive).
+         * @param data Encoded image data, it is not copied and only needs to stay alive for the duration of the call
+         * @param desc Load description, fileName is only used for diagnostics and loadMode is ignored
+         * @return Decoded image
+         */
+        static UP<IImage> createImageFromMemory(std::span<const std::byte> data, const ImageLoadDesc& desc);
+
+        /**
+         * @brief Loads a batch of images concurrently on a pool of worker threads.
+         * @param descs Load descriptions of the images to load
+         * @param threadCount Number of worker threads to use, 0 uses the number of hardware threads
+         * @return Loaded images, in the same order as descs. If any image fails to load, the first error is rethrown
+         *         after all workers have finished.
+         */
+        static std::vector<UP<IImage>> createImages(std::span<const ImageLoadDesc> descs, Size threadCount = 0);
+
         static UP<IImage> createImageU8(const ImageU8Desc& desc);
 
+        static UP<IImage> createImageU16(const ImageUI16Desc& desc);
+
+        /**
+         * @brief Creates a half float image, for example for HDR textures that are uploaded as RGBA16F.
+         *        Files can be loaded as ImageF16 with createImageF16(const ImageLoadDesc&).
+         */
+        static UP<IImage> createImageF16(const ImageF16Desc& desc);
+
+        /**
+         * @brief Loads an image file as ImageF16, whatever the type of the file is. The decoded floats are converted
+         *        to halves in the same pass as the format conversion and the flip.
+         */
+        static UP<IImage> createImageF16(const ImageLoadDesc& desc);
+
         static UP<IImage> createImageF32(const ImageF32Desc& desc);
 
         /**
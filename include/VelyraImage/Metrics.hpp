@@ -0,0 +1,56 @@
+#pragma once
+
+#include <VelyraImage/ImageDefs.hpp>
+#include <array>
+
+VL_ENUM(VL_IMAGE_OPERATION, int,
+    VL_OPERATION_LOAD                = 0x00, // Decoding a file or memory buffer
+    VL_OPERATION_WRITE               = 0x01, // Encoding and writing a file
+    VL_OPERATION_RESIZE              = 0x02,
+    VL_OPERATION_CONVERT_FORMAT      = 0x03, // convertToFormat and convertToFormatInPlace
+    VL_OPERATION_TRANSLATE_DATA_TYPE = 0x04,
+    VL_OPERATION_TRANSFORM           = 0x05, // transform and every conversion that flips the rows while converting
+    VL_OPERATION_FLIP                = 0x06
+);
+
+namespace Velyra::Image {
+
+    struct VL_API OperationMetrics {
+        U64 count = 0;
+        U64 bytes = 0; // Bytes read plus bytes written
+        U64 nanoseconds = 0; // Wall clock time, summed over all calls
+    };
+
+    /**
+     * @brief Snapshot of the counters of the library since the start of the process (or the last resetMetrics).
+     *        Operations are broken down by the SIMD mode that actually ran (VL_SIMD_BEST is resolved). Operations
+     *        without SIMD kernels (load and write) are counted under VL_SIMD_BEST. An operation that runs another one
+     *        (for example a load that converts to the requested format) is counted for both.
+     */
+    struct VL_API ImageMetrics {
+        U64 imagesCreated = 0;
+        std::array<std::array<OperationMetrics, VL_SIMD_MODE_MAX_VALUE>, VL_IMAGE_OPERATION_MAX_VALUE> operations{};
+
+        const OperationMetrics& get(const VL_IMAGE_OPERATION operation, const VL_SIMD_MODE mode) const {
+            return operations[operation][mode];
+        }
+
+        /**
+         * @return The metrics of an operation summed over all SIMD modes
+         */
+        OperationMetrics getTotal(VL_IMAGE_OPERATION operation) const;
+    };
+
+    /**
+     * @brief Reads all counters. The counters are relaxed atomics that are updated once per operation (not per pixel),
+     *        so reading them is cheap and never blocks the threads that update them. A snapshot taken while
+     *        operations are running can be slightly inconsistent between counters.
+     */
+    ImageMetrics VL_API getMetrics();
+
+    /**
+     * @brief Sets all counters to zero.
+     */
+    void VL_API resetMetrics();
+
+}
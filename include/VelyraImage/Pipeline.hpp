@@ -0,0 +1,139 @@
+#pragma once
+
+#include <VelyraImage/IImage.hpp>
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Dimensions and pixel layout of the rows produced by a row source.
+     */
+    struct VL_API RowLayout {
+        Size width = 0;
+        Size height = 0;
+        VL_CHANNEL_FORMAT format = VL_CHANNEL_FORMAT_MAX_VALUE;
+        VL_TYPE dataType = VL_TYPE_NONE;
+
+        /**
+         * @return Size of one tightly packed row in bytes
+         */
+        Size getRowSize() const;
+    };
+
+    /**
+     * @brief Consecutive rows of an image, tightly packed.
+     */
+    struct VL_API RowStrip {
+        const void* data = nullptr;
+        Size firstRow = 0; // Index of the first row in the image
+        Size rowCount = 0;
+    };
+
+    /**
+     * @brief Produces the rows of an image from top to bottom, a strip at a time.
+     */
+    class VL_API IRowSource {
+    public:
+        virtual ~IRowSource() = default;
+
+        virtual const RowLayout& getLayout() const = 0;
+
+        /**
+         * @brief Produces the next rows.
+         * @param maxRowCount Maximum number of rows to produce, must not be 0
+         * @return The next rows, rowCount is 0 once all rows have been read. The data stays valid until the next call.
+         */
+        virtual RowStrip readRows(Size maxRowCount) = 0;
+    };
+
+    /**
+     * @brief Consumes the rows of an image from top to bottom, a strip at a time.
+     */
+    class VL_API IRowSink {
+    public:
+        virtual ~IRowSink() = default;
+
+        /**
+         * @brief Called once before the first strip, throws if the sink cannot take rows of this layout.
+         */
+        virtual void begin(const RowLayout& layout) = 0;
+
+        virtual void writeRows(const RowStrip& strip) = 0;
+
+        /**
+         * @brief Called once after the last strip.
+         */
+        virtual void end() = 0;
+    };
+
+    /**
+     * @brief Builds streaming pipelines out of row sources, row transforms and row sinks. Every stage only holds the
+     *        rows of the current strip (the resize also holds the input rows its filter needs), so the memory a pipeline
+     *        uses is bounded by the strip size instead of the image size.
+     */
+    class VL_API RowPipeline {
+    public:
+        static constexpr Size DEFAULT_STRIP_ROW_COUNT = 64;
+
+        /**
+         * @brief Reads the rows of an image, which has to outlive the source. The rows are not copied unless flipped.
+         * @param flipVertical Produce the rows from bottom to top
+         */
+        static UP<IRowSource> createImageSource(const IImage& image, bool flipVertical = false);
+
+        /**
+         * @brief Reads the rows of an image file. stb_image only decodes whole images, so the source holds the decoded
+         *        image (in its native type, see ImageFactory::createImage) and only the later stages are bounded.
+         */
+        static UP<IRowSource> createFileSource(const ImageLoadDesc& desc);
+
+        /**
+         * @brief Converts the channel format of every strip with the kernels of convertToFormat.
+         *        desc.flipVertical is not supported (use a flipped source instead), it throws.
+         */
+        static UP<IRowSource> convertToFormat(UP<IRowSource> source, const FormatConversionDesc& desc);
+
+        /**
+         * @brief Converts the data type of every strip with the kernels of translateDataType.
+         *        Throws if there is no translation between both types.
+         */
+        static UP<IRowSource> translateDataType(UP<IRowSource> source, const TranslationDesc& desc);
+
+        /**
+         * @brief Converts the format and the data type of every strip in a single pass, like IImage::transform.
+         *        desc.flipVertical is not supported (use a flipped source instead), it throws.
+         */
+        static UP<IRowSource> transform(UP<IRowSource> source, const TransformDesc& desc);
+
+        /**
+         * @brief Resizes with the filters of IImage::resize. The output rows of every strip are computed from a window
+         *        of input rows that slides down the image, the result is identical to resizing the whole image.
+         *        Strips run on the calling thread.
+         */
+        static UP<IRowSource> resize(UP<IRowSource> source, Size width, Size height);
+
+        /**
+         * @brief Writes rows to an image file, the channels are stored in the order of the rows like IImage::write.
+         *        PNG (UINT8 and UINT16) is deflated and written as the strips arrive, BMP (UINT8) and HDR (FLOAT32 and
+         *        FLOAT16) are written row by row as well. JPG (UINT8) is encoded one MCU row (8 or 16 rows) at a time,
+         *        only the rows of an incomplete MCU row are kept. desc.flipOnWrite is only supported for BMP.
+         *        begin throws for unsupported combinations.
+         */
+        static UP<IRowSink> createFileSink(const ImageWriteDesc& desc);
+
+        /**
+         * @brief Pulls all rows from the source into the sink.
+         */
+        static void run(IRowSource& source, IRowSink& sink, Size stripRowCount = DEFAULT_STRIP_ROW_COUNT);
+
+        /**
+         * @brief Pulls all rows from the source into an image file, see createFileSink.
+         */
+        static void write(IRowSource& source, const ImageWriteDesc& desc, Size stripRowCount = DEFAULT_STRIP_ROW_COUNT);
+
+        /**
+         * @brief Pulls all rows from the source into a new image of the type of the rows.
+         */
+        static UP<IImage> toImage(IRowSource& source, Size stripRowCount = DEFAULT_STRIP_ROW_COUNT);
+    };
+
+}
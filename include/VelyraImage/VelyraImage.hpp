@@ -2,4 +2,7 @@
 
 #include <VelyraImage/IImage.hpp>
 #include <VelyraImage/ImageFactory.hpp>
-#include <VelyraImage/ImageDefs.hpp>
\ No newline at end of file
+#include <VelyraImage/ImageDefs.hpp>
+#include <VelyraImage/Executor.hpp>
+#include <VelyraImage/Metrics.hpp>
+#include <VelyraImage/Pipeline.hpp>
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <VelyraImage/ImageDefs.hpp>
-#include <vector>
+#include <span>
 #include "../ImageUtils.hpp"
+#include "../SimdDispatch.hpp"
+#include "../Executor/ParallelFor.hpp"
+#include "../Metrics.hpp"
 
 namespace Velyra::Image::TranslateDataType {
 
@@ -10,44 +13,162 @@ namespace Velyra::Image::TranslateDataType {
      * @brief Scalar conversion from UI8 to F32
      * Converts U8 values [0, 255] to float values [0.0, 1.0]
      */
-    void translateDataType_Scalar(const std::vector<U8>& source, std::vector<float>& destination);
+    void translateDataType_Scalar(std::span<const U8> source, std::span<float> destination);
 
     /**
      * @brief Scalar conversion from F32 to UI8
      * Converts float values [0.0, 1.0] to U8 values [0, 255]
      * Values outside [0.0, 1.0] are clamped
      */
-    void translateDataType_Scalar(const std::vector<float>& source, std::vector<U8>& destination);
+    void translateDataType_Scalar(std::span<const float> source, std::span<U8> destination);
 
     /**
      * @brief AVX2-optimized conversion from UI8 to F32
      * Converts U8 values [0, 255] to float values [0.0, 1.0]
      */
-    void translateDataType_AVX2(const std::vector<U8>& source, std::vector<float>& destination);
+    void translateDataType_AVX2(std::span<const U8> source, std::span<float> destination);
 
     /**
      * @brief AVX2-optimized conversion from F32 to UI8
      * Converts float values [0.0, 1.0] to U8 values [0, 255]
      * Values outside [0.0, 1.0] are clamped
      */
-    void translateDataType_AVX2(const std::vector<float>& source, std::vector<U8>& destination);
+    void translateDataType_AVX2(std::span<const float> source, std::span<U8> destination);
+
+    /**
+     * @brief SSE2 conversion from UI8 to F32, also used for VL_SIMD_SSSE3
+     * Converts U8 values [0, 255] to float values [0.0, 1.0]
+     */
+    void translateDataType_SSE2(std::span<const U8> source, std::span<float> destination);
+
+    /**
+     * @brief SSE2 conversion from F32 to UI8, also used for VL_SIMD_SSSE3
+     * Converts float values [0.0, 1.0] to U8 values [0, 255]
+     * Values outside [0.0, 1.0] are clamped
+     */
+    void translateDataType_SSE2(std::span<const float> source, std::span<U8> destination);
+
+    /**
+     * @brief SSE4.1 conversion from UI8 to F32
+     * Converts U8 values [0, 255] to float values [0.0, 1.0]
+     */
+    void translateDataType_SSE41(std::span<const U8> source, std::span<float> destination);
+
+    /**
+     * @brief SSE4.1 conversion from F32 to UI8
+     * Converts float values [0.0, 1.0] to U8 values [0, 255]
+     * Values outside [0.0, 1.0] are clamped
+     */
+    void translateDataType_SSE41(std::span<const float> source, std::span<U8> destination);
+
+    /**
+     * @brief AVX-512 conversion from UI8 to F32
+     * Converts U8 values [0, 255] to float values [0.0, 1.0]
+     */
+    void translateDataType_AVX512(std::span<const U8> source, std::span<float> destination);
+
+    /**
+     * @brief AVX-512 conversion from F32 to UI8
+     * Converts float values [0.0, 1.0] to U8 values [0, 255]
+     * Values outside [0.0, 1.0] are clamped
+     */
+    void translateDataType_AVX512(std::span<const float> source, std::span<U8> destination);
+
+    /*
+     * U16 conversions, U8 values are scaled by 257 so 255 maps to 65535 and back. Conversions to U8 are rounded.
+     * VL_SIMD_SSSE3 and VL_SIMD_SSE41 use the SSE2 kernels, apart from F32 to U16 which uses the unsigned pack of SSE4.1.
+     */
+
+    /**
+     * @brief Rounds v / 257 to the nearest integer without a division, exact for every U16 value
+     */
+    constexpr U8 roundU16ToU8(const U16 value) {
+        return static_cast<U8>((static_cast<U32>(value) * 255u + 32895u) >> 16);
+    }
+
+    void translateDataType_Scalar(std::span<const U8> source, std::span<U16> destination);
+
+    void translateDataType_Scalar(std::span<const U16> source, std::span<U8> destination);
+
+    void translateDataType_Scalar(std::span<const U16> source, std::span<float> destination);
+
+    void translateDataType_Scalar(std::span<const float> source, std::span<U16> destination);
+
+    void translateDataType_SSE2(std::span<const U8> source, std::span<U16> destination);
+
+    void translateDataType_SSE2(std::span<const U16> source, std::span<U8> destination);
+
+    void translateDataType_SSE2(std::span<const U16> source, std::span<float> destination);
+
+    /**
+     * @brief SSE2 has no unsigned 32 -> 16 bit pack, the values are biased into the signed range instead
+     */
+    void translateDataType_SSE2(std::span<const float> source, std::span<U16> destination);
+
+    void translateDataType_SSE41(std::span<const float> source, std::span<U16> destination);
+
+    void translateDataType_AVX2(std::span<const U8> source, std::span<U16> destination);
+
+    void translateDataType_AVX2(std::span<const U16> source, std::span<U8> destination);
+
+    void translateDataType_AVX2(std::span<const U16> source, std::span<float> destination);
+
+    void translateDataType_AVX2(std::span<const float> source, std::span<U16> destination);
+
+    void translateDataType_AVX512(std::span<const U8> source, std::span<U16> destination);
+
+    void translateDataType_AVX512(std::span<const U16> source, std::span<U8> destination);
+
+    void translateDataType_AVX512(std::span<const U16> source, std::span<float> destination);
+
+    void translateDataType_AVX512(std::span<const float> source, std::span<U16> destination);
+
+    /*
+     * F16 conversions, the values are converted to float and then handled like F32 values. Only the F16C and AVX-512
+     * kernels are vectorized, the SSE modes use the scalar kernels.
+     */
+
+    void translateDataType_Scalar(std::span<const float> source, std::span<F16> destination);
+
+    void translateDataType_Scalar(std::span<const F16> source, std::span<float> destination);
+
+    void translateDataType_Scalar(std::span<const U8> source, std::span<F16> destination);
+
+    void translateDataType_Scalar(std::span<const F16> source, std::span<U8> destination);
+
+    /**
+     * @brief AVX2 kernels that use the F16C instructions, only called if the CPU supports both
+     */
+    void translateDataType_F16C(std::span<const float> source, std::span<F16> destination);
+
+    void translateDataType_F16C(std::span<const F16> source, std::span<float> destination);
+
+    void translateDataType_F16C(std::span<const U8> source, std::span<F16> destination);
+
+    void translateDataType_F16C(std::span<const F16> source, std::span<U8> destination);
+
+    void translateDataType_AVX512(std::span<const float> source, std::span<F16> destination);
+
+    void translateDataType_AVX512(std::span<const F16> source, std::span<float> destination);
+
+    void translateDataType_AVX512(std::span<const U8> source, std::span<F16> destination);
+
+    void translateDataType_AVX512(std::span<const F16> source, std::span<U8> destination);
 
     template<typename SrcType, typename DstType>
-    void translateDataType(const std::vector<SrcType>& source, std::vector<DstType>& destination, const TranslationDesc& desc) {
+    void translateDataType(std::span<const SrcType> source, std::span<DstType> destination, const TranslationDesc& desc) {
         if constexpr (std::is_same_v<SrcType, DstType>) {
-            destination = source; // Just copy
-            return;
+            std::copy(source.begin(), source.end(), destination.begin()); // Just copy
         }
-        switch (findBestMode(desc.simdMode)) {
-            case VL_SIMD_AVX2: {
-                translateDataType_AVX2(source, destination);
-                return;
-            }
-            default: {
-                break;
-            }
+        else {
+            const SimdDispatchTable& table = getDispatchTable(desc.simdMode);
+            const auto kernel = table.getTranslateDataType<SrcType, DstType>();
+            const ScopedOperationMetrics metrics(VL_OPERATION_TRANSLATE_DATA_TYPE, table.mode,
+                source.size_bytes() + destination.size_bytes());
+            parallelForBlocks(desc.executionPolicy, source.size(), sizeof(SrcType) + sizeof(DstType), [&](const Size begin, const Size end) {
+                kernel(source.subspan(begin, end - begin), destination.subspan(begin, end - begin));
+            });
         }
-        translateDataType_Scalar(source, destination);
     }
 
 }
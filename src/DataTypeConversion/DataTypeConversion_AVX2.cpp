@@ -0,0 +1,185 @@
+#include "../Pch.hpp"
+
+#include "DataTypeConversion.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * AVX2 kernels, compiled with AVX2 enabled and only called if the CPU supports it.
+ */
+
+VL_SIMD_TARGET_BEGIN("avx2")
+
+namespace Velyra::Image::TranslateDataType {
+
+    void translateDataType_AVX2(const std::span<const U8> source, const std::span<float> destination) {
+        const Size count = source.size();
+        const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+        
+        Size i = 0;
+        // Process 8 elements at a time
+        for (; i + 8 <= count; i += 8) {
+            // Load 8 bytes from source
+            // We load into a 64-bit value, then use _mm_loadl_epi64 to get into XMM
+            __m128i bytes_128 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&source[i]));
+            
+            // Zero-extend U8 to 32-bit integers
+            __m256i ints = _mm256_cvtepu8_epi32(bytes_128);
+            
+            // Convert 32-bit integers to floats
+            __m256 floats = _mm256_cvtepi32_ps(ints);
+            
+            // Scale from [0, 255] to [0.0, 1.0]
+            floats = _mm256_mul_ps(floats, scale);
+            
+            // Store 8 floats to destination
+            _mm256_storeu_ps(&destination[i], floats);
+        }
+        
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_AVX2(const std::span<const float> source, const std::span<U8> destination) {
+        const Size count = source.size();
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(255.0f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        
+        Size i = 0;
+        // Process 8 elements at a time
+        for (; i + 8 <= count; i += 8) {
+            // Load 8 floats from source
+            __m256 floats = _mm256_loadu_ps(&source[i]);
+            
+            // Clamp to [0.0, 1.0]
+            floats = _mm256_max_ps(floats, zero);
+            floats = _mm256_min_ps(floats, one);
+            
+            // Scale to [0, 255] and add 0.5 for rounding
+            floats = _mm256_mul_ps(floats, scale);
+            floats = _mm256_add_ps(floats, half);
+            
+            // Convert to 32-bit integers, truncating like the scalar version
+            __m256i ints = _mm256_cvttps_epi32(floats);
+            
+            // Pack 32-bit integers down to 16-bit integers (saturated)
+            // This requires some shuffling since AVX2 operates on 128-bit lanes
+            // Extract low and high 128-bit lanes
+            __m128i low_128 = _mm256_castsi256_si128(ints);           // Lower 4 ints
+            __m128i high_128 = _mm256_extracti128_si256(ints, 1);    // Upper 4 ints
+            
+            // Pack 32-bit to 16-bit (8 int32 -> 8 int16)
+            __m128i packed_16 = _mm_packus_epi32(low_128, high_128);
+            
+            // Pack 16-bit to 8-bit (8 int16 -> 8 int8)
+            __m128i packed_8 = _mm_packus_epi16(packed_16, packed_16);
+            
+            // Store 8 bytes to destination
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(&destination[i]), packed_8);
+        }
+        
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_AVX2(const std::span<const U8> source, const std::span<U16> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 32 elements at a time
+        for (; i + 32 <= count; i += 32) {
+            const __m256i words_lo = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i])));
+            const __m256i words_hi = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i + 16])));
+
+            // v * 257 = (v << 8) | v
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&destination[i]), _mm256_or_si256(words_lo, _mm256_slli_epi16(words_lo, 8)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&destination[i + 16]), _mm256_or_si256(words_hi, _mm256_slli_epi16(words_hi, 8)));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    namespace {
+
+        // Rounds 8 32-bit integers in [0, 65535] to v / 257 like roundU16ToU8
+        __m256i roundU16ToU8_AVX2(const __m256i ints) {
+            const __m256i scaled = _mm256_sub_epi32(_mm256_slli_epi32(ints, 8), ints);
+            return _mm256_srli_epi32(_mm256_add_epi32(scaled, _mm256_set1_epi32(32895)), 16);
+        }
+
+    }
+
+    void translateDataType_AVX2(const std::span<const U16> source, const std::span<U8> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m128i words_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+            const __m128i words_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i + 8]));
+            const __m256i ints_lo = roundU16ToU8_AVX2(_mm256_cvtepu16_epi32(words_lo));
+            const __m256i ints_hi = roundU16ToU8_AVX2(_mm256_cvtepu16_epi32(words_hi));
+
+            // The packs work per 128-bit lane, restore the element order before narrowing to bytes
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(ints_lo, ints_hi), 0xD8);
+            const __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), bytes);
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_AVX2(const std::span<const U16> source, const std::span<float> destination) {
+        const Size count = source.size();
+        const __m256 scale = _mm256_set1_ps(1.0f / 65535.0f);
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m256i ints_lo = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i])));
+            const __m256i ints_hi = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i + 8])));
+            _mm256_storeu_ps(&destination[i], _mm256_mul_ps(_mm256_cvtepi32_ps(ints_lo), scale));
+            _mm256_storeu_ps(&destination[i + 8], _mm256_mul_ps(_mm256_cvtepi32_ps(ints_hi), scale));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    namespace {
+
+        // Clamps 8 floats to [0.0, 1.0], scales them to [0, 65535] and truncates them after adding 0.5 for rounding
+        __m256i floatsToU16Ints_AVX2(const float* source) {
+            __m256 floats = _mm256_loadu_ps(source);
+            floats = _mm256_max_ps(floats, _mm256_setzero_ps());
+            floats = _mm256_min_ps(floats, _mm256_set1_ps(1.0f));
+            floats = _mm256_add_ps(_mm256_mul_ps(floats, _mm256_set1_ps(65535.0f)), _mm256_set1_ps(0.5f));
+            return _mm256_cvttps_epi32(floats);
+        }
+
+    }
+
+    void translateDataType_AVX2(const std::span<const float> source, const std::span<U16> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m256i ints_lo = floatsToU16Ints_AVX2(&source[i]);
+            const __m256i ints_hi = floatsToU16Ints_AVX2(&source[i + 8]);
+
+            // The pack works per 128-bit lane, restore the element order afterwards
+            const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(ints_lo, ints_hi), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&destination[i]), words);
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+}
+
+VL_SIMD_TARGET_END
@@ -0,0 +1,173 @@
+#include "../Pch.hpp"
+
+#include "DataTypeConversion.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * AVX-512 kernels, compiled with AVX512-F/BW/VL enabled and only called if the CPU supports them. The conversions use
+ * the zero masking forms with the mask of the loop: the unmasked forms of GCC 12 merge into an undefined vector, which
+ * -Wmaybe-uninitialized reports at -O2 (GCC bug 105593).
+ */
+
+VL_SIMD_TARGET_BEGIN("avx512f,avx512bw,avx512vl")
+
+namespace Velyra::Image::TranslateDataType {
+
+    void translateDataType_AVX512(const std::span<const U8> source, const std::span<float> destination) {
+        const Size count = source.size();
+        const __m512 scale = _mm512_set1_ps(1.0f / 255.0f);
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+
+            // Zero-extend 16 bytes to 32-bit integers and convert them to floats
+            const __m128i bytes = _mm_maskz_loadu_epi8(mask, &source[i]);
+            const __m512 floats = _mm512_mul_ps(_mm512_maskz_cvtepi32_ps(mask, _mm512_maskz_cvtepu8_epi32(mask, bytes)), scale);
+            _mm512_mask_storeu_ps(&destination[i], mask, floats);
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const float> source, const std::span<U8> destination) {
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512 one = _mm512_set1_ps(1.0f);
+        const __m512 scale = _mm512_set1_ps(255.0f);
+        const __m512 half = _mm512_set1_ps(0.5f);
+        const Size count = source.size();
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+
+            // Clamp to [0.0, 1.0], scale to [0, 255] and add 0.5 for rounding
+            __m512 floats = _mm512_maskz_loadu_ps(mask, &source[i]);
+            floats = _mm512_maskz_min_ps(mask, _mm512_maskz_max_ps(mask, floats, zero), one);
+            floats = _mm512_add_ps(_mm512_mul_ps(floats, scale), half);
+
+            // Truncate like the scalar version and narrow the 32-bit integers to bytes with unsigned saturation
+            const __m512i ints = _mm512_maskz_cvttps_epi32(mask, floats);
+            _mm512_mask_cvtusepi32_storeu_epi8(&destination[i], mask, ints);
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const U8> source, const std::span<U16> destination) {
+        const Size count = source.size();
+
+        // Process 32 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 32) {
+            const auto mask = static_cast<__mmask32>(count - i >= 32 ? 0xFFFFFFFFu : (1u << (count - i)) - 1);
+
+            // v * 257 = (v << 8) | v
+            const __m512i words = _mm512_maskz_cvtepu8_epi16(mask, _mm256_maskz_loadu_epi8(mask, &source[i]));
+            _mm512_mask_storeu_epi16(&destination[i], mask, _mm512_or_si512(words, _mm512_maskz_slli_epi16(mask, words, 8)));
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const U16> source, const std::span<U8> destination) {
+        const Size count = source.size();
+        const __m512i rounding = _mm512_set1_epi32(32895);
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+
+            // Round v / 257 like roundU16ToU8, (v << 8) - v is v * 255
+            const __m512i ints = _mm512_maskz_cvtepu16_epi32(mask, _mm256_maskz_loadu_epi16(mask, &source[i]));
+            const __m512i scaled = _mm512_sub_epi32(_mm512_maskz_slli_epi32(mask, ints, 8), ints);
+            const __m512i rounded = _mm512_maskz_srli_epi32(mask, _mm512_add_epi32(scaled, rounding), 16);
+            _mm512_mask_cvtusepi32_storeu_epi8(&destination[i], mask, rounded);
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const U16> source, const std::span<float> destination) {
+        const Size count = source.size();
+        const __m512 scale = _mm512_set1_ps(1.0f / 65535.0f);
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+            const __m512i ints = _mm512_maskz_cvtepu16_epi32(mask, _mm256_maskz_loadu_epi16(mask, &source[i]));
+            _mm512_mask_storeu_ps(&destination[i], mask, _mm512_mul_ps(_mm512_maskz_cvtepi32_ps(mask, ints), scale));
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const float> source, const std::span<U16> destination) {
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512 one = _mm512_set1_ps(1.0f);
+        const __m512 scale = _mm512_set1_ps(65535.0f);
+        const __m512 half = _mm512_set1_ps(0.5f);
+        const Size count = source.size();
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+
+            // Clamp to [0.0, 1.0], scale to [0, 65535] and add 0.5 for rounding
+            __m512 floats = _mm512_maskz_loadu_ps(mask, &source[i]);
+            floats = _mm512_maskz_min_ps(mask, _mm512_maskz_max_ps(mask, floats, zero), one);
+            floats = _mm512_add_ps(_mm512_mul_ps(floats, scale), half);
+            _mm512_mask_cvtusepi32_storeu_epi16(&destination[i], mask, _mm512_maskz_cvttps_epi32(mask, floats));
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const float> source, const std::span<F16> destination) {
+        const Size count = source.size();
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+            const __m512 floats = _mm512_maskz_loadu_ps(mask, &source[i]);
+            const __m256i halves = _mm512_maskz_cvtps_ph(mask, floats, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm256_mask_storeu_epi16(&destination[i], mask, halves);
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const F16> source, const std::span<float> destination) {
+        const Size count = source.size();
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+            const __m256i halves = _mm256_maskz_loadu_epi16(mask, &source[i]);
+            _mm512_mask_storeu_ps(&destination[i], mask, _mm512_maskz_cvtph_ps(mask, halves));
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const U8> source, const std::span<F16> destination) {
+        const Size count = source.size();
+        const __m512 scale = _mm512_set1_ps(1.0f / 255.0f);
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+
+            // Same scaling as the U8 to F32 conversion, then rounded to the nearest half
+            const __m128i bytes = _mm_maskz_loadu_epi8(mask, &source[i]);
+            const __m512 floats = _mm512_mul_ps(_mm512_maskz_cvtepi32_ps(mask, _mm512_maskz_cvtepu8_epi32(mask, bytes)), scale);
+            const __m256i halves = _mm512_maskz_cvtps_ph(mask, floats, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm256_mask_storeu_epi16(&destination[i], mask, halves);
+        }
+    }
+
+    void translateDataType_AVX512(const std::span<const F16> source, const std::span<U8> destination) {
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512 one = _mm512_set1_ps(1.0f);
+        const __m512 scale = _mm512_set1_ps(255.0f);
+        const __m512 half = _mm512_set1_ps(0.5f);
+        const Size count = source.size();
+
+        // Process 16 elements at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < count; i += 16) {
+            const auto mask = static_cast<__mmask16>(count - i >= 16 ? 0xFFFF : (1u << (count - i)) - 1);
+
+            // Widen to float, then clamp, scale and round like the F32 to U8 conversion
+            __m512 floats = _mm512_maskz_cvtph_ps(mask, _mm256_maskz_loadu_epi16(mask, &source[i]));
+            floats = _mm512_maskz_min_ps(mask, _mm512_maskz_max_ps(mask, floats, zero), one);
+            floats = _mm512_add_ps(_mm512_mul_ps(floats, scale), half);
+            _mm512_mask_cvtusepi32_storeu_epi8(&destination[i], mask, _mm512_maskz_cvttps_epi32(mask, floats));
+        }
+    }
+
+}
+
+VL_SIMD_TARGET_END
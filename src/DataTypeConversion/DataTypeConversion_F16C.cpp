@@ -0,0 +1,93 @@
+#include "../Pch.hpp"
+
+#include "DataTypeConversion.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * F16C kernels, compiled with AVX2 and F16C enabled and only called if the CPU supports both.
+ */
+
+VL_SIMD_TARGET_BEGIN("avx2,f16c")
+
+namespace Velyra::Image::TranslateDataType {
+
+    void translateDataType_F16C(const std::span<const float> source, const std::span<F16> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 16 elements at a time, two independent conversions hide the latency of vcvtps2ph
+        for (; i + 16 <= count; i += 16) {
+            const __m256 floats_lo = _mm256_loadu_ps(&source[i]);
+            const __m256 floats_hi = _mm256_loadu_ps(&source[i + 8]);
+            const __m128i halves_lo = _mm256_cvtps_ph(floats_lo, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            const __m128i halves_hi = _mm256_cvtps_ph(floats_hi, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), halves_lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i + 8]), halves_hi);
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_F16C(const std::span<const F16> source, const std::span<float> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m128i halves_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+            const __m128i halves_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i + 8]));
+            _mm256_storeu_ps(&destination[i], _mm256_cvtph_ps(halves_lo));
+            _mm256_storeu_ps(&destination[i + 8], _mm256_cvtph_ps(halves_hi));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_F16C(const std::span<const U8> source, const std::span<F16> destination) {
+        const Size count = source.size();
+        const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+
+        Size i = 0;
+        // Process 8 elements at a time
+        for (; i + 8 <= count; i += 8) {
+            // Same scaling as the U8 to F32 conversion, then rounded to the nearest half
+            const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&source[i]));
+            const __m256 floats = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)), scale);
+            const __m128i halves = _mm256_cvtps_ph(floats, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), halves);
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_F16C(const std::span<const F16> source, const std::span<U8> destination) {
+        const Size count = source.size();
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(255.0f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+
+        Size i = 0;
+        // Process 8 elements at a time
+        for (; i + 8 <= count; i += 8) {
+            // Widen to float, then clamp, scale and round like the F32 to U8 conversion
+            __m256 floats = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i])));
+            floats = _mm256_min_ps(_mm256_max_ps(floats, zero), one);
+            floats = _mm256_add_ps(_mm256_mul_ps(floats, scale), half);
+            const __m256i ints = _mm256_cvttps_epi32(floats);
+
+            // Pack the two 128-bit lanes to 16-bit and then to 8-bit integers
+            const __m128i packed_16 = _mm_packus_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(&destination[i]), _mm_packus_epi16(packed_16, packed_16));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+}
+
+VL_SIMD_TARGET_END
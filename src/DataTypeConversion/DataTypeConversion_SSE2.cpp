@@ -0,0 +1,176 @@
+#include "../Pch.hpp"
+
+#include "DataTypeConversion.hpp"
+
+/*
+ * SSE2 kernels, SSE2 is part of the x86-64 baseline so this file needs no extra compile flags.
+ */
+
+namespace Velyra::Image::TranslateDataType {
+
+    void translateDataType_SSE2(const std::span<const U8> source, const std::span<float> destination) {
+        const Size count = source.size();
+        const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+        const __m128i zero = _mm_setzero_si128();
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+
+            // Zero-extend U8 to 16-bit, then 16-bit to 32-bit integers
+            const __m128i words_lo = _mm_unpacklo_epi8(bytes, zero);
+            const __m128i words_hi = _mm_unpackhi_epi8(bytes, zero);
+            const __m128i ints0 = _mm_unpacklo_epi16(words_lo, zero);
+            const __m128i ints1 = _mm_unpackhi_epi16(words_lo, zero);
+            const __m128i ints2 = _mm_unpacklo_epi16(words_hi, zero);
+            const __m128i ints3 = _mm_unpackhi_epi16(words_hi, zero);
+
+            _mm_storeu_ps(&destination[i], _mm_mul_ps(_mm_cvtepi32_ps(ints0), scale));
+            _mm_storeu_ps(&destination[i + 4], _mm_mul_ps(_mm_cvtepi32_ps(ints1), scale));
+            _mm_storeu_ps(&destination[i + 8], _mm_mul_ps(_mm_cvtepi32_ps(ints2), scale));
+            _mm_storeu_ps(&destination[i + 12], _mm_mul_ps(_mm_cvtepi32_ps(ints3), scale));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    namespace {
+
+        // Clamps 4 floats to [0.0, 1.0], scales them to [0, 255] and truncates them after adding 0.5 for rounding
+        __m128i floatsToInts_SSE2(const float* source) {
+            __m128 floats = _mm_loadu_ps(source);
+            floats = _mm_max_ps(floats, _mm_setzero_ps());
+            floats = _mm_min_ps(floats, _mm_set1_ps(1.0f));
+            floats = _mm_add_ps(_mm_mul_ps(floats, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+            return _mm_cvttps_epi32(floats);
+        }
+
+    }
+
+    void translateDataType_SSE2(const std::span<const float> source, const std::span<U8> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m128i ints0 = floatsToInts_SSE2(&source[i]);
+            const __m128i ints1 = floatsToInts_SSE2(&source[i + 4]);
+            const __m128i ints2 = floatsToInts_SSE2(&source[i + 8]);
+            const __m128i ints3 = floatsToInts_SSE2(&source[i + 12]);
+
+            // SSE2 only has a signed 32 -> 16 bit pack, which is exact as the values are already in [0, 255]
+            const __m128i words_lo = _mm_packs_epi32(ints0, ints1);
+            const __m128i words_hi = _mm_packs_epi32(ints2, ints3);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), _mm_packus_epi16(words_lo, words_hi));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_SSE2(const std::span<const U8> source, const std::span<U16> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+
+            // Interleaving every byte with itself gives v * 256 + v = v * 257
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), _mm_unpacklo_epi8(bytes, bytes));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i + 8]), _mm_unpackhi_epi8(bytes, bytes));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    namespace {
+
+        // Rounds 4 32-bit integers in [0, 65535] to v / 257 like roundU16ToU8, (v << 8) - v is v * 255 without pmulld
+        __m128i roundU16ToU8_SSE2(const __m128i ints) {
+            const __m128i scaled = _mm_sub_epi32(_mm_slli_epi32(ints, 8), ints);
+            return _mm_srli_epi32(_mm_add_epi32(scaled, _mm_set1_epi32(32895)), 16);
+        }
+
+    }
+
+    void translateDataType_SSE2(const std::span<const U16> source, const std::span<U8> destination) {
+        const Size count = source.size();
+        const __m128i zero = _mm_setzero_si128();
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m128i words_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+            const __m128i words_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i + 8]));
+
+            const __m128i ints0 = roundU16ToU8_SSE2(_mm_unpacklo_epi16(words_lo, zero));
+            const __m128i ints1 = roundU16ToU8_SSE2(_mm_unpackhi_epi16(words_lo, zero));
+            const __m128i ints2 = roundU16ToU8_SSE2(_mm_unpacklo_epi16(words_hi, zero));
+            const __m128i ints3 = roundU16ToU8_SSE2(_mm_unpackhi_epi16(words_hi, zero));
+
+            // The rounded values are in [0, 255], so the signed pack is exact
+            const __m128i packed_lo = _mm_packs_epi32(ints0, ints1);
+            const __m128i packed_hi = _mm_packs_epi32(ints2, ints3);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), _mm_packus_epi16(packed_lo, packed_hi));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_SSE2(const std::span<const U16> source, const std::span<float> destination) {
+        const Size count = source.size();
+        const __m128 scale = _mm_set1_ps(1.0f / 65535.0f);
+        const __m128i zero = _mm_setzero_si128();
+
+        Size i = 0;
+        // Process 8 elements at a time
+        for (; i + 8 <= count; i += 8) {
+            const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+            const __m128i ints_lo = _mm_unpacklo_epi16(words, zero);
+            const __m128i ints_hi = _mm_unpackhi_epi16(words, zero);
+            _mm_storeu_ps(&destination[i], _mm_mul_ps(_mm_cvtepi32_ps(ints_lo), scale));
+            _mm_storeu_ps(&destination[i + 4], _mm_mul_ps(_mm_cvtepi32_ps(ints_hi), scale));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    namespace {
+
+        // Clamps 4 floats to [0.0, 1.0], scales them to [0, 65535] and truncates them after adding 0.5 for rounding
+        __m128i floatsToU16Ints_SSE2(const float* source) {
+            __m128 floats = _mm_loadu_ps(source);
+            floats = _mm_max_ps(floats, _mm_setzero_ps());
+            floats = _mm_min_ps(floats, _mm_set1_ps(1.0f));
+            floats = _mm_add_ps(_mm_mul_ps(floats, _mm_set1_ps(65535.0f)), _mm_set1_ps(0.5f));
+            return _mm_cvttps_epi32(floats);
+        }
+
+    }
+
+    void translateDataType_SSE2(const std::span<const float> source, const std::span<U16> destination) {
+        const Size count = source.size();
+        const __m128i bias32 = _mm_set1_epi32(32768);
+        const __m128i bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+
+        Size i = 0;
+        // Process 8 elements at a time
+        for (; i + 8 <= count; i += 8) {
+            // Shift [0, 65535] to [-32768, 32767], pack with signed saturation (exact) and flip the sign bit back
+            const __m128i ints_lo = _mm_sub_epi32(floatsToU16Ints_SSE2(&source[i]), bias32);
+            const __m128i ints_hi = _mm_sub_epi32(floatsToU16Ints_SSE2(&source[i + 4]), bias32);
+            const __m128i words = _mm_xor_si128(_mm_packs_epi32(ints_lo, ints_hi), bias16);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), words);
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+}
@@ -0,0 +1,103 @@
+#include "../Pch.hpp"
+
+#include "DataTypeConversion.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * SSE4.1 kernels, compiled with SSE4.1 enabled and only called if the CPU supports it.
+ */
+
+VL_SIMD_TARGET_BEGIN("sse4.1")
+
+namespace Velyra::Image::TranslateDataType {
+
+    namespace {
+
+        // Clamps 4 floats to [0.0, 1.0], scales them to [0, 255] and truncates them after adding 0.5 for rounding
+        __m128i floatsToInts_SSE41(const float* source) {
+            __m128 floats = _mm_loadu_ps(source);
+            floats = _mm_max_ps(floats, _mm_setzero_ps());
+            floats = _mm_min_ps(floats, _mm_set1_ps(1.0f));
+            floats = _mm_add_ps(_mm_mul_ps(floats, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+            return _mm_cvttps_epi32(floats);
+        }
+
+    }
+
+    void translateDataType_SSE41(const std::span<const U8> source, const std::span<float> destination) {
+        const Size count = source.size();
+        const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+
+            // Zero-extend 4 bytes at a time directly to 32-bit integers
+            const __m128i ints0 = _mm_cvtepu8_epi32(bytes);
+            const __m128i ints1 = _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4));
+            const __m128i ints2 = _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 8));
+            const __m128i ints3 = _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 12));
+
+            _mm_storeu_ps(&destination[i], _mm_mul_ps(_mm_cvtepi32_ps(ints0), scale));
+            _mm_storeu_ps(&destination[i + 4], _mm_mul_ps(_mm_cvtepi32_ps(ints1), scale));
+            _mm_storeu_ps(&destination[i + 8], _mm_mul_ps(_mm_cvtepi32_ps(ints2), scale));
+            _mm_storeu_ps(&destination[i + 12], _mm_mul_ps(_mm_cvtepi32_ps(ints3), scale));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    void translateDataType_SSE41(const std::span<const float> source, const std::span<U8> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 16 elements at a time
+        for (; i + 16 <= count; i += 16) {
+            const __m128i ints0 = floatsToInts_SSE41(&source[i]);
+            const __m128i ints1 = floatsToInts_SSE41(&source[i + 4]);
+            const __m128i ints2 = floatsToInts_SSE41(&source[i + 8]);
+            const __m128i ints3 = floatsToInts_SSE41(&source[i + 12]);
+
+            // Pack 32-bit to 16-bit with unsigned saturation, then 16-bit to 8-bit
+            const __m128i words_lo = _mm_packus_epi32(ints0, ints1);
+            const __m128i words_hi = _mm_packus_epi32(ints2, ints3);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), _mm_packus_epi16(words_lo, words_hi));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+    namespace {
+
+        // Clamps 4 floats to [0.0, 1.0], scales them to [0, 65535] and truncates them after adding 0.5 for rounding
+        __m128i floatsToU16Ints_SSE41(const float* source) {
+            __m128 floats = _mm_loadu_ps(source);
+            floats = _mm_max_ps(floats, _mm_setzero_ps());
+            floats = _mm_min_ps(floats, _mm_set1_ps(1.0f));
+            floats = _mm_add_ps(_mm_mul_ps(floats, _mm_set1_ps(65535.0f)), _mm_set1_ps(0.5f));
+            return _mm_cvttps_epi32(floats);
+        }
+
+    }
+
+    void translateDataType_SSE41(const std::span<const float> source, const std::span<U16> destination) {
+        const Size count = source.size();
+
+        Size i = 0;
+        // Process 8 elements at a time
+        for (; i + 8 <= count; i += 8) {
+            const __m128i ints_lo = floatsToU16Ints_SSE41(&source[i]);
+            const __m128i ints_hi = floatsToU16Ints_SSE41(&source[i + 4]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), _mm_packus_epi32(ints_lo, ints_hi));
+        }
+
+        // Scalar tail for remaining elements
+        translateDataType_Scalar(source.subspan(i), destination.subspan(i));
+    }
+
+}
+
+VL_SIMD_TARGET_END
@@ -0,0 +1,55 @@
+#include "../Pch.hpp"
+
+#include "ParallelFor.hpp"
+#include "ThreadPool.hpp"
+
+#include <mutex>
+#include <thread>
+
+namespace Velyra::Image {
+
+    namespace {
+
+        std::mutex s_ExecutorMutex;
+        SP<IExecutor> s_Executor;
+
+    }
+
+    SP<IExecutor> createThreadPool(const Size threadCount) {
+        const Size count = threadCount != 0 ? threadCount : std::max<Size>(std::thread::hardware_concurrency(), 1);
+        return createSP<ThreadPool>(count);
+    }
+
+    void setExecutor(SP<IExecutor> executor) {
+        std::lock_guard lock(s_ExecutorMutex);
+        s_Executor = std::move(executor);
+    }
+
+    SP<IExecutor> getExecutor() {
+        std::lock_guard lock(s_ExecutorMutex);
+        if (!s_Executor) {
+            s_Executor = createThreadPool();
+        }
+        return s_Executor;
+    }
+
+    void parallelForBlocks(const VL_EXECUTION_POLICY policy, const Size itemCount, const Size bytesPerItem,
+        const std::function<void(Size begin, Size end)>& function) {
+        if (policy != VL_EXECUTION_PARALLEL || itemCount * bytesPerItem < PARALLEL_MIN_BYTES) {
+            function(0, itemCount);
+            return;
+        }
+        const SP<IExecutor> executor = getExecutor();
+        if (executor->getConcurrency() <= 1) {
+            function(0, itemCount);
+            return;
+        }
+        const Size itemsPerBlock = std::max<Size>(PARALLEL_BLOCK_BYTES / std::max<Size>(bytesPerItem, 1), 1);
+        const Size blockCount = (itemCount + itemsPerBlock - 1) / itemsPerBlock;
+        executor->parallelFor(blockCount, [&](const Size block) {
+            const Size begin = block * itemsPerBlock;
+            function(begin, std::min(begin + itemsPerBlock, itemCount));
+        });
+    }
+
+}
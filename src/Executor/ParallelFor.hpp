@@ -0,0 +1,22 @@
+#pragma once
+
+#include <VelyraImage/Executor.hpp>
+
+namespace Velyra::Image {
+
+    // Every block of a parallel conversion reads and writes about this many bytes, so it stays in the L2 cache
+    inline constexpr Size PARALLEL_BLOCK_BYTES = 256 * 1024;
+
+    // Conversions touching fewer bytes run inline, the wake up of the workers costs more than it saves
+    inline constexpr Size PARALLEL_MIN_BYTES = 4 * PARALLEL_BLOCK_BYTES;
+
+    /**
+     * @brief Splits [0, itemCount) into cache sized blocks and runs function(begin, end) for every block.
+     *        With VL_EXECUTION_SEQUENTIAL, small inputs or an executor without parallelism, function is called once
+     *        for the whole range on the calling thread.
+     * @param bytesPerItem Bytes read and written per item, used to size the blocks
+     */
+    void parallelForBlocks(VL_EXECUTION_POLICY policy, Size itemCount, Size bytesPerItem,
+        const std::function<void(Size begin, Size end)>& function);
+
+}
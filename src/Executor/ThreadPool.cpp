@@ -0,0 +1,147 @@
+#include "../Pch.hpp"
+
+#include "ThreadPool.hpp"
+
+namespace Velyra::Image {
+
+    namespace {
+
+        // Lets nested parallelFor calls and idle workers start with their own queue
+        thread_local const ThreadPool* t_CurrentPool = nullptr;
+        thread_local Size t_CurrentQueue = 0;
+
+    }
+
+    ThreadPool::ThreadPool(const Size threadCount) {
+        // The thread calling parallelFor also runs tasks, so one thread less is spawned
+        const Size workerCount = threadCount > 1 ? threadCount - 1 : 0;
+        for (Size i = 0; i < workerCount; ++i) {
+            m_Queues.push_back(createUP<WorkerQueue>());
+        }
+        for (Size i = 0; i < workerCount; ++i) {
+            m_Workers.emplace_back([this, i](const std::stop_token& stopToken) { workerLoop(stopToken, i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        for (auto& worker: m_Workers) {
+            worker.request_stop();
+        }
+        m_WakeCondition.notify_all();
+        m_Workers.clear();
+    }
+
+    Size ThreadPool::getConcurrency() const {
+        return m_Workers.size() + 1;
+    }
+
+    void ThreadPool::parallelFor(const Size taskCount, const std::function<void(Size)>& task) {
+        if (taskCount == 0) {
+            return;
+        }
+        if (m_Workers.empty() || taskCount == 1) {
+            for (Size i = 0; i < taskCount; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        Job job;
+        job.function = &task;
+        job.remaining = taskCount;
+
+        // Counted before the tasks are queued, so the counter never drops below zero while workers pop them
+        {
+            std::lock_guard lock(m_WakeMutex);
+            m_QueuedTasks += taskCount;
+        }
+
+        // Contiguous ranges keep neighbouring blocks on the same worker, stealing balances the rest
+        const Size queueCount = m_Queues.size();
+        for (Size q = 0; q < queueCount; ++q) {
+            const Size begin = taskCount * q / queueCount;
+            const Size end = taskCount * (q + 1) / queueCount;
+            if (begin == end) {
+                continue;
+            }
+            std::lock_guard lock(m_Queues[q]->mutex);
+            for (Size i = begin; i < end; ++i) {
+                m_Queues[q]->tasks.push_back({&job, i});
+            }
+        }
+        m_WakeCondition.notify_all();
+
+        // Help with the queued tasks (of this or any other job), then wait for the tasks that are still running
+        const Size preferredQueue = t_CurrentPool == this ? t_CurrentQueue : 0;
+        Task next;
+        while (job.remaining.load(std::memory_order_acquire) != 0 && popTask(preferredQueue, next)) {
+            runTask(next);
+        }
+        {
+            std::unique_lock lock(job.mutex);
+            job.finished.wait(lock, [&job] { return job.remaining.load(std::memory_order_acquire) == 0; });
+        }
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+    bool ThreadPool::popTask(const Size preferredQueue, Task& task) {
+        {
+            WorkerQueue& own = *m_Queues[preferredQueue];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = own.tasks.front();
+                own.tasks.pop_front();
+                --m_QueuedTasks;
+                return true;
+            }
+        }
+        for (Size offset = 1; offset < m_Queues.size(); ++offset) {
+            WorkerQueue& victim = *m_Queues[(preferredQueue + offset) % m_Queues.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                --m_QueuedTasks;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::runTask(const Task& task) {
+        Job& job = *task.job;
+        std::exception_ptr error;
+        try {
+            (*job.function)(task.index);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        // The job lives on the stack of the caller, which can only see the last decrement after acquiring the lock,
+        // so the job is not touched anymore once it is released
+        std::lock_guard lock(job.mutex);
+        if (error && !job.error) {
+            job.error = error;
+        }
+        if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            job.finished.notify_all();
+        }
+    }
+
+    void ThreadPool::workerLoop(const std::stop_token& stopToken, const Size workerIndex) {
+        t_CurrentPool = this;
+        t_CurrentQueue = workerIndex;
+        while (!stopToken.stop_requested()) {
+            Task task;
+            if (popTask(workerIndex, task)) {
+                runTask(task);
+                continue;
+            }
+            std::unique_lock lock(m_WakeMutex);
+            m_WakeCondition.wait(lock, stopToken, [this] { return m_QueuedTasks.load() != 0; });
+        }
+    }
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <VelyraImage/Executor.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Work-stealing thread pool.
+     *        Every worker owns a queue, parallelFor hands each queue a contiguous range of the tasks. Workers take
+     *        tasks from the front of their own queue and steal from the back of the others once it runs dry. The
+     *        thread calling parallelFor helps until no queued task is left, so nested calls cannot deadlock.
+     */
+    class ThreadPool final: public IExecutor {
+    public:
+        explicit ThreadPool(Size threadCount);
+
+        ~ThreadPool() override;
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        Size getConcurrency() const override;
+
+        void parallelFor(Size taskCount, const std::function<void(Size)>& task) override;
+
+    private:
+        struct Job {
+            const std::function<void(Size)>* function = nullptr;
+            std::atomic<Size> remaining = 0;
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr error;
+        };
+
+        struct Task {
+            Job* job = nullptr;
+            Size index = 0;
+        };
+
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        bool popTask(Size preferredQueue, Task& task);
+
+        static void runTask(const Task& task);
+
+        void workerLoop(const std::stop_token& stopToken, Size workerIndex);
+
+    private:
+        std::vector<UP<WorkerQueue>> m_Queues;
+        std::atomic<Size> m_QueuedTasks = 0;
+        std::mutex m_WakeMutex;
+        std::condition_variable_any m_WakeCondition;
+        std::vector<std::jthread> m_Workers;
+    };
+
+}
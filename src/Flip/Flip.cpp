@@ -0,0 +1,25 @@
+#include "../Pch.hpp"
+
+#include "Flip.hpp"
+
+#include <cstring>
+
+namespace Velyra::Image {
+
+    void swapRows_Scalar(U8* first, U8* second, const Size byteCount) {
+        Size i = 0;
+        // Swap 8 bytes at a time, memcpy avoids unaligned accesses
+        for (; i + 8 <= byteCount; i += 8) {
+            U64 a;
+            U64 b;
+            std::memcpy(&a, first + i, 8);
+            std::memcpy(&b, second + i, 8);
+            std::memcpy(first + i, &b, 8);
+            std::memcpy(second + i, &a, 8);
+        }
+        for (; i < byteCount; ++i) {
+            std::swap(first[i], second[i]);
+        }
+    }
+
+}
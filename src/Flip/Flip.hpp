@@ -0,0 +1,50 @@
+#pragma once
+
+#include <span>
+
+#include <VelyraImage/ImageDefs.hpp>
+
+#include "../SimdDispatch.hpp"
+#include "../Executor/ParallelFor.hpp"
+#include "../Metrics.hpp"
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Swaps byteCount bytes between first and second, the ranges must not overlap.
+     */
+    void swapRows_Scalar(U8* first, U8* second, Size byteCount);
+
+    /**
+     * @brief SSE2 row swap, also used for VL_SIMD_SSSE3 and VL_SIMD_SSE41
+     */
+    void swapRows_SSE2(U8* first, U8* second, Size byteCount);
+
+    void swapRows_AVX2(U8* first, U8* second, Size byteCount);
+
+    void swapRows_AVX512(U8* first, U8* second, Size byteCount);
+
+    /**
+     * @brief Reverses the order of the rows of an image in place. Rows are swapped pairwise from the outside in,
+     *        so every byte is read and written once and no temporary row is needed.
+     * @param data Pixels of the image, data.size() must be a multiple of rowBytes
+     * @param rowBytes Size of one row in bytes
+     */
+    inline void flipRowsInPlace(const std::span<U8> data, const Size rowBytes, const VL_SIMD_MODE simdMode,
+        const VL_EXECUTION_POLICY executionPolicy) {
+        if (rowBytes == 0) {
+            return;
+        }
+        const SimdDispatchTable& table = getDispatchTable(simdMode);
+        const auto kernel = table.swapRows;
+        const Size rowCount = data.size() / rowBytes;
+        const ScopedOperationMetrics metrics(VL_OPERATION_FLIP, table.mode, 2 * data.size_bytes());
+        // Every pair reads and writes two rows
+        parallelForBlocks(executionPolicy, rowCount / 2, 4 * rowBytes, [&](const Size begin, const Size end) {
+            for (Size i = begin; i < end; ++i) {
+                kernel(data.data() + i * rowBytes, data.data() + (rowCount - 1 - i) * rowBytes, rowBytes);
+            }
+        });
+    }
+
+}
@@ -0,0 +1,32 @@
+#include "../Pch.hpp"
+
+#include "Flip.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * AVX2 kernels, compiled with AVX2 enabled and only called if the CPU supports it.
+ */
+
+VL_SIMD_TARGET_BEGIN("avx2")
+
+namespace Velyra::Image {
+
+    void swapRows_AVX2(U8* first, U8* second, const Size byteCount) {
+        Size i = 0;
+        // Swap 64 bytes (a cache line) at a time
+        for (; i + 64 <= byteCount; i += 64) {
+            const __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+            const __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i + 32));
+            const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i));
+            const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i + 32));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(first + i), b0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(first + i + 32), b1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(second + i), a0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(second + i + 32), a1);
+        }
+        swapRows_Scalar(first + i, second + i, byteCount - i);
+    }
+
+}
+
+VL_SIMD_TARGET_END
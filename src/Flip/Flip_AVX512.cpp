@@ -0,0 +1,28 @@
+#include "../Pch.hpp"
+
+#include "Flip.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * AVX-512 kernels, compiled with AVX512-F/BW/VL enabled and only called if the CPU supports them.
+ */
+
+VL_SIMD_TARGET_BEGIN("avx512f,avx512bw,avx512vl")
+
+namespace Velyra::Image {
+
+    void swapRows_AVX512(U8* first, U8* second, const Size byteCount) {
+        // Swap 64 bytes at a time, the tail uses masked loads and stores instead of a scalar loop
+        for (Size i = 0; i < byteCount; i += 64) {
+            const Size remaining = byteCount - i;
+            const __mmask64 mask = remaining >= 64 ? ~__mmask64{0} : (__mmask64{1} << remaining) - 1;
+            const __m512i a = _mm512_maskz_loadu_epi8(mask, first + i);
+            const __m512i b = _mm512_maskz_loadu_epi8(mask, second + i);
+            _mm512_mask_storeu_epi8(first + i, mask, b);
+            _mm512_mask_storeu_epi8(second + i, mask, a);
+        }
+    }
+
+}
+
+VL_SIMD_TARGET_END
@@ -0,0 +1,27 @@
+#include "../Pch.hpp"
+
+#include "Flip.hpp"
+
+/*
+ * SSE2 kernels, SSE2 is part of the x86-64 baseline so this file needs no extra compile flags.
+ */
+
+namespace Velyra::Image {
+
+    void swapRows_SSE2(U8* first, U8* second, const Size byteCount) {
+        Size i = 0;
+        // Swap 32 bytes at a time, two registers per row hide the load latency
+        for (; i + 32 <= byteCount; i += 32) {
+            const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+            const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + 16));
+            const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+            const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i + 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(first + i), b0);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(first + i + 16), b1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(second + i), a0);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(second + i + 16), a1);
+        }
+        swapRows_Scalar(first + i, second + i, byteCount - i);
+    }
+
+}
@@ -4,15 +4,73 @@
 
 #include <VelyraImage/ImageDefs.hpp>
 #include <VelyraUtils/TypeTraits.hpp>
+#include <VelyraUtils/DevUtils/Conditions.hpp>
 
 #include "../ImageUtils.hpp"
+#include "../SimdDispatch.hpp"
+#include "../Executor/ParallelFor.hpp"
+#include "../Metrics.hpp"
+#include "Swizzle.hpp"
 
 namespace Velyra::Image {
 
+    /**
+     * @brief Returns the swizzle of getSwizzle() as a vector of targetStride entries, -1 marks a filled channel.
+     *        The conversion kernels use the compile time tables directly, this is meant for inspection only.
+     */
     std::vector<int> defineSwizzle(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat);
 
     void convertFormat_U8_AVX2(VL_CHANNEL_FORMAT sourceFormat, std::span<const U8> sourceData,
-        VL_CHANNEL_FORMAT targetFormat, std::vector<U8>& targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+        VL_CHANNEL_FORMAT targetFormat, std::span<U8> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    void convertFormat_F32_AVX2(VL_CHANNEL_FORMAT sourceFormat, std::span<const float> sourceData,
+        VL_CHANNEL_FORMAT targetFormat, std::span<float> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    /**
+     * @brief Uses vpermb, falls back to convertFormat_U8_AVX2 if the CPU lacks AVX512-VBMI.
+     */
+    void convertFormat_U8_AVX512(VL_CHANNEL_FORMAT sourceFormat, std::span<const U8> sourceData,
+        VL_CHANNEL_FORMAT targetFormat, std::span<U8> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    void convertFormat_F32_AVX512(VL_CHANNEL_FORMAT sourceFormat, std::span<const float> sourceData,
+        VL_CHANNEL_FORMAT targetFormat, std::span<float> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    /**
+     * @brief SSE2 has no byte shuffle, only 4 -> 4 channel pairs are vectorized, the others use the scalar kernels.
+     */
+    void convertFormat_U8_SSE2(VL_CHANNEL_FORMAT sourceFormat, std::span<const U8> sourceData,
+        VL_CHANNEL_FORMAT targetFormat, std::span<U8> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    /**
+     * @brief Also used for VL_SIMD_SSE41, SSE4.1 adds nothing that this conversion benefits from.
+     */
+    void convertFormat_U8_SSSE3(VL_CHANNEL_FORMAT sourceFormat, std::span<const U8> sourceData,
+        VL_CHANNEL_FORMAT targetFormat, std::span<U8> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    /**
+     * @brief Also used for VL_SIMD_SSSE3 and VL_SIMD_SSE41.
+     */
+    void convertFormat_F32_SSE2(VL_CHANNEL_FORMAT sourceFormat, std::span<const float> sourceData,
+        VL_CHANNEL_FORMAT targetFormat, std::span<float> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    /*
+     * In place swizzles, only for format pairs with the same channel count (see Swizzle::isPermutation).
+     * The SIMD mode mapping is the same as for the conversions above.
+     */
+
+    void swizzleInPlace_U8_SSE2(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, std::span<U8> data);
+
+    void swizzleInPlace_U8_SSSE3(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, std::span<U8> data);
+
+    void swizzleInPlace_U8_AVX2(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, std::span<U8> data);
+
+    void swizzleInPlace_U8_AVX512(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, std::span<U8> data);
+
+    void swizzleInPlace_F32_SSE2(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, std::span<float> data);
+
+    void swizzleInPlace_F32_AVX2(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, std::span<float> data);
+
+    void swizzleInPlace_F32_AVX512(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, std::span<float> data);
 
     template<typename T>
     T getFillValue(const VL_FORMAT_CONVERSION_FILL fillMode) {
@@ -23,6 +81,13 @@ namespace Velyra::Image {
                 default: return 1.0f;
             }
         }
+        else if constexpr (std::is_same_v<T, F16>) {
+            switch (fillMode) {
+                case VL_FILL_MIN: return F16{0x0000}; // 0.0
+                case VL_FILL_MAX: return F16{0x3C00}; // 1.0
+                default: return F16{0x3C00};
+            }
+        }
         else if constexpr (std::is_integral_v<T>) {
             switch (fillMode) {
                 case VL_FILL_MIN: return std::numeric_limits<T>::min();
@@ -36,44 +101,171 @@ namespace Velyra::Image {
         }
     }
 
+    /**
+     * @brief Converts pixelCount pixels from SRC to DST. The swizzle is a compile time constant, so the per-channel
+     *        loop and the fill branches are resolved by the compiler.
+     */
+    template<typename T, VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+    void convertPixels_Scalar(const T* source, T* target, const Size pixelCount, const T fillValue) {
+        constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+        for (Size i = 0; i < pixelCount; ++i) {
+            const T* sourcePixel = source + i * swizzle.sourceStride;
+            T* targetPixel = target + i * swizzle.targetStride;
+            [&]<Size... C>(std::index_sequence<C...>) {
+                ((targetPixel[C] = swizzle.channels[C] < 0 ? fillValue : sourcePixel[swizzle.channels[C]]), ...);
+            }(std::make_index_sequence<swizzle.targetStride>{});
+        }
+    }
+
     template<typename T>
-    void convertFormat_Scalar(const VL_CHANNEL_FORMAT sourceFormat, std::span<const T> sourceData,
-        const VL_CHANNEL_FORMAT targetFormat, std::vector<T>& targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+    using FormatKernel = void(*)(const T*, T*, Size, T);
 
-        const std::vector<int> swizzle = defineSwizzle(sourceFormat, targetFormat);
-        const T fillValue = getFillValue<T>(fillMode);
-        const U32 sourceChannelCount = getChannelCountFromFormat(sourceFormat);
+    template<typename T>
+    struct ScalarKernelFactory {
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        static constexpr FormatKernel<T> get() { return &convertPixels_Scalar<T, SRC, DST>; }
+    };
+
+    template<typename T>
+    inline constexpr auto FORMAT_KERNELS_SCALAR = makeFormatKernelTable<FormatKernel<T>, ScalarKernelFactory<T>>();
 
-        const Size pixelCount = sourceData.size() / getChannelCountFromFormat(sourceFormat);
+    /**
+     * @brief Reorders the channels of pixelCount pixels in place, every pixel is read completely before it is written.
+     */
+    template<typename T, VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+    void swizzlePixelsInPlace_Scalar(T* data, const Size pixelCount) {
+        constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+        static_assert(swizzle.isPermutation(), "In place swizzles need a permutation of the channels");
         for (Size i = 0; i < pixelCount; ++i) {
-            for (Size j = 0; j < swizzle.size(); ++j) {
-                // Is the channel present in the source format?
-                if (swizzle[j] != -1) {
-                    targetData[i * swizzle.size() + j] = sourceData[i * sourceChannelCount + static_cast<Size>(swizzle[j])];
-                }
-                else {
-                    targetData[i * swizzle.size() + j] = fillValue;
-                }
-            }
+            T* pixel = data + i * swizzle.targetStride;
+            [&]<Size... C>(std::index_sequence<C...>) {
+                const std::array<T, swizzle.targetStride> original = {pixel[C]...};
+                ((pixel[C] = original[swizzle.channels[C]]), ...);
+            }(std::make_index_sequence<swizzle.targetStride>{});
         }
     }
 
     template<typename T>
-    void convertFormat(const VL_CHANNEL_FORMAT sourceFormat, std::span<const T> sourceData,
-        std::vector<T>& targetData, const FormatConversionDesc& desc) {
-        switch (findBestMode(desc.simdMode)) {
-            case VL_SIMD_AVX2: {
-                if constexpr (std::is_same_v<T, U8>) {
-                    convertFormat_U8_AVX2(sourceFormat, sourceData, desc.targetFormat, targetData, desc.fillMode);
-                    return;
-                }
-                break;
+    using InPlaceKernel = void(*)(T*, Size);
+
+    template<typename T>
+    struct ScalarInPlaceKernelFactory {
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        static constexpr InPlaceKernel<T> get() {
+            if constexpr (getSwizzle(SRC, DST).isPermutation()) {
+                return &swizzlePixelsInPlace_Scalar<T, SRC, DST>;
             }
-            default: {
-                break;
+            else {
+                return nullptr;
             }
         }
+    };
 
-        convertFormat_Scalar<T>(sourceFormat, sourceData, desc.targetFormat, targetData, desc.fillMode);
+    template<typename T>
+    inline constexpr auto IN_PLACE_KERNELS_SCALAR = makeFormatKernelTable<InPlaceKernel<T>, ScalarInPlaceKernelFactory<T>>();
+
+    /**
+     * @brief Looks up the kernel for the format pair in a table created by makeFormatKernelTable and runs it.
+     */
+    void dispatchFormatKernel(const FormatKernelTable<FormatKernel<U8>>& kernels, VL_CHANNEL_FORMAT sourceFormat,
+        std::span<const U8> sourceData, VL_CHANNEL_FORMAT targetFormat, std::span<U8> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    void dispatchFormatKernel(const FormatKernelTable<FormatKernel<float>>& kernels, VL_CHANNEL_FORMAT sourceFormat,
+        std::span<const float> sourceData, VL_CHANNEL_FORMAT targetFormat, std::span<float> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    void dispatchFormatKernel(const FormatKernelTable<FormatKernel<U16>>& kernels, VL_CHANNEL_FORMAT sourceFormat,
+        std::span<const U16> sourceData, VL_CHANNEL_FORMAT targetFormat, std::span<U16> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    void dispatchFormatKernel(const FormatKernelTable<FormatKernel<F16>>& kernels, VL_CHANNEL_FORMAT sourceFormat,
+        std::span<const F16> sourceData, VL_CHANNEL_FORMAT targetFormat, std::span<F16> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    /**
+     * @brief Converts the pixels left over by a SIMD kernel with the scalar kernel of the format pair.
+     *        The SIMD kernels are compiled with wider instruction sets than the rest of the library, so they call this
+     *        instead of instantiating convertPixels_Scalar themselves (the linker could otherwise pick their copy).
+     */
+    void convertTail_Scalar(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, const U8* source, U8* target,
+        Size pixelCount, U8 fillValue);
+
+    void convertTail_Scalar(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, const float* source, float* target,
+        Size pixelCount, float fillValue);
+
+    /**
+     * @brief Looks up the in place kernel for the format pair and runs it, throws if the formats are not a permutation
+     *        of each other.
+     */
+    void dispatchInPlaceKernel(const FormatKernelTable<InPlaceKernel<U8>>& kernels, VL_CHANNEL_FORMAT sourceFormat,
+        VL_CHANNEL_FORMAT targetFormat, std::span<U8> data);
+
+    void dispatchInPlaceKernel(const FormatKernelTable<InPlaceKernel<float>>& kernels, VL_CHANNEL_FORMAT sourceFormat,
+        VL_CHANNEL_FORMAT targetFormat, std::span<float> data);
+
+    void dispatchInPlaceKernel(const FormatKernelTable<InPlaceKernel<U16>>& kernels, VL_CHANNEL_FORMAT sourceFormat,
+        VL_CHANNEL_FORMAT targetFormat, std::span<U16> data);
+
+    void dispatchInPlaceKernel(const FormatKernelTable<InPlaceKernel<F16>>& kernels, VL_CHANNEL_FORMAT sourceFormat,
+        VL_CHANNEL_FORMAT targetFormat, std::span<F16> data);
+
+    /**
+     * @brief In place version of convertTail_Scalar.
+     */
+    void swizzleTail_Scalar(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, U8* data, Size pixelCount);
+
+    void swizzleTail_Scalar(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, float* data, Size pixelCount);
+
+    template<typename T>
+    void convertFormat_Scalar(const VL_CHANNEL_FORMAT sourceFormat, std::span<const T> sourceData,
+        const VL_CHANNEL_FORMAT targetFormat, std::span<T> targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        dispatchFormatKernel(FORMAT_KERNELS_SCALAR<T>, sourceFormat, sourceData, targetFormat, targetData, fillMode);
+    }
+
+    template<typename T>
+    void swizzleInPlace_Scalar(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat, std::span<T> data) {
+        dispatchInPlaceKernel(IN_PLACE_KERNELS_SCALAR<T>, sourceFormat, targetFormat, data);
+    }
+
+    template<typename T>
+    void convertFormat(const VL_CHANNEL_FORMAT sourceFormat, std::span<const T> sourceData,
+        std::span<T> targetData, const FormatConversionDesc& desc) {
+        const SimdDispatchTable& table = getDispatchTable(desc.simdMode);
+        const auto kernel = table.getConvertFormat<T>();
+        const Swizzle swizzle = getSwizzle(sourceFormat, desc.targetFormat);
+        if (!swizzle.isValid()) {
+            kernel(sourceFormat, sourceData, desc.targetFormat, targetData, desc.fillMode); // Throws
+            return;
+        }
+        const ScopedOperationMetrics metrics(VL_OPERATION_CONVERT_FORMAT, table.mode, sourceData.size_bytes() + targetData.size_bytes());
+        const Size pixelCount = std::min(sourceData.size() / swizzle.sourceStride, targetData.size() / swizzle.targetStride);
+        const Size bytesPerPixel = (swizzle.sourceStride + swizzle.targetStride) * sizeof(T);
+        parallelForBlocks(desc.executionPolicy, pixelCount, bytesPerPixel, [&](const Size begin, const Size end) {
+            kernel(sourceFormat, sourceData.subspan(begin * swizzle.sourceStride, (end - begin) * swizzle.sourceStride),
+                desc.targetFormat, targetData.subspan(begin * swizzle.targetStride, (end - begin) * swizzle.targetStride),
+                desc.fillMode);
+        });
+    }
+
+    /**
+     * @brief Converts data from sourceFormat to desc.targetFormat without a second buffer.
+     *        Only possible if both formats have the same channels (e.g. RGBA and BGRA), throws otherwise.
+     */
+    template<typename T>
+    void convertFormatInPlace(const VL_CHANNEL_FORMAT sourceFormat, std::span<T> data, const FormatConversionDesc& desc) {
+        const SimdDispatchTable& table = getDispatchTable(desc.simdMode);
+        const auto kernel = table.getSwizzleInPlace<T>();
+        const Swizzle swizzle = getSwizzle(sourceFormat, desc.targetFormat);
+        if (!swizzle.isPermutation()) {
+            kernel(sourceFormat, desc.targetFormat, data); // Throws
+            return;
+        }
+        if (sourceFormat == desc.targetFormat) {
+            return;
+        }
+        const ScopedOperationMetrics metrics(VL_OPERATION_CONVERT_FORMAT, table.mode, 2 * data.size_bytes());
+        const Size pixelCount = data.size() / swizzle.targetStride;
+        // Every pixel is read and written once
+        const Size bytesPerPixel = 2 * swizzle.targetStride * sizeof(T);
+        parallelForBlocks(desc.executionPolicy, pixelCount, bytesPerPixel, [&](const Size begin, const Size end) {
+            kernel(sourceFormat, desc.targetFormat, data.subspan(begin * swizzle.targetStride, (end - begin) * swizzle.targetStride));
+        });
     }
-}
+}
\ No newline at end of file
@@ -0,0 +1,378 @@
+#include "../Pch.hpp"
+
+#include "FormatConversion.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * AVX2 kernels, compiled with AVX2 enabled and only called if the CPU supports it.
+ */
+
+VL_SIMD_TARGET_BEGIN("avx2")
+
+namespace Velyra::Image {
+
+    namespace {
+
+        struct ShuffleMasks_U8_AVX2 {
+            __m256i shuffle;    // _mm256_shuffle_epi8 mask, fill positions are 0x80 so they become zero
+            __m256i fill;       // Fill value at the fill positions and zero elsewhere, OR'ed into the shuffled result
+        };
+
+        ShuffleMasks_U8_AVX2 loadShuffleMasks_U8_AVX2(const ShuffleTable_U8& table, const U8 fillValue) {
+            const __m256i fillPositions = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.fillPositions.data()));
+            return {
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.shuffle.data())),
+                _mm256_and_si256(fillPositions, _mm256_set1_epi8(static_cast<char>(fillValue)))
+            };
+        }
+
+        __m256i applyMasks_U8_AVX2(const __m256i block, const ShuffleMasks_U8_AVX2& masks) {
+            return _mm256_or_si256(_mm256_shuffle_epi8(block, masks.shuffle), masks.fill);
+        }
+
+        // Moves the 12 byte groups at byte 0 and byte 12 to the start of the low and high lane
+        __m256i spread3BytePixels(const __m256i block) {
+            return _mm256_permutevar8x32_epi32(block, _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
+        }
+
+        // Moves the 12 byte groups at the start of both lanes next to each other (bytes 0-23)
+        __m256i compact3BytePixels(const __m256i block) {
+            return _mm256_permutevar8x32_epi32(block, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        }
+
+        void store24Bytes(U8* dst, const __m256i vec) {
+            // 16 + 8 byte stores never touch bytes past the 24 converted ones
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(vec));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), _mm256_extracti128_si256(vec, 1));
+        }
+
+        /*
+         * All kernels below return the number of pixels they converted, the caller converts the remaining pixels.
+         */
+
+        // 4 -> 4 channels (e.g. RGBA -> BGRA): 8 pixels fill a whole 256-bit register on both ends
+        Size convert4To4_U8_AVX2(const U8* src, U8* dst, const Size pixelCount, const ShuffleMasks_U8_AVX2& masks) {
+            Size i = 0;
+            for (; i + 16 <= pixelCount; i += 16) {
+                const __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                const __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4 + 32));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), applyMasks_U8_AVX2(block0, masks));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4 + 32), applyMasks_U8_AVX2(block1, masks));
+            }
+            for (; i + 8 <= pixelCount; i += 8) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), applyMasks_U8_AVX2(block, masks));
+            }
+            return i;
+        }
+
+        // 3 -> 4 channels (e.g. RGB -> RGBA): 8 pixels are 24 source bytes, spread over both lanes with a cross-lane permute
+        Size convert3To4_U8_AVX2(const U8* src, U8* dst, const Size pixelCount, const ShuffleMasks_U8_AVX2& masks) {
+            Size i = 0;
+            // The 32 byte load reads 8 bytes past the 24 that are converted, so it must stay in range as well
+            for (; i + 16 + 3 <= pixelCount; i += 16) {
+                const __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 3));
+                const __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 3 + 24));
+                const __m256i spread0 = spread3BytePixels(block0);
+                const __m256i spread1 = spread3BytePixels(block1);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), applyMasks_U8_AVX2(spread0, masks));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4 + 32), applyMasks_U8_AVX2(spread1, masks));
+            }
+            for (; i + 8 + 3 <= pixelCount; i += 8) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 3));
+                const __m256i spread = spread3BytePixels(block);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), applyMasks_U8_AVX2(spread, masks));
+            }
+            return i;
+        }
+
+        // 4 -> 3 channels (e.g. BGRA -> RGB): shuffle 4 pixels to the start of each lane, then compact both lanes
+        Size convert4To3_U8_AVX2(const U8* src, U8* dst, const Size pixelCount, const ShuffleMasks_U8_AVX2& masks) {
+            Size i = 0;
+            for (; i + 16 <= pixelCount; i += 16) {
+                const __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                const __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4 + 32));
+                const __m256i out0 = compact3BytePixels(applyMasks_U8_AVX2(block0, masks));
+                const __m256i out1 = compact3BytePixels(applyMasks_U8_AVX2(block1, masks));
+                store24Bytes(dst + i * 3, out0);
+                store24Bytes(dst + i * 3 + 24, out1);
+            }
+            for (; i + 8 <= pixelCount; i += 8) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                const __m256i out = compact3BytePixels(applyMasks_U8_AVX2(block, masks));
+                store24Bytes(dst + i * 3, out);
+            }
+            return i;
+        }
+
+        // 3 -> 3 channels (e.g. RGB -> BGR): spread, shuffle within the lanes and compact again
+        Size convert3To3_U8_AVX2(const U8* src, U8* dst, const Size pixelCount, const ShuffleMasks_U8_AVX2& masks) {
+            Size i = 0;
+            for (; i + 16 + 3 <= pixelCount; i += 16) {
+                const __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 3));
+                const __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 3 + 24));
+                const __m256i spread0 = spread3BytePixels(block0);
+                const __m256i spread1 = spread3BytePixels(block1);
+                store24Bytes(dst + i * 3, compact3BytePixels(applyMasks_U8_AVX2(spread0, masks)));
+                store24Bytes(dst + i * 3 + 24, compact3BytePixels(applyMasks_U8_AVX2(spread1, masks)));
+            }
+            for (; i + 8 + 3 <= pixelCount; i += 8) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 3));
+                const __m256i spread = spread3BytePixels(block);
+                store24Bytes(dst + i * 3, compact3BytePixels(applyMasks_U8_AVX2(spread, masks)));
+            }
+            return i;
+        }
+
+        // Any other pair: each 128-bit lane converts PIXELS_PER_LANE pixels, loaded from and stored to independent offsets.
+        // _mm256_shuffle_epi8 cannot move bytes across the lane boundary, so the lanes are filled with two 128-bit loads.
+        template<U32 SRC_STRIDE, U32 DST_STRIDE, Size PIXELS_PER_LANE>
+        Size convertGeneric_U8_AVX2(const U8* src, U8* dst, const Size pixelCount, const ShuffleMasks_U8_AVX2& masks) {
+            constexpr Size srcLaneBytes = PIXELS_PER_LANE * SRC_STRIDE;
+            constexpr Size dstLaneBytes = PIXELS_PER_LANE * DST_STRIDE;
+            const Size srcByteCount = pixelCount * SRC_STRIDE;
+            const Size dstByteCount = pixelCount * DST_STRIDE;
+            Size i = 0;
+            for (; i + 2 * PIXELS_PER_LANE <= pixelCount; i += 2 * PIXELS_PER_LANE) {
+                const Size srcOffset = i * SRC_STRIDE;
+                const Size dstOffset = i * DST_STRIDE;
+                // Both lanes load and store 16 bytes, which must stay in range even if fewer bytes are used
+                if (srcOffset + srcLaneBytes + 16 > srcByteCount || dstOffset + dstLaneBytes + 16 > dstByteCount) {
+                    break;
+                }
+                const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcOffset));
+                const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcOffset + srcLaneBytes));
+                const __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+                const __m256i out = applyMasks_U8_AVX2(block, masks);
+                if constexpr (dstLaneBytes == 16) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dstOffset), out);
+                }
+                else {
+                    // The high lane store overwrites the unused tail of the low lane
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstOffset), _mm256_castsi256_si128(out));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstOffset + dstLaneBytes), _mm256_extracti128_si256(out, 1));
+                }
+            }
+            return i;
+        }
+
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void convertPixels_U8_AVX2(const U8* src, U8* dst, const Size pixelCount, const U8 fillValue) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr U32 srcStride = swizzle.sourceStride;
+            constexpr U32 dstStride = swizzle.targetStride;
+            static constexpr ShuffleTable_U8 table = buildShuffleTable_U8(swizzle);
+            const ShuffleMasks_U8_AVX2 masks = loadShuffleMasks_U8_AVX2(table, fillValue);
+
+            // The 3 and 4 channel formats have dedicated kernels that process 32 bytes per register
+            Size i = 0;
+            if constexpr (srcStride == 4 && dstStride == 4) {
+                i = convert4To4_U8_AVX2(src, dst, pixelCount, masks);
+            }
+            else if constexpr (srcStride == 3 && dstStride == 4) {
+                i = convert3To4_U8_AVX2(src, dst, pixelCount, masks);
+            }
+            else if constexpr (srcStride == 4 && dstStride == 3) {
+                i = convert4To3_U8_AVX2(src, dst, pixelCount, masks);
+            }
+            else if constexpr (srcStride == 3 && dstStride == 3) {
+                i = convert3To3_U8_AVX2(src, dst, pixelCount, masks);
+            }
+            else {
+                i = convertGeneric_U8_AVX2<srcStride, dstStride, getPixelsPerLane_U8(swizzle)>(src, dst, pixelCount, masks);
+            }
+
+            // Scalar tail (handles remaining pixels)
+            convertTail_Scalar(SRC, DST, src + i * srcStride, dst + i * dstStride, pixelCount - i, fillValue);
+        }
+
+        struct KernelFactory_U8_AVX2 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr FormatKernel<U8> get() { return &convertPixels_U8_AVX2<SRC, DST>; }
+        };
+
+        constexpr auto FORMAT_KERNELS_U8_AVX2 = makeFormatKernelTable<FormatKernel<U8>, KernelFactory_U8_AVX2>();
+
+        struct PermutationTable_F32 {
+            std::array<I32, 8> permutation{};
+            std::array<I32, 8> fillMask{}; // MSB set -> take the fill value
+        };
+
+        // The number of pixels per iteration is bounded by both the 8 float load and the 8 float store
+        constexpr Size getPixelsPerVec_F32(const Swizzle& swizzle) {
+            return 8 / std::max(swizzle.sourceStride, swizzle.targetStride);
+        }
+
+        // Output floats past the converted pixels are don't care and are overwritten by the next iteration
+        constexpr PermutationTable_F32 buildPermutationTable_F32(const Swizzle& swizzle) {
+            const Size dstAdvance = getPixelsPerVec_F32(swizzle) * swizzle.targetStride;
+            PermutationTable_F32 table;
+            for (Size i = 0; i < 8; ++i) {
+                table.permutation[i] = static_cast<I32>(i);
+                if (i >= dstAdvance) {
+                    continue;
+                }
+                const Size pixel = i / swizzle.targetStride;
+                const I32 srcChannel = swizzle.channels[i % swizzle.targetStride];
+                if (srcChannel < 0) {
+                    table.fillMask[i] = -1;
+                }
+                else {
+                    table.permutation[i] = static_cast<I32>(pixel * swizzle.sourceStride + static_cast<Size>(srcChannel));
+                }
+            }
+            return table;
+        }
+
+        // Every iteration loads 8 source floats and stores 8 target floats. Unlike _mm256_shuffle_epi8,
+        // _mm256_permutevar8x32_ps moves elements across the 128-bit lanes, so a single permute handles every
+        // stride combination, including the 3 <-> 4 channel expansions and contractions.
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void convertPixels_F32_AVX2(const float* src, float* dst, const Size pixelCount, const float fillValue) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr Size pixelsPerVec = getPixelsPerVec_F32(swizzle);
+            constexpr Size srcAdvance = pixelsPerVec * swizzle.sourceStride;
+            constexpr Size dstAdvance = pixelsPerVec * swizzle.targetStride;
+            static constexpr PermutationTable_F32 table = buildPermutationTable_F32(swizzle);
+
+            const __m256i permutationVec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.permutation.data()));
+            const __m256 fillMaskVec = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.fillMask.data())));
+            const __m256 fillVec = _mm256_set1_ps(fillValue);
+
+            const Size srcCount = pixelCount * swizzle.sourceStride;
+            const Size dstCount = pixelCount * swizzle.targetStride;
+
+            Size i = 0;
+            Size srcOffset = 0;
+            Size dstOffset = 0;
+            // Unrolled twice, both the 8 float load and the 8 float store must stay in range
+            for (; srcOffset + srcAdvance + 8 <= srcCount && dstOffset + dstAdvance + 8 <= dstCount; i += 2 * pixelsPerVec) {
+                const __m256 block0 = _mm256_loadu_ps(src + srcOffset);
+                const __m256 block1 = _mm256_loadu_ps(src + srcOffset + srcAdvance);
+
+                __m256 out0 = _mm256_permutevar8x32_ps(block0, permutationVec);
+                __m256 out1 = _mm256_permutevar8x32_ps(block1, permutationVec);
+                out0 = _mm256_blendv_ps(out0, fillVec, fillMaskVec);
+                out1 = _mm256_blendv_ps(out1, fillVec, fillMaskVec);
+
+                // The second store overwrites the don't care tail of the first one
+                _mm256_storeu_ps(dst + dstOffset, out0);
+                _mm256_storeu_ps(dst + dstOffset + dstAdvance, out1);
+
+                srcOffset += 2 * srcAdvance;
+                dstOffset += 2 * dstAdvance;
+            }
+            for (; srcOffset + 8 <= srcCount && dstOffset + 8 <= dstCount; i += pixelsPerVec) {
+                const __m256 block = _mm256_loadu_ps(src + srcOffset);
+                __m256 out = _mm256_permutevar8x32_ps(block, permutationVec);
+                out = _mm256_blendv_ps(out, fillVec, fillMaskVec);
+                _mm256_storeu_ps(dst + dstOffset, out);
+
+                srcOffset += srcAdvance;
+                dstOffset += dstAdvance;
+            }
+
+            // Scalar tail (handles remaining pixels)
+            convertTail_Scalar(SRC, DST, src + srcOffset, dst + dstOffset, pixelCount - i, fillValue);
+        }
+
+        struct KernelFactory_F32_AVX2 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr FormatKernel<float> get() { return &convertPixels_F32_AVX2<SRC, DST>; }
+        };
+
+        constexpr auto FORMAT_KERNELS_F32_AVX2 = makeFormatKernelTable<FormatKernel<float>, KernelFactory_F32_AVX2>();
+
+        // Same as the SSSE3 kernel, strides that divide the 128-bit lane (1, 2 and 4 channels) use the full register.
+        // The pixels of a 3 channel swizzle cross the lanes, which _mm256_shuffle_epi8 cannot do.
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void swizzlePixelsInPlace_U8_AVX2(U8* data, const Size pixelCount) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr Size advance = (16 / swizzle.targetStride) * swizzle.targetStride;
+            static constexpr std::array<U8, 16> permutation = buildInPlacePermutation<16>(swizzle);
+
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(permutation.data()));
+            const Size count = pixelCount * swizzle.targetStride;
+            Size offset = 0;
+            if constexpr (advance == 16) {
+                const __m256i shuffle256 = _mm256_broadcastsi128_si256(shuffle);
+                for (; offset + 32 <= count; offset += 32) {
+                    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + offset), _mm256_shuffle_epi8(block, shuffle256));
+                }
+            }
+            for (; offset + 16 <= count; offset += advance) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + offset), _mm_shuffle_epi8(block, shuffle));
+            }
+            swizzleTail_Scalar(SRC, DST, data + offset, pixelCount - offset / swizzle.targetStride);
+        }
+
+        struct InPlaceKernelFactory_U8_AVX2 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr InPlaceKernel<U8> get() {
+                if constexpr (getSwizzle(SRC, DST).isPermutation()) {
+                    return &swizzlePixelsInPlace_U8_AVX2<SRC, DST>;
+                }
+                else {
+                    return nullptr;
+                }
+            }
+        };
+
+        constexpr auto IN_PLACE_KERNELS_U8_AVX2 = makeFormatKernelTable<InPlaceKernel<U8>, InPlaceKernelFactory_U8_AVX2>();
+
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void swizzlePixelsInPlace_F32_AVX2(float* data, const Size pixelCount) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr Size advance = (8 / swizzle.targetStride) * swizzle.targetStride;
+            static constexpr std::array<U8, 8> permutation = buildInPlacePermutation<8>(swizzle);
+
+            const __m256i permutationVec = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(permutation.data())));
+            const Size count = pixelCount * swizzle.targetStride;
+            Size offset = 0;
+            for (; offset + 8 <= count; offset += advance) {
+                const __m256 block = _mm256_loadu_ps(data + offset);
+                _mm256_storeu_ps(data + offset, _mm256_permutevar8x32_ps(block, permutationVec));
+            }
+            swizzleTail_Scalar(SRC, DST, data + offset, pixelCount - offset / swizzle.targetStride);
+        }
+
+        struct InPlaceKernelFactory_F32_AVX2 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr InPlaceKernel<float> get() {
+                if constexpr (getSwizzle(SRC, DST).isPermutation()) {
+                    return &swizzlePixelsInPlace_F32_AVX2<SRC, DST>;
+                }
+                else {
+                    return nullptr;
+                }
+            }
+        };
+
+        constexpr auto IN_PLACE_KERNELS_F32_AVX2 = makeFormatKernelTable<InPlaceKernel<float>, InPlaceKernelFactory_F32_AVX2>();
+
+    }
+
+    void convertFormat_U8_AVX2(const VL_CHANNEL_FORMAT sourceFormat, const std::span<const U8> sourceData,
+        const VL_CHANNEL_FORMAT targetFormat, const std::span<U8> targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        dispatchFormatKernel(FORMAT_KERNELS_U8_AVX2, sourceFormat, sourceData, targetFormat, targetData, fillMode);
+    }
+
+    void convertFormat_F32_AVX2(const VL_CHANNEL_FORMAT sourceFormat, const std::span<const float> sourceData,
+        const VL_CHANNEL_FORMAT targetFormat, const std::span<float> targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        dispatchFormatKernel(FORMAT_KERNELS_F32_AVX2, sourceFormat, sourceData, targetFormat, targetData, fillMode);
+    }
+
+
+    void swizzleInPlace_U8_AVX2(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat, const std::span<U8> data) {
+        dispatchInPlaceKernel(IN_PLACE_KERNELS_U8_AVX2, sourceFormat, targetFormat, data);
+    }
+
+    void swizzleInPlace_F32_AVX2(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat, const std::span<float> data) {
+        dispatchInPlaceKernel(IN_PLACE_KERNELS_F32_AVX2, sourceFormat, targetFormat, data);
+    }
+
+}
+
+VL_SIMD_TARGET_END
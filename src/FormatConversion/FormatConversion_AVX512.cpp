@@ -0,0 +1,223 @@
+#include "../Pch.hpp"
+
+#include "FormatConversion.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * AVX-512 kernels, only called if the CPU supports AVX512-F/BW/VL. The byte permutes of the U8 kernels need VBMI on
+ * top, so only they are compiled with it. The wrappers check for VBMI and fall back to AVX2 without it.
+ */
+
+VL_SIMD_TARGET_BEGIN("avx512f,avx512bw,avx512vl")
+
+namespace Velyra::Image {
+
+    namespace {
+
+        // The indices have the width of the elements, so the table loads as a whole vector without widening
+        template<typename T, Size VEC_WIDTH>
+        struct PermutationTable_AVX512 {
+            alignas(64) std::array<T, VEC_WIDTH> permutation{};
+            U64 keepMask = 0; // Bit i is set if element i of a vector is taken from the source, the others are filled
+        };
+
+        // Every vector converts as many pixels as fit in both the load and the store. Unlike the AVX2 byte shuffle,
+        // the AVX-512 permutes move elements across the whole register, so the table covers the full vector.
+        template<Size VEC_WIDTH>
+        constexpr Size getPixelsPerVec_AVX512(const Swizzle& swizzle) {
+            return VEC_WIDTH / std::max(swizzle.sourceStride, swizzle.targetStride);
+        }
+
+        template<typename T, Size VEC_WIDTH>
+        constexpr PermutationTable_AVX512<T, VEC_WIDTH> buildPermutationTable_AVX512(const Swizzle& swizzle) {
+            const Size dstAdvance = getPixelsPerVec_AVX512<VEC_WIDTH>(swizzle) * swizzle.targetStride;
+            PermutationTable_AVX512<T, VEC_WIDTH> table;
+            for (Size i = 0; i < dstAdvance; ++i) {
+                const Size pixel = i / swizzle.targetStride;
+                const I32 srcChannel = swizzle.channels[i % swizzle.targetStride];
+                if (srcChannel >= 0) {
+                    table.keepMask |= U64{1} << i;
+                    table.permutation[i] = static_cast<T>(pixel * swizzle.sourceStride + static_cast<Size>(srcChannel));
+                }
+            }
+            return table;
+        }
+
+        // Mask with the lowest count bits set, count is at most 64
+        constexpr U64 lowBitMask(const Size count) {
+            return count >= 64 ? ~U64{0} : (U64{1} << count) - 1;
+        }
+
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void convertPixels_F32_AVX512(const float* src, float* dst, const Size pixelCount, const float fillValue) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr Size pixelsPerVec = getPixelsPerVec_AVX512<16>(swizzle);
+            constexpr Size srcAdvance = pixelsPerVec * swizzle.sourceStride;
+            constexpr Size dstAdvance = pixelsPerVec * swizzle.targetStride;
+            static constexpr PermutationTable_AVX512<U32, 16> table = buildPermutationTable_AVX512<U32, 16>(swizzle);
+
+            // The masked permute writes the fill value to the other elements in the same instruction
+            const __m512i permutation = _mm512_load_si512(table.permutation.data());
+            const auto keepMask = static_cast<__mmask16>(table.keepMask);
+            const __m512 fill = _mm512_set1_ps(fillValue);
+            constexpr auto loadMask = static_cast<__mmask16>(lowBitMask(srcAdvance));
+            constexpr auto storeMask = static_cast<__mmask16>(lowBitMask(dstAdvance));
+
+            // Masked loads and stores only touch the converted pixels, so there is no over-read and no scalar tail
+            Size i = 0;
+            for (; i + pixelsPerVec <= pixelCount; i += pixelsPerVec) {
+                const __m512 block = _mm512_maskz_loadu_ps(loadMask, src + i * swizzle.sourceStride);
+                const __m512 out = _mm512_mask_permutexvar_ps(fill, keepMask, permutation, block);
+                _mm512_mask_storeu_ps(dst + i * swizzle.targetStride, storeMask, out);
+            }
+            if (i < pixelCount) {
+                const Size remaining = pixelCount - i;
+                const auto tailLoadMask = static_cast<__mmask16>(lowBitMask(remaining * swizzle.sourceStride));
+                const auto tailStoreMask = static_cast<__mmask16>(lowBitMask(remaining * swizzle.targetStride));
+                const __m512 block = _mm512_maskz_loadu_ps(tailLoadMask, src + i * swizzle.sourceStride);
+                const __m512 out = _mm512_mask_permutexvar_ps(fill, keepMask, permutation, block);
+                _mm512_mask_storeu_ps(dst + i * swizzle.targetStride, tailStoreMask, out);
+            }
+        }
+
+        struct KernelFactory_F32_AVX512 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr FormatKernel<float> get() { return &convertPixels_F32_AVX512<SRC, DST>; }
+        };
+
+        constexpr auto FORMAT_KERNELS_F32_AVX512 = makeFormatKernelTable<FormatKernel<float>, KernelFactory_F32_AVX512>();
+
+        // The masked kernels only load and store the pixels they convert and load every vector before storing it,
+        // so they can run with the source and the target pointing to the same pixels
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void swizzlePixelsInPlace_F32_AVX512(float* data, const Size pixelCount) {
+            convertPixels_F32_AVX512<SRC, DST>(data, data, pixelCount, 0.0f);
+        }
+
+        struct InPlaceKernelFactory_F32_AVX512 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr InPlaceKernel<float> get() {
+                if constexpr (getSwizzle(SRC, DST).isPermutation()) {
+                    return &swizzlePixelsInPlace_F32_AVX512<SRC, DST>;
+                }
+                else {
+                    return nullptr;
+                }
+            }
+        };
+
+        constexpr auto IN_PLACE_KERNELS_F32_AVX512 = makeFormatKernelTable<InPlaceKernel<float>, InPlaceKernelFactory_F32_AVX512>();
+
+    }
+
+}
+
+VL_SIMD_TARGET_END
+
+VL_SIMD_TARGET_BEGIN("avx512f,avx512bw,avx512vl,avx512vbmi")
+
+namespace Velyra::Image {
+
+    namespace {
+
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void convertPixels_U8_AVX512(const U8* src, U8* dst, const Size pixelCount, const U8 fillValue) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr Size pixelsPerVec = getPixelsPerVec_AVX512<64>(swizzle);
+            constexpr Size srcAdvance = pixelsPerVec * swizzle.sourceStride;
+            constexpr Size dstAdvance = pixelsPerVec * swizzle.targetStride;
+            static constexpr PermutationTable_AVX512<U8, 64> table = buildPermutationTable_AVX512<U8, 64>(swizzle);
+
+            // The masked permute writes the fill value to the other elements in the same instruction
+            const __m512i permutation = _mm512_load_si512(table.permutation.data());
+            const __mmask64 keepMask = table.keepMask;
+            const __m512i fill = _mm512_set1_epi8(static_cast<char>(fillValue));
+            constexpr __mmask64 loadMask = lowBitMask(srcAdvance);
+            constexpr __mmask64 storeMask = lowBitMask(dstAdvance);
+
+            // Masked loads and stores only touch the converted pixels, so there is no over-read and no scalar tail
+            Size i = 0;
+            for (; i + 2 * pixelsPerVec <= pixelCount; i += 2 * pixelsPerVec) {
+                const __m512i block0 = _mm512_maskz_loadu_epi8(loadMask, src + i * swizzle.sourceStride);
+                const __m512i block1 = _mm512_maskz_loadu_epi8(loadMask, src + i * swizzle.sourceStride + srcAdvance);
+                const __m512i out0 = _mm512_mask_permutexvar_epi8(fill, keepMask, permutation, block0);
+                const __m512i out1 = _mm512_mask_permutexvar_epi8(fill, keepMask, permutation, block1);
+                _mm512_mask_storeu_epi8(dst + i * swizzle.targetStride, storeMask, out0);
+                _mm512_mask_storeu_epi8(dst + i * swizzle.targetStride + dstAdvance, storeMask, out1);
+            }
+            for (; i < pixelCount; i += pixelsPerVec) {
+                const Size count = pixelCount - i < pixelsPerVec ? pixelCount - i : pixelsPerVec;
+                const __mmask64 tailLoadMask = lowBitMask(count * swizzle.sourceStride);
+                const __mmask64 tailStoreMask = lowBitMask(count * swizzle.targetStride);
+                const __m512i block = _mm512_maskz_loadu_epi8(tailLoadMask, src + i * swizzle.sourceStride);
+                const __m512i out = _mm512_mask_permutexvar_epi8(fill, keepMask, permutation, block);
+                _mm512_mask_storeu_epi8(dst + i * swizzle.targetStride, tailStoreMask, out);
+            }
+        }
+
+        struct KernelFactory_U8_AVX512 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr FormatKernel<U8> get() { return &convertPixels_U8_AVX512<SRC, DST>; }
+        };
+
+        constexpr auto FORMAT_KERNELS_U8_AVX512 = makeFormatKernelTable<FormatKernel<U8>, KernelFactory_U8_AVX512>();
+
+        // Runs in place for the same reason as swizzlePixelsInPlace_F32_AVX512
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void swizzlePixelsInPlace_U8_AVX512(U8* data, const Size pixelCount) {
+            convertPixels_U8_AVX512<SRC, DST>(data, data, pixelCount, 0);
+        }
+
+        struct InPlaceKernelFactory_U8_AVX512 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr InPlaceKernel<U8> get() {
+                if constexpr (getSwizzle(SRC, DST).isPermutation()) {
+                    return &swizzlePixelsInPlace_U8_AVX512<SRC, DST>;
+                }
+                else {
+                    return nullptr;
+                }
+            }
+        };
+
+        constexpr auto IN_PLACE_KERNELS_U8_AVX512 = makeFormatKernelTable<InPlaceKernel<U8>, InPlaceKernelFactory_U8_AVX512>();
+
+    }
+
+}
+
+VL_SIMD_TARGET_END
+
+VL_SIMD_TARGET_BEGIN("avx512f,avx512bw,avx512vl")
+
+namespace Velyra::Image {
+
+    void convertFormat_U8_AVX512(const VL_CHANNEL_FORMAT sourceFormat, const std::span<const U8> sourceData,
+        const VL_CHANNEL_FORMAT targetFormat, const std::span<U8> targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        if (getSimdSupport().avx512vbmi) {
+            dispatchFormatKernel(FORMAT_KERNELS_U8_AVX512, sourceFormat, sourceData, targetFormat, targetData, fillMode);
+            return;
+        }
+        convertFormat_U8_AVX2(sourceFormat, sourceData, targetFormat, targetData, fillMode);
+    }
+
+    void convertFormat_F32_AVX512(const VL_CHANNEL_FORMAT sourceFormat, const std::span<const float> sourceData,
+        const VL_CHANNEL_FORMAT targetFormat, const std::span<float> targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        dispatchFormatKernel(FORMAT_KERNELS_F32_AVX512, sourceFormat, sourceData, targetFormat, targetData, fillMode);
+    }
+
+    void swizzleInPlace_U8_AVX512(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat, const std::span<U8> data) {
+        if (getSimdSupport().avx512vbmi) {
+            dispatchInPlaceKernel(IN_PLACE_KERNELS_U8_AVX512, sourceFormat, targetFormat, data);
+            return;
+        }
+        swizzleInPlace_U8_AVX2(sourceFormat, targetFormat, data);
+    }
+
+    void swizzleInPlace_F32_AVX512(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat, const std::span<float> data) {
+        dispatchInPlaceKernel(IN_PLACE_KERNELS_F32_AVX512, sourceFormat, targetFormat, data);
+    }
+
+}
+
+VL_SIMD_TARGET_END
@@ -0,0 +1,217 @@
+#include "../Pch.hpp"
+
+#include "FormatConversion.hpp"
+
+/*
+ * SSE2 kernels, SSE2 is part of the x86-64 baseline so this file needs no extra compile flags.
+ */
+
+namespace Velyra::Image {
+
+    namespace {
+
+        // Moves byte SRC_CHANNEL of every 32-bit pixel to byte DST_CHANNEL, all other bytes become zero
+        template<I32 SRC_CHANNEL, I32 DST_CHANNEL>
+        __m128i moveChannel_U8_SSE2(const __m128i pixels) {
+            const __m128i channel = _mm_and_si128(_mm_srli_epi32(pixels, SRC_CHANNEL * 8), _mm_set1_epi32(0xFF));
+            return _mm_slli_epi32(channel, DST_CHANNEL * 8);
+        }
+
+        // SSE2 has no byte shuffle, 4 -> 4 channel pairs move the channels with 32-bit shifts instead.
+        // Other pairs use the scalar kernel.
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void convertPixels_U8_SSE2(const U8* src, U8* dst, const Size pixelCount, const U8 fillValue) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            Size i = 0;
+            if constexpr (swizzle.sourceStride == 4 && swizzle.targetStride == 4) {
+                U32 fillBits = 0;
+                for (Size c = 0; c < 4; ++c) {
+                    if (swizzle.channels[c] < 0) {
+                        fillBits |= static_cast<U32>(fillValue) << (c * 8);
+                    }
+                }
+                const __m128i fill = _mm_set1_epi32(static_cast<int>(fillBits));
+                for (; i + 4 <= pixelCount; i += 4) {
+                    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                    const __m128i out = [&]<Size... C>(std::index_sequence<C...>) {
+                        __m128i result = fill;
+                        ((result = swizzle.channels[C] < 0 ? result :
+                            _mm_or_si128(result, moveChannel_U8_SSE2<std::max(swizzle.channels[C], 0), static_cast<I32>(C)>(pixels))), ...);
+                        return result;
+                    }(std::make_index_sequence<4>{});
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+                }
+            }
+            convertTail_Scalar(SRC, DST, src + i * swizzle.sourceStride, dst + i * swizzle.targetStride, pixelCount - i, fillValue);
+        }
+
+        struct KernelFactory_U8_SSE2 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr FormatKernel<U8> get() { return &convertPixels_U8_SSE2<SRC, DST>; }
+        };
+
+        constexpr auto FORMAT_KERNELS_U8_SSE2 = makeFormatKernelTable<FormatKernel<U8>, KernelFactory_U8_SSE2>();
+
+        // Loads a single pixel into the low floats of the register. 3 channel pixels are loaded with a 4 float load,
+        // so the caller must guarantee that one more float is readable.
+        template<U32 STRIDE>
+        __m128 loadPixel_F32_SSE2(const float* src) {
+            if constexpr (STRIDE == 1) {
+                return _mm_load_ss(src);
+            }
+            else if constexpr (STRIDE == 2) {
+                return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(src)));
+            }
+            else {
+                return _mm_loadu_ps(src);
+            }
+        }
+
+        // Stores the low floats of the register as a single pixel. 3 channel pixels are stored with a 4 float store,
+        // so the caller must guarantee that one more float is writable and is overwritten afterwards.
+        template<U32 STRIDE>
+        void storePixel_F32_SSE2(float* dst, const __m128 pixel) {
+            if constexpr (STRIDE == 1) {
+                _mm_store_ss(dst, pixel);
+            }
+            else if constexpr (STRIDE == 2) {
+                _mm_storel_pi(reinterpret_cast<__m64*>(dst), pixel);
+            }
+            else {
+                _mm_storeu_ps(dst, pixel);
+            }
+        }
+
+        constexpr int buildShuffleImmediate_F32(const Swizzle& swizzle) {
+            int immediate = 0;
+            for (U32 c = 0; c < 4; ++c) {
+                const I32 srcChannel = c < swizzle.targetStride ? swizzle.channels[c] : -1;
+                immediate |= std::max(srcChannel, 0) << (c * 2);
+            }
+            return immediate;
+        }
+
+        // One pixel per register: a pixel has at most 4 floats, so _mm_shuffle_ps handles every pair
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void convertPixels_F32_SSE2(const float* src, float* dst, const Size pixelCount, const float fillValue) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr U32 srcStride = swizzle.sourceStride;
+            constexpr U32 dstStride = swizzle.targetStride;
+            constexpr int shuffleImmediate = buildShuffleImmediate_F32(swizzle);
+
+            alignas(16) std::array<float, 4> fillValues{};
+            alignas(16) std::array<I32, 4> keepMask{};
+            for (U32 c = 0; c < 4; ++c) {
+                const bool isFilled = c < dstStride && swizzle.channels[c] < 0;
+                fillValues[c] = isFilled ? fillValue : 0.0f;
+                keepMask[c] = isFilled ? 0 : -1;
+            }
+            const __m128 fill = _mm_load_ps(fillValues.data());
+            const __m128 keep = _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(keepMask.data())));
+
+            // The 3 channel loads and stores touch one float past the pixel, so the last pixel is left to the scalar tail
+            constexpr Size reserved = (srcStride == 3 || dstStride == 3) ? 1 : 0;
+            Size i = 0;
+            for (; i + reserved < pixelCount; ++i) {
+                const __m128 pixel = loadPixel_F32_SSE2<srcStride>(src + i * srcStride);
+                const __m128 shuffled = _mm_shuffle_ps(pixel, pixel, shuffleImmediate);
+                storePixel_F32_SSE2<dstStride>(dst + i * dstStride, _mm_or_ps(_mm_and_ps(shuffled, keep), fill));
+            }
+
+            convertTail_Scalar(SRC, DST, src + i * srcStride, dst + i * dstStride, pixelCount - i, fillValue);
+        }
+
+        struct KernelFactory_F32_SSE2 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr FormatKernel<float> get() { return &convertPixels_F32_SSE2<SRC, DST>; }
+        };
+
+        constexpr auto FORMAT_KERNELS_F32_SSE2 = makeFormatKernelTable<FormatKernel<float>, KernelFactory_F32_SSE2>();
+
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void swizzlePixelsInPlace_U8_SSE2(U8* data, const Size pixelCount) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            Size i = 0;
+            if constexpr (swizzle.targetStride == 4) {
+                for (; i + 4 <= pixelCount; i += 4) {
+                    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4));
+                    const __m128i out = [&]<Size... C>(std::index_sequence<C...>) {
+                        __m128i result = _mm_setzero_si128();
+                        ((result = _mm_or_si128(result, moveChannel_U8_SSE2<swizzle.channels[C], static_cast<I32>(C)>(pixels))), ...);
+                        return result;
+                    }(std::make_index_sequence<4>{});
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 4), out);
+                }
+            }
+            swizzleTail_Scalar(SRC, DST, data + i * swizzle.targetStride, pixelCount - i);
+        }
+
+        struct InPlaceKernelFactory_U8_SSE2 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr InPlaceKernel<U8> get() {
+                if constexpr (getSwizzle(SRC, DST).isPermutation()) {
+                    return &swizzlePixelsInPlace_U8_SSE2<SRC, DST>;
+                }
+                else {
+                    return nullptr;
+                }
+            }
+        };
+
+        constexpr auto IN_PLACE_KERNELS_U8_SSE2 = makeFormatKernelTable<InPlaceKernel<U8>, InPlaceKernelFactory_U8_SSE2>();
+
+        // One pixel per register, a 3 channel pixel is loaded together with the first float of the next pixel,
+        // which is written back unchanged
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void swizzlePixelsInPlace_F32_SSE2(float* data, const Size pixelCount) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr U32 stride = swizzle.targetStride;
+            Size i = 0;
+            if constexpr (stride >= 3) {
+                constexpr std::array<U8, 4> permutation = buildInPlacePermutation<4>(swizzle);
+                constexpr int shuffleImmediate = permutation[0] | permutation[1] << 2 | permutation[2] << 4 | permutation[3] << 6;
+                constexpr Size reserved = stride == 3 ? 1 : 0;
+                for (; i + reserved < pixelCount; ++i) {
+                    const __m128 pixel = _mm_loadu_ps(data + i * stride);
+                    _mm_storeu_ps(data + i * stride, _mm_shuffle_ps(pixel, pixel, shuffleImmediate));
+                }
+            }
+            swizzleTail_Scalar(SRC, DST, data + i * stride, pixelCount - i);
+        }
+
+        struct InPlaceKernelFactory_F32_SSE2 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr InPlaceKernel<float> get() {
+                if constexpr (getSwizzle(SRC, DST).isPermutation()) {
+                    return &swizzlePixelsInPlace_F32_SSE2<SRC, DST>;
+                }
+                else {
+                    return nullptr;
+                }
+            }
+        };
+
+        constexpr auto IN_PLACE_KERNELS_F32_SSE2 = makeFormatKernelTable<InPlaceKernel<float>, InPlaceKernelFactory_F32_SSE2>();
+
+    }
+
+    void convertFormat_U8_SSE2(const VL_CHANNEL_FORMAT sourceFormat, const std::span<const U8> sourceData,
+        const VL_CHANNEL_FORMAT targetFormat, const std::span<U8> targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        dispatchFormatKernel(FORMAT_KERNELS_U8_SSE2, sourceFormat, sourceData, targetFormat, targetData, fillMode);
+    }
+
+    void convertFormat_F32_SSE2(const VL_CHANNEL_FORMAT sourceFormat, const std::span<const float> sourceData,
+        const VL_CHANNEL_FORMAT targetFormat, const std::span<float> targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        dispatchFormatKernel(FORMAT_KERNELS_F32_SSE2, sourceFormat, sourceData, targetFormat, targetData, fillMode);
+    }
+
+
+    void swizzleInPlace_U8_SSE2(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat, const std::span<U8> data) {
+        dispatchInPlaceKernel(IN_PLACE_KERNELS_U8_SSE2, sourceFormat, targetFormat, data);
+    }
+
+    void swizzleInPlace_F32_SSE2(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat, const std::span<float> data) {
+        dispatchInPlaceKernel(IN_PLACE_KERNELS_F32_SSE2, sourceFormat, targetFormat, data);
+    }
+
+}
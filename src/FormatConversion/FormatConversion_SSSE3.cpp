@@ -0,0 +1,113 @@
+#include "../Pch.hpp"
+
+#include "FormatConversion.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * SSSE3 kernels, compiled with SSSE3 enabled and only called if the CPU supports it.
+ */
+
+VL_SIMD_TARGET_BEGIN("ssse3")
+
+namespace Velyra::Image {
+
+    namespace {
+
+        // 128-bit version of the AVX2 kernels, uses the low lane of the shuffle table
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void convertPixels_U8_SSSE3(const U8* src, U8* dst, const Size pixelCount, const U8 fillValue) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr Size pixelsPerVec = getPixelsPerLane_U8(swizzle);
+            constexpr Size srcAdvance = pixelsPerVec * swizzle.sourceStride;
+            constexpr Size dstAdvance = pixelsPerVec * swizzle.targetStride;
+            static constexpr ShuffleTable_U8 table = buildShuffleTable_U8(swizzle);
+
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.shuffle.data()));
+            const __m128i fillPositions = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.fillPositions.data()));
+            const __m128i fill = _mm_and_si128(fillPositions, _mm_set1_epi8(static_cast<char>(fillValue)));
+
+            const Size srcCount = pixelCount * swizzle.sourceStride;
+            const Size dstCount = pixelCount * swizzle.targetStride;
+
+            Size i = 0;
+            Size srcOffset = 0;
+            Size dstOffset = 0;
+            // Unrolled twice, both the 16 byte load and the 16 byte store must stay in range
+            for (; srcOffset + srcAdvance + 16 <= srcCount && dstOffset + dstAdvance + 16 <= dstCount; i += 2 * pixelsPerVec) {
+                const __m128i block0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcOffset));
+                const __m128i block1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcOffset + srcAdvance));
+                const __m128i out0 = _mm_or_si128(_mm_shuffle_epi8(block0, shuffle), fill);
+                const __m128i out1 = _mm_or_si128(_mm_shuffle_epi8(block1, shuffle), fill);
+
+                // The second store overwrites the unused tail of the first one
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstOffset), out0);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstOffset + dstAdvance), out1);
+
+                srcOffset += 2 * srcAdvance;
+                dstOffset += 2 * dstAdvance;
+            }
+            for (; srcOffset + 16 <= srcCount && dstOffset + 16 <= dstCount; i += pixelsPerVec) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcOffset));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstOffset), _mm_or_si128(_mm_shuffle_epi8(block, shuffle), fill));
+
+                srcOffset += srcAdvance;
+                dstOffset += dstAdvance;
+            }
+
+            // Scalar tail (handles remaining pixels)
+            convertTail_Scalar(SRC, DST, src + srcOffset, dst + dstOffset, pixelCount - i, fillValue);
+        }
+
+        struct KernelFactory_U8_SSSE3 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr FormatKernel<U8> get() { return &convertPixels_U8_SSSE3<SRC, DST>; }
+        };
+
+        constexpr auto FORMAT_KERNELS_U8_SSSE3 = makeFormatKernelTable<FormatKernel<U8>, KernelFactory_U8_SSSE3>();
+
+        // Every vector reorders the whole pixels it contains (5 for 3 channels) and writes the rest back unchanged
+        template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+        void swizzlePixelsInPlace_U8_SSSE3(U8* data, const Size pixelCount) {
+            constexpr Swizzle swizzle = getSwizzle(SRC, DST);
+            constexpr Size advance = (16 / swizzle.targetStride) * swizzle.targetStride;
+            static constexpr std::array<U8, 16> permutation = buildInPlacePermutation<16>(swizzle);
+
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(permutation.data()));
+            const Size count = pixelCount * swizzle.targetStride;
+            Size offset = 0;
+            for (; offset + 16 <= count; offset += advance) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + offset), _mm_shuffle_epi8(block, shuffle));
+            }
+            swizzleTail_Scalar(SRC, DST, data + offset, pixelCount - offset / swizzle.targetStride);
+        }
+
+        struct InPlaceKernelFactory_U8_SSSE3 {
+            template<VL_CHANNEL_FORMAT SRC, VL_CHANNEL_FORMAT DST>
+            static constexpr InPlaceKernel<U8> get() {
+                if constexpr (getSwizzle(SRC, DST).isPermutation()) {
+                    return &swizzlePixelsInPlace_U8_SSSE3<SRC, DST>;
+                }
+                else {
+                    return nullptr;
+                }
+            }
+        };
+
+        constexpr auto IN_PLACE_KERNELS_U8_SSSE3 = makeFormatKernelTable<InPlaceKernel<U8>, InPlaceKernelFactory_U8_SSSE3>();
+
+    }
+
+    void convertFormat_U8_SSSE3(const VL_CHANNEL_FORMAT sourceFormat, const std::span<const U8> sourceData,
+        const VL_CHANNEL_FORMAT targetFormat, const std::span<U8> targetData, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        dispatchFormatKernel(FORMAT_KERNELS_U8_SSSE3, sourceFormat, sourceData, targetFormat, targetData, fillMode);
+    }
+
+
+    void swizzleInPlace_U8_SSSE3(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat, const std::span<U8> data) {
+        dispatchInPlaceKernel(IN_PLACE_KERNELS_U8_SSSE3, sourceFormat, targetFormat, data);
+    }
+
+}
+
+VL_SIMD_TARGET_END
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include <VelyraImage/ImageDefs.hpp>
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Describes how to build a pixel of the target format from a pixel of the source format.
+     *        channels[i] is the index of the source channel that is written to target channel i, or -1 if the target
+     *        channel is not present in the source and should be filled. Entries past targetStride are unused.
+     */
+    struct Swizzle {
+        std::array<I32, 4> channels = {-1, -1, -1, -1};
+        U32 sourceStride = 0;
+        U32 targetStride = 0;
+
+        constexpr bool isValid() const { return sourceStride != 0 && targetStride != 0; }
+
+        // True if the target channels are a reordering of the source channels, so the conversion can run in place
+        constexpr bool isPermutation() const {
+            if (!isValid() || sourceStride != targetStride) {
+                return false;
+            }
+            for (U32 i = 0; i < targetStride; ++i) {
+                if (channels[i] < 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // Lookup tables are indexed directly with VL_CHANNEL_FORMAT values, index 0 is unused
+    inline constexpr Size CHANNEL_FORMAT_TABLE_SIZE = static_cast<Size>(VL_CHANNEL_BGRA) + 1;
+
+    namespace Detail {
+
+        struct ChannelLayout {
+            std::array<I32, 4> channels = {}; // R = 0, G = 1, B = 2, A = 3
+            U32 count = 0;
+        };
+
+        constexpr ChannelLayout getChannelLayout(const VL_CHANNEL_FORMAT format) {
+            switch (format) {
+                case VL_CHANNEL_R:    return {{0}, 1};
+                case VL_CHANNEL_RG:   return {{0, 1}, 2};
+                case VL_CHANNEL_RGB:  return {{0, 1, 2}, 3};
+                case VL_CHANNEL_RGBA: return {{0, 1, 2, 3}, 4};
+                case VL_CHANNEL_BGR:  return {{2, 1, 0}, 3};
+                case VL_CHANNEL_BGRA: return {{2, 1, 0, 3}, 4};
+                default:              return {};
+            }
+        }
+
+        constexpr Swizzle buildSwizzle(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat) {
+            const ChannelLayout source = getChannelLayout(sourceFormat);
+            const ChannelLayout target = getChannelLayout(targetFormat);
+            Swizzle swizzle;
+            if (source.count == 0 || target.count == 0) {
+                return swizzle;
+            }
+            swizzle.sourceStride = source.count;
+            swizzle.targetStride = target.count;
+            for (U32 i = 0; i < target.count; ++i) {
+                for (U32 j = 0; j < source.count; ++j) {
+                    if (source.channels[j] == target.channels[i]) {
+                        swizzle.channels[i] = static_cast<I32>(j);
+                        break;
+                    }
+                }
+            }
+            return swizzle;
+        }
+
+    }
+
+    inline constexpr auto SWIZZLE_TABLE = [] {
+        std::array<std::array<Swizzle, CHANNEL_FORMAT_TABLE_SIZE>, CHANNEL_FORMAT_TABLE_SIZE> table{};
+        for (Size src = 0; src < CHANNEL_FORMAT_TABLE_SIZE; ++src) {
+            for (Size dst = 0; dst < CHANNEL_FORMAT_TABLE_SIZE; ++dst) {
+                table[src][dst] = Detail::buildSwizzle(static_cast<VL_CHANNEL_FORMAT>(src), static_cast<VL_CHANNEL_FORMAT>(dst));
+            }
+        }
+        return table;
+    }();
+
+    /**
+     * @brief Returns the swizzle to convert sourceFormat to targetFormat, the swizzle is invalid for unknown formats.
+     */
+    constexpr Swizzle getSwizzle(const VL_CHANNEL_FORMAT sourceFormat, const VL_CHANNEL_FORMAT targetFormat) {
+        const auto src = static_cast<Size>(sourceFormat);
+        const auto dst = static_cast<Size>(targetFormat);
+        if (src >= CHANNEL_FORMAT_TABLE_SIZE || dst >= CHANNEL_FORMAT_TABLE_SIZE) {
+            return {};
+        }
+        return SWIZZLE_TABLE[src][dst];
+    }
+
+    template<typename Kernel>
+    using FormatKernelTable = std::array<std::array<Kernel, CHANNEL_FORMAT_TABLE_SIZE>, CHANNEL_FORMAT_TABLE_SIZE>;
+
+    /**
+     * @brief Builds a table of function pointers indexed by [sourceFormat][targetFormat], where every entry is a
+     *        separate instantiation of KernelFactory::template get<SRC, DST>(). Entries for unknown formats are nullptr.
+     */
+    template<typename Kernel, typename KernelFactory>
+    constexpr auto makeFormatKernelTable() {
+        return []<Size... I>(std::index_sequence<I...>) {
+            FormatKernelTable<Kernel> table{};
+            ((table[I / CHANNEL_FORMAT_TABLE_SIZE][I % CHANNEL_FORMAT_TABLE_SIZE] = [] {
+                constexpr auto src = static_cast<VL_CHANNEL_FORMAT>(I / CHANNEL_FORMAT_TABLE_SIZE);
+                constexpr auto dst = static_cast<VL_CHANNEL_FORMAT>(I % CHANNEL_FORMAT_TABLE_SIZE);
+                if constexpr (getSwizzle(src, dst).isValid()) {
+                    return static_cast<Kernel>(KernelFactory::template get<src, dst>());
+                }
+                else {
+                    return static_cast<Kernel>(nullptr);
+                }
+            }()), ...);
+            return table;
+        }(std::make_index_sequence<CHANNEL_FORMAT_TABLE_SIZE * CHANNEL_FORMAT_TABLE_SIZE>{});
+    }
+
+    /*
+     * Byte shuffle tables of the SSSE3 and AVX2 U8 kernels
+     */
+
+    struct ShuffleTable_U8 {
+        std::array<U8, 32> shuffle{};
+        std::array<U8, 32> fillPositions{}; // 0xFF at the fill positions, the fill value is only known at runtime
+    };
+
+    // The 3 and 4 channel formats convert 4 pixels per lane, the others as many as fit in a 16 byte load and store
+    constexpr Size getPixelsPerLane_U8(const Swizzle& swizzle) {
+        if (swizzle.sourceStride >= 3 && swizzle.targetStride >= 3) {
+            return 4;
+        }
+        return std::min<Size>(16 / swizzle.sourceStride, 16 / swizzle.targetStride);
+    }
+
+    /**
+     * Builds the masks to convert pixelsPerLane pixels within every 128-bit lane. Both lanes use the same mask,
+     * the source pixels are expected at the start of each lane and the target pixels are written to the start of
+     * each lane. Target bytes past pixelsPerLane pixels are zero.
+     */
+    constexpr ShuffleTable_U8 buildShuffleTable_U8(const Swizzle& swizzle) {
+        const Size pixelsPerLane = getPixelsPerLane_U8(swizzle);
+        ShuffleTable_U8 table;
+        for (Size lane = 0; lane < 2; ++lane) {
+            for (Size i = 0; i < 16; ++i) {
+                const Size outIndex = lane * 16 + i;
+                const Size pixel = i / swizzle.targetStride;
+                const I32 srcChannel = swizzle.channels[i % swizzle.targetStride];
+                if (pixel >= pixelsPerLane) {
+                    table.shuffle[outIndex] = 0x80;
+                }
+                else if (srcChannel < 0) {
+                    table.shuffle[outIndex] = 0x80;
+                    table.fillPositions[outIndex] = 0xFF;
+                }
+                else {
+                    // Shuffle indices are relative to the lane, so the lane offset is not added
+                    table.shuffle[outIndex] = static_cast<U8>(pixel * swizzle.sourceStride + static_cast<Size>(srcChannel));
+                }
+            }
+        }
+        return table;
+    }
+
+    /**
+     * Builds the element indices to reorder a vector of VEC_WIDTH elements in place, for swizzles that are a
+     * permutation. The first VEC_WIDTH / stride pixels are reordered, the elements behind them keep their position,
+     * so writing the vector back leaves the following (not yet converted) pixels untouched.
+     */
+    template<Size VEC_WIDTH>
+    constexpr std::array<U8, VEC_WIDTH> buildInPlacePermutation(const Swizzle& swizzle) {
+        const Size convertedCount = (VEC_WIDTH / swizzle.targetStride) * swizzle.targetStride;
+        std::array<U8, VEC_WIDTH> permutation{};
+        for (Size i = 0; i < VEC_WIDTH; ++i) {
+            if (i < convertedCount) {
+                const Size pixelStart = i - i % swizzle.targetStride;
+                permutation[i] = static_cast<U8>(pixelStart + static_cast<Size>(swizzle.channels[i % swizzle.targetStride]));
+            }
+            else {
+                permutation[i] = static_cast<U8>(i);
+            }
+        }
+        return permutation;
+    }
+
+}
@@ -3,6 +3,11 @@
 #include <VelyraImage/IImage.hpp>
 
 #include "FormatConversion/FormatConversion.hpp"
+#include "Transform/Transform.hpp"
+#include "Flip/Flip.hpp"
+#include "PixelBuffer.hpp"
+#include "LoggerNames.hpp"
+#include "Metrics.hpp"
 
 namespace Velyra::Image {
 
@@ -19,11 +24,15 @@ namespace Velyra::Image {
         return getCount() * typeSize;
     }
 
+    void IImage::flipVertical(const FlipDesc& desc) {
+        const Size rowBytes = m_Width * getChannelCountFromFormat(m_Format) * Utils::getTypeSize(m_DataType);
+        flipRowsInPlace({static_cast<U8*>(getData()), getSize()}, rowBytes, desc.simdMode, desc.executionPolicy);
+    }
 
     IImage::IImage(const VL_TYPE type, const char* loggerName):
     m_DataType(type),
-    m_Logger(Utils::getLogger(loggerName)) {
-
+    m_Logger(getCachedLogger(loggerName)) {
+        recordImageCreated();
     }
 
     IImage::IImage(const Size width, const Size height, const VL_TYPE type, const VL_CHANNEL_FORMAT format, const char* loggerName):
@@ -31,40 +40,51 @@ namespace Velyra::Image {
     m_Height(height),
     m_DataType(type),
     m_Format(format),
-    m_Logger(Utils::getLogger(loggerName)) {
-
+    m_Logger(getCachedLogger(loggerName)) {
+        recordImageCreated();
     }
 
     template<typename T>
-    void IImage::setData(const ImageLoadDesc& desc, const T* loadedData, const I32 loadedWidth, const I32 loadedHeight, I32 loadedChannels,
-        std::vector<T>& destinationData) {
+    void IImage::setData(const ImageLoadDesc& desc, T* loadedData, const I32 loadedWidth, const I32 loadedHeight, I32 loadedChannels,
+        PixelBuffer<T>& destinationData) {
+        // Owns the decoder's buffer until it is adopted, so it is also released if the conversion throws
+        std::unique_ptr<T, decltype(&stbi_image_free)> ownedData(loadedData, &stbi_image_free);
         m_Width = static_cast<Size>(loadedWidth);
         m_Height = static_cast<Size>(loadedHeight);
         const VL_CHANNEL_FORMAT loadedFormat = getChannelFormatFromCount(static_cast<U32>(loadedChannels));
 
         if (loadedFormat != desc.requestedFormat && desc.requestedFormat != VL_CHANNEL_FORMAT_MAX_VALUE) {
-            SPDLOG_LOGGER_INFO(m_Logger, "Image: {} loaded with {} channels, converting to requested format {}", desc.fileName.string(), loadedChannels, desc.requestedFormat);
+            VL_IMAGE_LOG_HOT_PATH(m_Logger, "Image: {} loaded with {} channels, converting to requested format {}", desc.fileName.string(), loadedChannels, desc.requestedFormat);
             m_Format = desc.requestedFormat;
 
             const std::span<const T> sourceView(loadedData, m_Width * m_Height * static_cast<Size>(loadedChannels));
 
             destinationData.resize(m_Width * m_Height * getChannelCountFromFormat(desc.requestedFormat));
 
-            FormatConversionDesc conversionDesc;
-            conversionDesc.targetFormat = desc.requestedFormat;
-            conversionDesc.fillMode = desc.fillMode;
-            convertFormat<T>(loadedFormat, sourceView, destinationData, conversionDesc);
+            // The decoder does not flip, the conversion writes the rows in flipped order instead
+            TransformDesc transformDesc;
+            transformDesc.targetFormat = desc.requestedFormat;
+            transformDesc.fillMode = desc.fillMode;
+            transformDesc.flipVertical = desc.flipOnLoad;
+            transformPixels<T, T>(loadedFormat, m_Width, m_Height, sourceView, destinationData, transformDesc);
         }
         else {
+            // Either no specific format was requested or the decoder already produced it, adopt the decoder's buffer without copying
             m_Format = loadedFormat;
-            destinationData.resize(m_Width * m_Height * static_cast<U32>(loadedChannels));
-            memcpy(destinationData.data(), loadedData, m_Width * m_Height * static_cast<U32>(loadedChannels) * sizeof(T));
+            destinationData = PixelBuffer<T>::adopt(ownedData.release(), m_Width * m_Height * static_cast<Size>(loadedChannels), [](T* pixels) {
+                stbi_image_free(pixels);
+            });
+            if (desc.flipOnLoad) {
+                flipVertical();
+            }
         }
     }
 
-    template void IImage::setData<U8>(const ImageLoadDesc& desc, const U8* loadedData, const I32 loadedWidth, const I32 loadedHeight, I32 loadedChannels,
-        std::vector<U8>& destinationData);
-    template void IImage::setData<float>(const ImageLoadDesc& desc, const float* loadedData, const I32 loadedWidth, const I32 loadedHeight, I32 loadedChannels,
-        std::vector<float>& destinationData);
+    template void IImage::setData<U8>(const ImageLoadDesc& desc, U8* loadedData, const I32 loadedWidth, const I32 loadedHeight, I32 loadedChannels,
+        PixelBuffer<U8>& destinationData);
+    template void IImage::setData<U16>(const ImageLoadDesc& desc, U16* loadedData, const I32 loadedWidth, const I32 loadedHeight, I32 loadedChannels,
+        PixelBuffer<U16>& destinationData);
+    template void IImage::setData<float>(const ImageLoadDesc& desc, float* loadedData, const I32 loadedWidth, const I32 loadedHeight, I32 loadedChannels,
+        PixelBuffer<float>& destinationData);
 
 }
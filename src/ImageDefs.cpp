@@ -1,5 +1,7 @@
 #include <VelyraImage/ImageDefs.hpp>
 
+#include <bit>
+
 namespace Velyra::Image {
 
     U32 getChannelCountFromFormat(const VL_CHANNEL_FORMAT format) {
@@ -24,5 +26,44 @@ namespace Velyra::Image {
         }
     }
 
+    float f16ToFloat(const F16 value) {
+        const U32 sign = static_cast<U32>(value.bits & 0x8000) << 16;
+        const U32 exponent = (value.bits >> 10) & 0x1F;
+        const U32 mantissa = value.bits & 0x3FF;
+        if (exponent == 0x1F) {
+            // Infinity or NaN, NaNs are made quiet like vcvtph2ps does
+            return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13) | (mantissa != 0 ? 0x400000 : 0));
+        }
+        if (exponent == 0) {
+            // Zero or subnormal, mantissa * 2^-24 is exact in float
+            return std::bit_cast<float>(sign | std::bit_cast<U32>(static_cast<float>(mantissa) * 0x1p-24f));
+        }
+        // Rebias the exponent from 15 to 127
+        return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+
+    F16 floatToF16(const float value) {
+        U32 bits = std::bit_cast<U32>(value);
+        const auto sign = static_cast<U16>((bits >> 16) & 0x8000);
+        bits &= 0x7FFFFFFF;
+        if (bits >= 0x7F800000) {
+            // Infinity or NaN, NaNs keep the upper mantissa bits and are made quiet
+            return {static_cast<U16>(sign | 0x7C00 | (bits > 0x7F800000 ? 0x200 | ((bits >> 13) & 0x3FF) : 0))};
+        }
+        if (bits >= 0x477FF000) {
+            // Rounds to a value above 65504, the largest half
+            return {static_cast<U16>(sign | 0x7C00)};
+        }
+        if (bits < 0x38800000) {
+            // Below the smallest normal half. Adding 0.5 moves the value to a float whose last mantissa bit is 2^-24,
+            // the ulp of half subnormals, so the float addition does the rounding
+            const float shifted = std::bit_cast<float>(bits) + 0.5f;
+            return {static_cast<U16>(sign | (std::bit_cast<U32>(shifted) - std::bit_cast<U32>(0.5f)))};
+        }
+        // Rebias the exponent from 127 to 15 and round the 13 dropped mantissa bits to nearest, ties to even
+        const U32 mantissaOdd = (bits >> 13) & 1;
+        bits += 0xC8000FFF + mantissaOdd;
+        return {static_cast<U16>(sign | (bits >> 13))};
+    }
 
 }
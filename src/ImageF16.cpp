@@ -0,0 +1,208 @@
+#include "Pch.hpp"
+
+#include "ImageF16.hpp"
+#include "Metrics.hpp"
+#include "ImageU8.hpp"
+#include "ImageF32.hpp"
+#include "ImageUtils.hpp"
+#include "ImageSource.hpp"
+#include "DataTypeConversion/DataTypeConversion.hpp"
+#include "FormatConversion/FormatConversion.hpp"
+#include "Transform/Transform.hpp"
+
+namespace Velyra::Image {
+
+    ImageF16::ImageF16(const ImageLoadDesc &desc):
+    ImageF16(ImageSource(desc.fileName, desc.loadMode), desc) {
+
+    }
+
+    ImageF16::ImageF16(const ImageSource &source, const ImageLoadDesc &desc):
+    IImage(VL_FLOAT16, LOGGER_F16) {
+        if (!source.isValid()) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} could not be opened", desc.fileName.string());
+            return;
+        }
+        I32 channelCount = 0;
+        I32 width = 0;
+        I32 height = 0;
+        float* pData = source.decode<float>(desc, width, height, channelCount);
+        if (!pData) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to load: {}", desc.fileName.string(), stbi_failure_reason());
+            return;
+        }
+
+        // Released when leaving the constructor, also if the translation throws
+        const std::unique_ptr<float, decltype(&stbi_image_free)> ownedData(pData, &stbi_image_free);
+        m_Width = static_cast<Size>(width);
+        m_Height = static_cast<Size>(height);
+        const VL_CHANNEL_FORMAT loadedFormat = getChannelFormatFromCount(static_cast<U32>(channelCount));
+        m_Format = desc.requestedFormat != VL_CHANNEL_FORMAT_MAX_VALUE ? desc.requestedFormat : loadedFormat;
+
+        // The decoder does not flip, the translation writes the rows in flipped order instead
+        TransformDesc transformDesc;
+        transformDesc.targetFormat = m_Format;
+        transformDesc.fillMode = desc.fillMode;
+        transformDesc.targetType = VL_FLOAT16;
+        transformDesc.flipVertical = desc.flipOnLoad;
+        const std::span<const float> sourceView(pData, m_Width * m_Height * static_cast<Size>(channelCount));
+        m_Data = PixelBuffer<F16>(m_Width * m_Height * getChannelCountFromFormat(m_Format), UNINITIALIZED);
+        transformPixels<float, F16>(loadedFormat, m_Width, m_Height, sourceView, m_Data, transformDesc);
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Loaded ImageF16: {} with size ({}x{}) and format {}", desc.fileName.string(), m_Width, m_Height, m_Format);
+    }
+
+    ImageF16::ImageF16(const ImageF16Desc &desc):
+    IImage(desc.width, desc.height, VL_FLOAT16, desc.format, LOGGER_F16),
+    m_Data(desc.data != nullptr ?
+        PixelBuffer<F16>(desc.data, desc.width * desc.height * getChannelCountFromFormat(desc.format)) :
+        PixelBuffer<F16>(desc.width * desc.height * getChannelCountFromFormat(desc.format), desc.defaultChannelValue)) {
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Created ImageF16 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
+    }
+
+    ImageF16::ImageF16(const Size width, const Size height, const VL_CHANNEL_FORMAT format, UninitializedTag):
+    IImage(width, height, VL_FLOAT16, format, LOGGER_F16),
+    m_Data(width * height * getChannelCountFromFormat(format), UNINITIALIZED) {
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Created uninitialized ImageF16 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
+    }
+
+    void ImageF16::write(const ImageWriteDesc &desc) const {
+        if (desc.fileType != VL_IMAGE_HDR) {
+            SPDLOG_LOGGER_WARN(m_Logger, "ImageF16 can only be written to HDR format. Image: {} will not be written", desc.fileName.string());
+            return;
+        }
+        const ScopedOperationMetrics metrics(VL_OPERATION_WRITE, VL_SIMD_BEST, getSize());
+        // stb_image_write only takes floats
+        TranslationDesc translationDesc;
+        translationDesc.targetType = VL_FLOAT32;
+        translateDataType(translationDesc)->write(desc);
+    }
+
+    UP<IImage> ImageF16::resize(const Size width, const Size height) const {
+        if (width == 0 || height == 0) {
+            SPDLOG_LOGGER_WARN(m_Logger, "Image cannot be resized to ({}x{})", width, height);
+
+            // Simply return a copy of the current image
+            ImageF16Desc desc;
+            desc.width = m_Width;
+            desc.height = m_Height;
+            desc.format = m_Format;
+            desc.data = m_Data.data();
+            return createUP<ImageF16>(desc);
+        }
+
+        // Every pixel is written by the resize
+        auto resizedImage = createUP<ImageF16>(width, height, m_Format, UNINITIALIZED);
+        if (!resizePixels(m_Data.data(), m_Width, m_Height, resizedImage->getData(), width, height, m_Format, STBIR_TYPE_HALF_FLOAT)) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Failed to resize ImageF16 from ({}x{}) to ({}x{})", m_Width, m_Height, width, height);
+        }
+        return resizedImage;
+    }
+
+    void* ImageF16::getData() {
+        return m_Data.data();
+    }
+
+    const void* ImageF16::getData() const {
+        return m_Data.data();
+    }
+
+    UP<IImage> ImageF16::convertToFormat(const FormatConversionDesc &desc) const {
+        auto targetImage = createUP<ImageF16>(m_Width, m_Height, desc.targetFormat, UNINITIALIZED);
+        if (desc.flipVertical) {
+            // The rows are written in flipped order, the conversion works row by row instead of on the whole buffer
+            transformPixels<F16, F16>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, getTransformDesc(desc));
+        }
+        else {
+            convertFormat<F16>(m_Format, m_Data, targetImage->m_Data, desc);
+        }
+        return targetImage;
+    }
+
+    void ImageF16::convertToFormatInPlace(const FormatConversionDesc& desc) {
+        if (getChannelCountFromFormat(desc.targetFormat) == getChannelCountFromFormat(m_Format)) {
+            convertFormatInPlace<F16>(m_Format, m_Data, desc);
+            m_Format = desc.targetFormat;
+            if (desc.flipVertical) {
+                flipVertical({desc.simdMode, desc.executionPolicy});
+            }
+        }
+        else {
+            PixelBuffer<F16> targetData(getPixelCount() * getChannelCountFromFormat(desc.targetFormat), UNINITIALIZED);
+            transformPixels<F16, F16>(m_Format, m_Width, m_Height, m_Data, targetData, getTransformDesc(desc));
+            m_Data = std::move(targetData);
+            m_Format = desc.targetFormat;
+        }
+    }
+
+    UP<IImage> ImageF16::translateDataType(const TranslationDesc &desc) const {
+        switch (desc.targetType) {
+            case VL_UINT8: {
+                auto targetImage = createUP<ImageU8>(m_Width, m_Height, m_Format, UNINITIALIZED);
+
+                // Get direct access to the target data
+                PixelBuffer<U8>& targetData = targetImage->m_Data;
+                TranslateDataType::translateDataType<F16, U8>(m_Data, targetData, desc);
+
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageF16 to ImageU8 with size ({}x{}) and format {}",
+                    m_Width, m_Height, m_Format);
+                return targetImage;
+            }
+            case VL_FLOAT16: {
+                // Same type, return a copy
+                ImageF16Desc targetDesc;
+                targetDesc.width = m_Width;
+                targetDesc.height = m_Height;
+                targetDesc.format = m_Format;
+                targetDesc.data = m_Data.data();
+                return createUP<ImageF16>(targetDesc);
+            }
+            case VL_FLOAT32: {
+                auto targetImage = createUP<ImageF32>(m_Width, m_Height, m_Format, UNINITIALIZED);
+
+                // Get direct access to the target data
+                PixelBuffer<float>& targetData = targetImage->m_Data;
+                TranslateDataType::translateDataType<F16, float>(m_Data, targetData, desc);
+
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageF16 to ImageF32 with size ({}x{}) and format {}",
+                    m_Width, m_Height, m_Format);
+                return targetImage;
+            }
+            default: {
+                SPDLOG_LOGGER_ERROR(m_Logger, "Unsupported target type for translation from F16: {}", desc.targetType);
+                return nullptr;
+            }
+        }
+    }
+
+    UP<IImage> ImageF16::transform(const TransformDesc& desc) const {
+        TransformDesc transformDesc = desc;
+        if (transformDesc.targetFormat == VL_CHANNEL_FORMAT_MAX_VALUE) {
+            transformDesc.targetFormat = m_Format;
+        }
+        if (transformDesc.targetType == VL_TYPE_MAX_VALUE) {
+            transformDesc.targetType = m_DataType;
+        }
+
+        switch (transformDesc.targetType) {
+            case VL_UINT8: {
+                auto targetImage = createUP<ImageU8>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<F16, U8>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_FLOAT16: {
+                auto targetImage = createUP<ImageF16>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<F16, F16>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_FLOAT32: {
+                auto targetImage = createUP<ImageF32>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<F16, float>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            default: {
+                SPDLOG_LOGGER_ERROR(m_Logger, "Unsupported target type for transform from F16: {}", desc.targetType);
+                return nullptr;
+            }
+        }
+    }
+}
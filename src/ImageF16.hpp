@@ -0,0 +1,59 @@
+#pragma once
+
+#include <VelyraImage/IImage.hpp>
+
+#include "LoggerNames.hpp"
+#include "PixelBuffer.hpp"
+
+namespace Velyra::Image {
+
+    class ImageSource; // Forward declaration
+    class ImageU8; // Forward declaration
+    class ImageF32; // Forward declaration
+
+    class ImageF16: public IImage {
+    public:
+        explicit ImageF16(const ImageLoadDesc& desc);
+
+        /**
+         * @brief Decodes the image as floats and converts them to halves, the format conversion and the flip are
+         *        done in the same pass.
+         */
+        ImageF16(const ImageSource& source, const ImageLoadDesc& desc);
+
+        explicit ImageF16(const ImageF16Desc& desc);
+
+        /**
+         * @brief Creates an image whose pixels are left uninitialized, for operations that overwrite every pixel.
+         */
+        ImageF16(Size width, Size height, VL_CHANNEL_FORMAT format, UninitializedTag);
+
+        ~ImageF16() override = default;
+
+        /**
+         * @brief Writes the image as HDR, the pixels are converted to F32 first.
+         */
+        void write(const ImageWriteDesc& desc) const override;
+
+        UP<IImage> resize(Size width, Size height) const override;
+
+        void* getData() override;
+
+        const void* getData() const override;
+
+        UP<IImage> convertToFormat(const FormatConversionDesc& desc) const override;
+
+        void convertToFormatInPlace(const FormatConversionDesc& desc) override;
+
+        UP<IImage> translateDataType(const TranslationDesc& desc) const override;
+
+        UP<IImage> transform(const TransformDesc& desc) const override;
+
+    private:
+        friend class ImageU8; // Allow ImageU8 to access m_Data
+        friend class ImageF32; // Allow ImageF32 to access m_Data
+
+        PixelBuffer<F16> m_Data;
+    };
+
+}
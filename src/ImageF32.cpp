@@ -1,38 +1,54 @@
 #include "Pch.hpp"
 
 #include "ImageF32.hpp"
+#include "Metrics.hpp"
 #include "ImageUtils.hpp"
+#include "ImageSource.hpp"
 #include "DataTypeConversion/DataTypeConversion.hpp"
 #include "ImageU8.hpp"
+#include "ImageU16.hpp"
+#include "ImageF16.hpp"
 #include "FormatConversion/FormatConversion.hpp"
+#include "Transform/Transform.hpp"
 
 namespace Velyra::Image {
 
     ImageF32::ImageF32(const ImageLoadDesc &desc):
+    ImageF32(ImageSource(desc.fileName, desc.loadMode), desc) {
+
+    }
+
+    ImageF32::ImageF32(const ImageSource &source, const ImageLoadDesc &desc):
     IImage(VL_FLOAT32, LOGGER_F32) {
-        stbi_set_flip_vertically_on_load(desc.flipOnLoad);
+        if (!source.isValid()) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} could not be opened", desc.fileName.string());
+            return;
+        }
         I32 channelCount = 0;
         I32 width = 0;
         I32 height = 0;
-        float* pData = stbi_loadf(desc.fileName.string().c_str(), &width, &height, &channelCount, 0);
+        float* pData = source.decode<float>(desc, width, height, channelCount);
         if (!pData) {
-            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to load", desc.fileName.string());
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to load: {}", desc.fileName.string(), stbi_failure_reason());
             return;
         }
-        SPDLOG_LOGGER_INFO(m_Logger, "Loaded ImageF32: {} with size ({}x{}) and format {}", desc.fileName.string(), m_Width, m_Height, m_Format);
 
         setData<float>(desc, pData, width, height, channelCount, m_Data);
-
-        stbi_image_free(pData);
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Loaded ImageF32: {} with size ({}x{}) and format {}", desc.fileName.string(), m_Width, m_Height, m_Format);
     }
 
     ImageF32::ImageF32(const ImageF32Desc &desc):
     IImage(desc.width, desc.height, VL_FLOAT32, desc.format, LOGGER_F32),
-    m_Data(desc.width * desc.height * getChannelCountFromFormat(desc.format), 1.0f) {
-        if (desc.data != nullptr) {
-            memcpy(m_Data.data(), desc.data, desc.width * desc.height * getChannelCountFromFormat(desc.format) * sizeof(float));
-        }
-        SPDLOG_LOGGER_INFO(m_Logger, "Created ImageF32 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
+    m_Data(desc.data != nullptr ?
+        PixelBuffer<float>(desc.data, desc.width * desc.height * getChannelCountFromFormat(desc.format)) :
+        PixelBuffer<float>(desc.width * desc.height * getChannelCountFromFormat(desc.format), desc.defaultChannelValue)) {
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Created ImageF32 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
+    }
+
+    ImageF32::ImageF32(const Size width, const Size height, const VL_CHANNEL_FORMAT format, UninitializedTag):
+    IImage(width, height, VL_FLOAT32, format, LOGGER_F32),
+    m_Data(width * height * getChannelCountFromFormat(format), UNINITIALIZED) {
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Created uninitialized ImageF32 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
     }
 
     void ImageF32::write(const ImageWriteDesc &desc) const {
@@ -40,6 +56,8 @@ namespace Velyra::Image {
             SPDLOG_LOGGER_WARN(m_Logger, "ImageF32 can only be written to HDR format. Image: {} will not be written", desc.fileName.string());
             return;
         }
+        const ScopedOperationMetrics metrics(VL_OPERATION_WRITE, VL_SIMD_BEST, getSize());
+        // The encoders read the rows in flipped order, the flag is thread local so concurrent writes do not interfere
         stbi_flip_vertically_on_write(desc.flipOnWrite);
         const auto width = static_cast<I32>(m_Width);
         const auto height = static_cast<I32>(m_Height);
@@ -62,15 +80,9 @@ namespace Velyra::Image {
             return createUP<ImageF32>(desc);
         }
 
-        ImageF32Desc desc;
-        desc.width = width;
-        desc.height = height;
-        desc.format = m_Format;
-        desc.data = nullptr;
-        auto resizedImage = createUP<ImageF32>(desc);
-        if (!stbir_resize_float_linear(&m_Data[0], static_cast<int>(m_Width), static_cast<int>(m_Height), 0,
-            static_cast<float*>(resizedImage->getData()), static_cast<int>(width), static_cast<int>(height), 0,
-            vlFormatToStbirFormat(m_Format))){
+        // Every pixel is written by the resize
+        auto resizedImage = createUP<ImageF32>(width, height, m_Format, UNINITIALIZED);
+        if (!resizePixels(m_Data.data(), m_Width, m_Height, resizedImage->getData(), width, height, m_Format, STBIR_TYPE_FLOAT)) {
             SPDLOG_LOGGER_ERROR(m_Logger, "Failed to resize ImageF32 from ({}x{}) to ({}x{})", m_Width, m_Height, width, height);
         }
         return resizedImage;
@@ -85,32 +97,66 @@ namespace Velyra::Image {
     }
 
     UP<IImage> ImageF32::convertToFormat(const FormatConversionDesc &desc) const {
-        ImageF32Desc targetDesc;
-        targetDesc.width = m_Width;
-        targetDesc.height = m_Height;
-        targetDesc.format = desc.targetFormat;
-        targetDesc.data = nullptr;
-        auto targetImage = createUP<ImageF32>(targetDesc);
-        convertFormat<float>(m_Format, m_Data, targetImage->m_Data, desc);
+        auto targetImage = createUP<ImageF32>(m_Width, m_Height, desc.targetFormat, UNINITIALIZED);
+        if (desc.flipVertical) {
+            // The rows are written in flipped order, the conversion works row by row instead of on the whole buffer
+            transformPixels<float, float>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, getTransformDesc(desc));
+        }
+        else {
+            convertFormat<float>(m_Format, m_Data, targetImage->m_Data, desc);
+        }
         return targetImage;
     }
 
+    void ImageF32::convertToFormatInPlace(const FormatConversionDesc& desc) {
+        if (getChannelCountFromFormat(desc.targetFormat) == getChannelCountFromFormat(m_Format)) {
+            convertFormatInPlace<float>(m_Format, m_Data, desc);
+            m_Format = desc.targetFormat;
+            if (desc.flipVertical) {
+                flipVertical({desc.simdMode, desc.executionPolicy});
+            }
+        }
+        else {
+            PixelBuffer<float> targetData(getPixelCount() * getChannelCountFromFormat(desc.targetFormat), UNINITIALIZED);
+            transformPixels<float, float>(m_Format, m_Width, m_Height, m_Data, targetData, getTransformDesc(desc));
+            m_Data = std::move(targetData);
+            m_Format = desc.targetFormat;
+        }
+    }
+
     UP<IImage> ImageF32::translateDataType(const TranslationDesc &desc) const {
         switch (desc.targetType) {
             case VL_UINT8: {
                 // Convert F32 to U8
-                ImageU8Desc targetDesc;
-                targetDesc.width = m_Width;
-                targetDesc.height = m_Height;
-                targetDesc.format = m_Format;
-                targetDesc.data = nullptr;
-                auto targetImage = createUP<ImageU8>(targetDesc);
+                auto targetImage = createUP<ImageU8>(m_Width, m_Height, m_Format, UNINITIALIZED);
 
                 // Get direct access to the target data
-                std::vector<U8>& targetData = targetImage->m_Data;
+                PixelBuffer<U8>& targetData = targetImage->m_Data;
                 TranslateDataType::translateDataType<float, U8>(m_Data, targetData, desc);
 
-                SPDLOG_LOGGER_INFO(m_Logger, "Translated ImageF32 to ImageU8 with size ({}x{}) and format {}",
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageF32 to ImageU8 with size ({}x{}) and format {}",
+                    m_Width, m_Height, m_Format);
+                return targetImage;
+            }
+            case VL_UINT16: {
+                auto targetImage = createUP<ImageU16>(m_Width, m_Height, m_Format, UNINITIALIZED);
+
+                // Get direct access to the target data
+                PixelBuffer<U16>& targetData = targetImage->m_Data;
+                TranslateDataType::translateDataType<float, U16>(m_Data, targetData, desc);
+
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageF32 to ImageU16 with size ({}x{}) and format {}",
+                    m_Width, m_Height, m_Format);
+                return targetImage;
+            }
+            case VL_FLOAT16: {
+                auto targetImage = createUP<ImageF16>(m_Width, m_Height, m_Format, UNINITIALIZED);
+
+                // Get direct access to the target data
+                PixelBuffer<F16>& targetData = targetImage->m_Data;
+                TranslateDataType::translateDataType<float, F16>(m_Data, targetData, desc);
+
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageF32 to ImageF16 with size ({}x{}) and format {}",
                     m_Width, m_Height, m_Format);
                 return targetImage;
             }
@@ -129,4 +175,41 @@ namespace Velyra::Image {
             }
         }
     }
-}
+
+    UP<IImage> ImageF32::transform(const TransformDesc& desc) const {
+        TransformDesc transformDesc = desc;
+        if (transformDesc.targetFormat == VL_CHANNEL_FORMAT_MAX_VALUE) {
+            transformDesc.targetFormat = m_Format;
+        }
+        if (transformDesc.targetType == VL_TYPE_MAX_VALUE) {
+            transformDesc.targetType = m_DataType;
+        }
+
+        switch (transformDesc.targetType) {
+            case VL_UINT8: {
+                auto targetImage = createUP<ImageU8>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<float, U8>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_UINT16: {
+                auto targetImage = createUP<ImageU16>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<float, U16>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_FLOAT16: {
+                auto targetImage = createUP<ImageF16>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<float, F16>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_FLOAT32: {
+                auto targetImage = createUP<ImageF32>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<float, float>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            default: {
+                SPDLOG_LOGGER_ERROR(m_Logger, "Unsupported target type for transform from F32: {}", desc.targetType);
+                return nullptr;
+            }
+        }
+    }
+}
\ No newline at end of file
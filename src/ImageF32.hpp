@@ -1,20 +1,30 @@
 #pragma once
 
 #include <VelyraImage/IImage.hpp>
-#include <vector>
 
 #include "LoggerNames.hpp"
+#include "PixelBuffer.hpp"
 
 namespace Velyra::Image {
 
+    class ImageSource; // Forward declaration
     class ImageU8; // Forward declaration
+    class ImageU16; // Forward declaration
+    class ImageF16; // Forward declaration
 
     class ImageF32: public IImage {
     public:
         explicit ImageF32(const ImageLoadDesc& desc);
 
+        ImageF32(const ImageSource& source, const ImageLoadDesc& desc);
+
         explicit ImageF32(const ImageF32Desc& desc);
 
+        /**
+         * @brief Creates an image whose pixels are left uninitialized, for operations that overwrite every pixel.
+         */
+        ImageF32(Size width, Size height, VL_CHANNEL_FORMAT format, UninitializedTag);
+
         ~ImageF32() override = default;
 
         void write(const ImageWriteDesc& desc) const override;
@@ -27,13 +37,18 @@ namespace Velyra::Image {
 
         UP<IImage> convertToFormat(const FormatConversionDesc& desc) const override;
 
+        void convertToFormatInPlace(const FormatConversionDesc& desc) override;
+
         UP<IImage> translateDataType(const TranslationDesc& desc) const override;
 
+        UP<IImage> transform(const TransformDesc& desc) const override;
+
     private:
         friend class ImageU8; // Allow ImageU8 to access m_Data
+        friend class ImageU16; // Allow ImageU16 to access m_Data
+        friend class ImageF16; // Allow ImageF16 to access m_Data
         
-        std::vector<float> m_Data;
-        Utils::LogPtr m_Logger = Utils::getLogger(LOGGER_F32);
+        PixelBuffer<float> m_Data;
     };
 
 }
\ No newline at end of file
@@ -3,32 +3,118 @@
 #include <VelyraImage/ImageFactory.hpp>
 
 #include "ImageU8.hpp"
+#include "ImageU16.hpp"
+#include "ImageF16.hpp"
 #include "ImageF32.hpp"
+#include "ImageSource.hpp"
+
+#include <atomic>
+#include <exception>
+#include <thread>
 
 namespace Velyra::Image {
 
+    namespace {
+
+        UP<IImage> createImageFromSource(const ImageSource& source, const ImageLoadDesc& desc) {
+            if (source.isHdr()) {
+                return createUP<ImageF32>(source, desc);
+            }
+            if (source.is16Bit()) {
+                return createUP<ImageU16>(source, desc);
+            }
+            return createUP<ImageU8>(source, desc);
+        }
+
+    }
+
     UP<IImage> ImageFactory::createImage(const ImageLoadDesc& desc) {
-        Utils::LogPtr logger = Utils::getLogger(LOGGER_BASE);
         if (!fs::is_regular_file(desc.fileName)) {
             VL_THROW("Image file does not exist: {}", desc.fileName.string());
         }
-        if (stbi_is_hdr(desc.fileName.string().c_str())) {
-            return createUP<ImageF32>(desc);
+        // The file is opened (or mapped) once and reused for the HDR check and the decode
+        const ImageSource source(desc.fileName, desc.loadMode);
+        if (!source.isValid()) {
+            VL_THROW("Image file could not be opened: {}", desc.fileName.string());
         }
-        return createUP<ImageU8>(desc);
+        return createImageFromSource(source, desc);
+    }
+
+    UP<IImage> ImageFactory::createImageFromMemory(const std::span<const std::byte> data, const ImageLoadDesc& desc) {
+        const ImageSource source(data);
+        if (!source.isValid()) {
+            VL_THROW("Invalid image data for: {}", desc.fileName.string());
+        }
+        return createImageFromSource(source, desc);
+    }
+
+    std::vector<UP<IImage>> ImageFactory::createImages(const std::span<const ImageLoadDesc> descs, const Size threadCount) {
+        std::vector<UP<IImage>> images(descs.size());
+        std::vector<std::exception_ptr> errors(descs.size());
+
+        Size workerCount = threadCount != 0 ? threadCount : std::max<Size>(std::thread::hardware_concurrency(), 1);
+        workerCount = std::min(workerCount, descs.size());
+
+        // Workers pull the next image index from a shared counter, every slot is written by exactly one worker
+        std::atomic<Size> nextIndex = 0;
+        auto worker = [&]() {
+            for (Size i = nextIndex++; i < descs.size(); i = nextIndex++) {
+                try {
+                    images[i] = createImage(descs[i]);
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+        {
+            // The calling thread participates as well, so spawn one thread less than the worker count
+            std::vector<std::jthread> threads;
+            for (Size t = 1; t < workerCount; ++t) {
+                threads.emplace_back(worker);
+            }
+            worker();
+        }
+
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        return images;
     }
 
     UP<IImage> ImageFactory::createImageU8(const ImageU8Desc& desc) {
         return createUP<ImageU8>(desc);
     }
     
+    UP<IImage> ImageFactory::createImageU16(const ImageUI16Desc& desc) {
+        return createUP<ImageU16>(desc);
+    }
+
+    UP<IImage> ImageFactory::createImageF16(const ImageF16Desc& desc) {
+        return createUP<ImageF16>(desc);
+    }
+
+    UP<IImage> ImageFactory::createImageF16(const ImageLoadDesc& desc) {
+        if (!fs::is_regular_file(desc.fileName)) {
+            VL_THROW("Image file does not exist: {}", desc.fileName.string());
+        }
+        const ImageSource source(desc.fileName, desc.loadMode);
+        if (!source.isValid()) {
+            VL_THROW("Image file could not be opened: {}", desc.fileName.string());
+        }
+        return createUP<ImageF16>(source, desc);
+    }
+
     UP<IImage> ImageFactory::createImageF32(const ImageF32Desc& desc) {
         return createUP<ImageF32>(desc);
     }
 
     UP<IImage> ImageFactory::translateImageDataType(const IImage& source, const TranslationDesc& desc) {
-        Utils::LogPtr logger = Utils::getLogger(LOGGER_BASE);
-        
+        spdlog::logger* logger = getCachedLogger(LOGGER_BASE);
+
+
         auto result = source.translateDataType(desc);
         if (!result) {
             SPDLOG_LOGGER_ERROR(logger, "Failed to translate image from type {} to type {}", 
@@ -0,0 +1,112 @@
+#include "Pch.hpp"
+
+#include "ImageSource.hpp"
+#include "Metrics.hpp"
+
+namespace Velyra::Image {
+
+    namespace {
+
+        std::span<const stbi_uc> toDecoderBuffer(const std::span<const std::byte> data) {
+            // stb_image takes the buffer length as an int
+            if (data.size() > static_cast<Size>(std::numeric_limits<int>::max())) {
+                return {};
+            }
+            return {reinterpret_cast<const stbi_uc*>(data.data()), data.size()};
+        }
+
+    }
+
+    ImageSource::ImageSource(const fs::path& fileName, const VL_IMAGE_LOAD_MODE loadMode) {
+        if (loadMode == VL_LOAD_MEMORY_MAP) {
+            m_Mapping = MappedFile(fileName);
+            m_Memory = toDecoderBuffer(m_Mapping.getData());
+        }
+        else {
+            m_File = openFileForReading(fileName);
+        }
+    }
+
+    ImageSource::ImageSource(const std::span<const std::byte> data):
+    m_Memory(toDecoderBuffer(data)) {
+
+    }
+
+    bool ImageSource::isValid() const {
+        return m_File != nullptr || !m_Memory.empty();
+    }
+
+    bool ImageSource::isHdr() const {
+        if (m_File) {
+            return stbi_is_hdr_from_file(m_File.get());
+        }
+        return stbi_is_hdr_from_memory(m_Memory.data(), static_cast<int>(m_Memory.size()));
+    }
+
+    bool ImageSource::is16Bit() const {
+        if (m_File) {
+            return stbi_is_16_bit_from_file(m_File.get());
+        }
+        return stbi_is_16_bit_from_memory(m_Memory.data(), static_cast<int>(m_Memory.size()));
+    }
+
+    bool ImageSource::getInfo(I32& width, I32& height, I32& channelCount) const {
+        if (m_File) {
+            return stbi_info_from_file(m_File.get(), &width, &height, &channelCount);
+        }
+        return stbi_info_from_memory(m_Memory.data(), static_cast<int>(m_Memory.size()), &width, &height, &channelCount);
+    }
+
+    template<>
+    U8* ImageSource::load<U8>(I32& width, I32& height, I32& channelCount, const I32 requestedChannelCount) const {
+        if (m_File) {
+            return stbi_load_from_file(m_File.get(), &width, &height, &channelCount, requestedChannelCount);
+        }
+        return stbi_load_from_memory(m_Memory.data(), static_cast<int>(m_Memory.size()), &width, &height, &channelCount, requestedChannelCount);
+    }
+
+    template<>
+    U16* ImageSource::load<U16>(I32& width, I32& height, I32& channelCount, const I32 requestedChannelCount) const {
+        if (m_File) {
+            return stbi_load_from_file_16(m_File.get(), &width, &height, &channelCount, requestedChannelCount);
+        }
+        return stbi_load_16_from_memory(m_Memory.data(), static_cast<int>(m_Memory.size()), &width, &height, &channelCount, requestedChannelCount);
+    }
+
+    template<>
+    float* ImageSource::load<float>(I32& width, I32& height, I32& channelCount, const I32 requestedChannelCount) const {
+        if (m_File) {
+            return stbi_loadf_from_file(m_File.get(), &width, &height, &channelCount, requestedChannelCount);
+        }
+        return stbi_loadf_from_memory(m_Memory.data(), static_cast<int>(m_Memory.size()), &width, &height, &channelCount, requestedChannelCount);
+    }
+
+    template<typename T>
+    T* ImageSource::decode(const ImageLoadDesc& desc, I32& width, I32& height, I32& channelCount) const {
+        if (!isValid()) {
+            return nullptr;
+        }
+        I32 fileChannelCount = 0;
+        if (!getInfo(width, height, fileChannelCount)) {
+            return nullptr;
+        }
+        // Let the decoder emit the requested channel count when its conversion matches ours
+        const I32 decodedChannelCount = getDecoderChannelCount(desc.requestedFormat, fileChannelCount, desc.fillMode);
+
+        // The flip is applied by IImage::setData, folded into the format conversion or as an in place SIMD row swap.
+        // Thread local variant, so other threads decoding with stb_image directly are not affected.
+        stbi_set_flip_vertically_on_load_thread(0);
+        ScopedOperationMetrics metrics(VL_OPERATION_LOAD, VL_SIMD_BEST, 0);
+        T* pData = load<T>(width, height, fileChannelCount, decodedChannelCount);
+        channelCount = decodedChannelCount != 0 ? decodedChannelCount : fileChannelCount;
+        if (pData) {
+            metrics.setBytes(static_cast<Size>(width) * static_cast<Size>(height) * static_cast<Size>(channelCount) * sizeof(T));
+        }
+        return pData;
+    }
+
+    template U8* ImageSource::decode<U8>(const ImageLoadDesc& desc, I32& width, I32& height, I32& channelCount) const;
+    template U16* ImageSource::decode<U16>(const ImageLoadDesc& desc, I32& width, I32& height, I32& channelCount) const;
+    template float* ImageSource::decode<float>(const ImageLoadDesc& desc, I32& width, I32& height, I32& channelCount) const;
+
+}
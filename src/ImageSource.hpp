@@ -0,0 +1,59 @@
+#pragma once
+
+#include <VelyraImage/ImageDefs.hpp>
+#include <span>
+
+#include "ImageUtils.hpp"
+#include "MappedFile.hpp"
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Encoded image data that stb_image can decode from: an open file, a memory mapping of a file, or a
+     *        caller provided memory buffer. The file is opened (or mapped) only once, however many times it is queried.
+     */
+    class ImageSource {
+    public:
+        /**
+         * @brief Opens the file using the requested load mode.
+         */
+        ImageSource(const fs::path& fileName, VL_IMAGE_LOAD_MODE loadMode);
+
+        /**
+         * @brief Decodes from a memory buffer, which must outlive the source. The buffer is not copied.
+         */
+        explicit ImageSource(std::span<const std::byte> data);
+
+        bool isValid() const;
+
+        bool isHdr() const;
+
+        /**
+         * @return True if the image stores 16 bits per channel (16-bit PNG and PNM)
+         */
+        bool is16Bit() const;
+
+        /**
+         * @brief Decodes the image, the decoder directly produces desc.requestedFormat if possible (see getDecoderChannelCount).
+         * @param desc Load description, the requested format is applied but the rows are not flipped
+         * @param width Receives the width of the image
+         * @param height Receives the height of the image
+         * @param channelCount Receives the number of channels in the returned buffer
+         * @return Pixels allocated by stb_image (release with stbi_image_free), or nullptr on failure (see stbi_failure_reason)
+         */
+        template<typename T>
+        T* decode(const ImageLoadDesc& desc, I32& width, I32& height, I32& channelCount) const;
+
+    private:
+        bool getInfo(I32& width, I32& height, I32& channelCount) const;
+
+        template<typename T>
+        T* load(I32& width, I32& height, I32& channelCount, I32 requestedChannelCount) const;
+
+    private:
+        FilePtr m_File;
+        MappedFile m_Mapping;
+        std::span<const stbi_uc> m_Memory;
+    };
+
+}
@@ -0,0 +1,204 @@
+#include "Pch.hpp"
+
+#include "ImageU16.hpp"
+#include "Metrics.hpp"
+#include "ImageU8.hpp"
+#include "ImageF32.hpp"
+#include "ImageUtils.hpp"
+#include "ImageSource.hpp"
+#include "DataTypeConversion/DataTypeConversion.hpp"
+#include "FormatConversion/FormatConversion.hpp"
+#include "Transform/Transform.hpp"
+#include "Png/PngEncoder.hpp"
+
+namespace Velyra::Image {
+
+    ImageU16::ImageU16(const ImageLoadDesc &desc):
+    ImageU16(ImageSource(desc.fileName, desc.loadMode), desc) {
+
+    }
+
+    ImageU16::ImageU16(const ImageSource &source, const ImageLoadDesc &desc):
+    IImage(VL_UINT16, LOGGER_UI16) {
+        if (!source.isValid()) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} could not be opened", desc.fileName.string());
+            return;
+        }
+        I32 channelCount = 0;
+        I32 width = 0;
+        I32 height = 0;
+        // 8-bit files are scaled to the full 16-bit range by the decoder
+        U16* pData = source.decode<U16>(desc, width, height, channelCount);
+        if (!pData) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to load: {}", desc.fileName.string(), stbi_failure_reason());
+            return;
+        }
+
+        setData<U16>(desc, pData, width, height, channelCount, m_Data);
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Loaded ImageU16: {} with size ({}x{}) and format {}", desc.fileName.string(), m_Width, m_Height, m_Format);
+    }
+
+    ImageU16::ImageU16(const ImageUI16Desc &desc):
+    IImage(desc.width, desc.height, VL_UINT16, desc.format, LOGGER_UI16),
+    m_Data(desc.data != nullptr ?
+        PixelBuffer<U16>(desc.data, desc.width * desc.height * getChannelCountFromFormat(desc.format)) :
+        PixelBuffer<U16>(desc.width * desc.height * getChannelCountFromFormat(desc.format), desc.defaultChannelValue)) {
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Created ImageU16 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
+    }
+
+    ImageU16::ImageU16(const Size width, const Size height, const VL_CHANNEL_FORMAT format, UninitializedTag):
+    IImage(width, height, VL_UINT16, format, LOGGER_UI16),
+    m_Data(width * height * getChannelCountFromFormat(format), UNINITIALIZED) {
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Created uninitialized ImageU16 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
+    }
+
+    void ImageU16::write(const ImageWriteDesc &desc) const {
+        if (desc.fileType != VL_IMAGE_PNG) {
+            SPDLOG_LOGGER_WARN(m_Logger, "ImageU16 can only be written to PNG format. Image: {} will not be written", desc.fileName.string());
+            return;
+        }
+        const ScopedOperationMetrics metrics(VL_OPERATION_WRITE, VL_SIMD_BEST, getSize());
+        // stb_image_write only writes 8-bit PNGs
+        PngEncodeDesc encodeDesc;
+        encodeDesc.data = m_Data.data();
+        encodeDesc.width = m_Width;
+        encodeDesc.height = m_Height;
+        encodeDesc.channelCount = getChannelCountFromFormat(m_Format);
+        encodeDesc.bitDepth = 16;
+        encodeDesc.flipVertical = desc.flipOnWrite;
+        encodeDesc.compressionLevel = desc.compressionLevel;
+        encodeDesc.executionPolicy = desc.executionPolicy;
+        if (!writePng(desc.fileName, encodeDesc)) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to write", desc.fileName.string());
+        }
+    }
+
+    UP<IImage> ImageU16::resize(const Size width, const Size height) const {
+        if (width == 0 || height == 0) {
+            SPDLOG_LOGGER_WARN(m_Logger, "Image cannot be resized to ({}x{})", width, height);
+
+            // Simply return a copy of the current image
+            ImageUI16Desc desc;
+            desc.width = m_Width;
+            desc.height = m_Height;
+            desc.format = m_Format;
+            desc.data = m_Data.data();
+            return createUP<ImageU16>(desc);
+        }
+
+        // Every pixel is written by the resize
+        auto resizedImage = createUP<ImageU16>(width, height, m_Format, UNINITIALIZED);
+        if (!resizePixels(m_Data.data(), m_Width, m_Height, resizedImage->getData(), width, height, m_Format, STBIR_TYPE_UINT16)) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Failed to resize ImageU16 from ({}x{}) to ({}x{})", m_Width, m_Height, width, height);
+        }
+        return resizedImage;
+    }
+
+    void* ImageU16::getData() {
+        return m_Data.data();
+    }
+
+    const void* ImageU16::getData() const {
+        return m_Data.data();
+    }
+
+    UP<IImage> ImageU16::convertToFormat(const FormatConversionDesc &desc) const {
+        auto targetImage = createUP<ImageU16>(m_Width, m_Height, desc.targetFormat, UNINITIALIZED);
+        if (desc.flipVertical) {
+            // The rows are written in flipped order, the conversion works row by row instead of on the whole buffer
+            transformPixels<U16, U16>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, getTransformDesc(desc));
+        }
+        else {
+            convertFormat<U16>(m_Format, m_Data, targetImage->m_Data, desc);
+        }
+        return targetImage;
+    }
+
+    void ImageU16::convertToFormatInPlace(const FormatConversionDesc& desc) {
+        if (getChannelCountFromFormat(desc.targetFormat) == getChannelCountFromFormat(m_Format)) {
+            convertFormatInPlace<U16>(m_Format, m_Data, desc);
+            m_Format = desc.targetFormat;
+            if (desc.flipVertical) {
+                flipVertical({desc.simdMode, desc.executionPolicy});
+            }
+        }
+        else {
+            PixelBuffer<U16> targetData(getPixelCount() * getChannelCountFromFormat(desc.targetFormat), UNINITIALIZED);
+            transformPixels<U16, U16>(m_Format, m_Width, m_Height, m_Data, targetData, getTransformDesc(desc));
+            m_Data = std::move(targetData);
+            m_Format = desc.targetFormat;
+        }
+    }
+
+    UP<IImage> ImageU16::translateDataType(const TranslationDesc &desc) const {
+        switch (desc.targetType) {
+            case VL_UINT8: {
+                auto targetImage = createUP<ImageU8>(m_Width, m_Height, m_Format, UNINITIALIZED);
+
+                // Get direct access to the target data
+                PixelBuffer<U8>& targetData = targetImage->m_Data;
+                TranslateDataType::translateDataType<U16, U8>(m_Data, targetData, desc);
+
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageU16 to ImageU8 with size ({}x{}) and format {}",
+                    m_Width, m_Height, m_Format);
+                return targetImage;
+            }
+            case VL_UINT16: {
+                // Same type, return a copy
+                ImageUI16Desc targetDesc;
+                targetDesc.width = m_Width;
+                targetDesc.height = m_Height;
+                targetDesc.format = m_Format;
+                targetDesc.data = m_Data.data();
+                return createUP<ImageU16>(targetDesc);
+            }
+            case VL_FLOAT32: {
+                auto targetImage = createUP<ImageF32>(m_Width, m_Height, m_Format, UNINITIALIZED);
+
+                // Get direct access to the target data
+                PixelBuffer<float>& targetData = targetImage->m_Data;
+                TranslateDataType::translateDataType<U16, float>(m_Data, targetData, desc);
+
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageU16 to ImageF32 with size ({}x{}) and format {}",
+                    m_Width, m_Height, m_Format);
+                return targetImage;
+            }
+            default: {
+                SPDLOG_LOGGER_ERROR(m_Logger, "Unsupported target type for translation from U16: {}", desc.targetType);
+                return nullptr;
+            }
+        }
+    }
+
+    UP<IImage> ImageU16::transform(const TransformDesc& desc) const {
+        TransformDesc transformDesc = desc;
+        if (transformDesc.targetFormat == VL_CHANNEL_FORMAT_MAX_VALUE) {
+            transformDesc.targetFormat = m_Format;
+        }
+        if (transformDesc.targetType == VL_TYPE_MAX_VALUE) {
+            transformDesc.targetType = m_DataType;
+        }
+
+        switch (transformDesc.targetType) {
+            case VL_UINT8: {
+                auto targetImage = createUP<ImageU8>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<U16, U8>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_UINT16: {
+                auto targetImage = createUP<ImageU16>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<U16, U16>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_FLOAT32: {
+                auto targetImage = createUP<ImageF32>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<U16, float>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            default: {
+                SPDLOG_LOGGER_ERROR(m_Logger, "Unsupported target type for transform from U16: {}", desc.targetType);
+                return nullptr;
+            }
+        }
+    }
+}
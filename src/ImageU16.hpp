@@ -0,0 +1,52 @@
+#pragma once
+
+#include <VelyraImage/IImage.hpp>
+
+#include "LoggerNames.hpp"
+#include "PixelBuffer.hpp"
+
+namespace Velyra::Image {
+
+    class ImageSource; // Forward declaration
+    class ImageU8; // Forward declaration
+    class ImageF32; // Forward declaration
+
+    class ImageU16: public IImage {
+    public:
+        explicit ImageU16(const ImageLoadDesc& desc);
+
+        ImageU16(const ImageSource& source, const ImageLoadDesc& desc);
+
+        explicit ImageU16(const ImageUI16Desc& desc);
+
+        /**
+         * @brief Creates an image whose pixels are left uninitialized, for operations that overwrite every pixel.
+         */
+        ImageU16(Size width, Size height, VL_CHANNEL_FORMAT format, UninitializedTag);
+
+        ~ImageU16() override = default;
+
+        void write(const ImageWriteDesc& desc) const override;
+
+        UP<IImage> resize(Size width, Size height) const override;
+
+        void* getData() override;
+
+        const void* getData() const override;
+
+        UP<IImage> convertToFormat(const FormatConversionDesc& desc) const override;
+
+        void convertToFormatInPlace(const FormatConversionDesc& desc) override;
+
+        UP<IImage> translateDataType(const TranslationDesc& desc) const override;
+
+        UP<IImage> transform(const TransformDesc& desc) const override;
+
+    private:
+        friend class ImageU8; // Allow ImageU8 to access m_Data
+        friend class ImageF32; // Allow ImageF32 to access m_Data
+
+        PixelBuffer<U16> m_Data;
+    };
+
+}
\ No newline at end of file
@@ -1,41 +1,61 @@
 #include "Pch.hpp"
 
 #include "ImageU8.hpp"
+#include "Metrics.hpp"
 #include "ImageUtils.hpp"
+#include "ImageSource.hpp"
 #include "DataTypeConversion/DataTypeConversion.hpp"
 #include "ImageF32.hpp"
+#include "ImageU16.hpp"
+#include "ImageF16.hpp"
 #include "FormatConversion/FormatConversion.hpp"
+#include "Transform/Transform.hpp"
+#include "Png/PngEncoder.hpp"
+#include "Jpg/JpgEncoder.hpp"
 
 namespace Velyra::Image {
 
     ImageU8::ImageU8(const ImageLoadDesc &desc):
-    IImage(VL_UINT8, LOGGER_UI8){
-        stbi_set_flip_vertically_on_load(desc.flipOnLoad);
+    ImageU8(ImageSource(desc.fileName, desc.loadMode), desc) {
+
+    }
+
+    ImageU8::ImageU8(const ImageSource &source, const ImageLoadDesc &desc):
+    IImage(VL_UINT8, LOGGER_UI8) {
+        if (!source.isValid()) {
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} could not be opened", desc.fileName.string());
+            return;
+        }
         I32 channelCount = 0;
         I32 width = 0;
         I32 height = 0;
-        U8* pData = stbi_load(desc.fileName.string().c_str(), &width, &height, &channelCount, 0);
+        U8* pData = source.decode<U8>(desc, width, height, channelCount);
         if (!pData) {
-            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to load", desc.fileName.string());
+            SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to load: {}", desc.fileName.string(), stbi_failure_reason());
             return;
         }
-        SPDLOG_LOGGER_INFO(m_Logger, "Loaded ImageU8: {} with size ({}x{}) and format {}", desc.fileName.string(), m_Width, m_Height, m_Format);
 
         setData<U8>(desc, pData, width, height, channelCount, m_Data);
-
-        stbi_image_free(pData);
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Loaded ImageU8: {} with size ({}x{}) and format {}", desc.fileName.string(), m_Width, m_Height, m_Format);
     }
 
     ImageU8::ImageU8(const ImageU8Desc &desc):
     IImage(desc.width, desc.height, VL_UINT8, desc.format, LOGGER_UI8),
-    m_Data(desc.width * desc.height * getChannelCountFromFormat(desc.format), 255) {
-        if (desc.data != nullptr) {
-            memcpy(m_Data.data(), desc.data, desc.width * desc.height * getChannelCountFromFormat(desc.format));
-        }
-        SPDLOG_LOGGER_INFO(m_Logger, "Created ImageUI8 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
+    m_Data(desc.data != nullptr ?
+        PixelBuffer<U8>(desc.data, desc.width * desc.height * getChannelCountFromFormat(desc.format)) :
+        PixelBuffer<U8>(desc.width * desc.height * getChannelCountFromFormat(desc.format), desc.defaultChannelValue)) {
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Created ImageUI8 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
+    }
+
+    ImageU8::ImageU8(const Size width, const Size height, const VL_CHANNEL_FORMAT format, UninitializedTag):
+    IImage(width, height, VL_UINT8, format, LOGGER_UI8),
+    m_Data(width * height * getChannelCountFromFormat(format), UNINITIALIZED) {
+        VL_IMAGE_LOG_HOT_PATH(m_Logger, "Created uninitialized ImageUI8 with size ({}x{}) and format {}", m_Width, m_Height, m_Format);
     }
 
     void ImageU8::write(const ImageWriteDesc &desc) const {
+        const ScopedOperationMetrics metrics(VL_OPERATION_WRITE, VL_SIMD_BEST, getSize());
+        // The encoders read the rows in flipped order, the flag is thread local so concurrent writes do not interfere
         stbi_flip_vertically_on_write(desc.flipOnWrite);
         const auto width = static_cast<I32>(m_Width);
         const auto height = static_cast<I32>(m_Height);
@@ -43,11 +63,24 @@ namespace Velyra::Image {
 
         switch (desc.fileType) {
             case VL_IMAGE_PNG: {
-                stbi_write_png(desc.fileName.string().c_str(), width, height, channelCount, &m_Data[0], width * channelCount);
+                // Filters and compresses in parallel, stbi_write_png runs on one thread
+                PngEncodeDesc encodeDesc;
+                encodeDesc.data = m_Data.data();
+                encodeDesc.width = m_Width;
+                encodeDesc.height = m_Height;
+                encodeDesc.channelCount = static_cast<U32>(channelCount);
+                encodeDesc.flipVertical = desc.flipOnWrite;
+                encodeDesc.compressionLevel = desc.compressionLevel;
+                encodeDesc.executionPolicy = desc.executionPolicy;
+                if (!writePng(desc.fileName, encodeDesc)) {
+                    SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to write", desc.fileName.string());
+                }
                 break;
             }
             case VL_IMAGE_JPG: {
-                stbi_write_jpg(desc.fileName.string().c_str(), width, height, channelCount, &m_Data[0], 100); // last parameter is the quality, 100 is the highest quality
+                if (!writeJpg(desc.fileName, createJpgEncodeDesc(desc, m_Data.data(), m_Width, m_Height, m_Format))) {
+                    SPDLOG_LOGGER_ERROR(m_Logger, "Image: {} failed to write", desc.fileName.string());
+                }
                 break;
             }
             case VL_IMAGE_BMP: {
@@ -74,16 +107,9 @@ namespace Velyra::Image {
             return createUP<ImageU8>(desc);
         }
 
-        ImageU8Desc desc;
-        desc.width = width;
-        desc.height = height;
-        desc.format = m_Format;
-        desc.data = nullptr;
-        auto resizedImage = createUP<ImageU8>(desc);
-        if (!stbir_resize_uint8_linear(
-                m_Data.data(), static_cast<I32>(m_Width), static_cast<I32>(m_Height), 0,
-                static_cast<unsigned char *>(resizedImage->getData()), static_cast<I32>(width), static_cast<I32>(height), 0,
-                vlFormatToStbirFormat(m_Format))) {
+        // Every pixel is written by the resize
+        auto resizedImage = createUP<ImageU8>(width, height, m_Format, UNINITIALIZED);
+        if (!resizePixels(m_Data.data(), m_Width, m_Height, resizedImage->getData(), width, height, m_Format, STBIR_TYPE_UINT8)) {
             SPDLOG_LOGGER_ERROR(m_Logger, "Failed to resize ImageUI8 from ({}x{}) to ({}x{})", m_Width, m_Height, width, height);
         }
         return resizedImage;
@@ -98,16 +124,33 @@ namespace Velyra::Image {
     }
 
     UP<IImage> ImageU8::convertToFormat(const FormatConversionDesc &desc) const {
-        ImageU8Desc targetDesc;
-        targetDesc.width = m_Width;
-        targetDesc.height = m_Height;
-        targetDesc.format = desc.targetFormat;
-        targetDesc.data = nullptr;
-        auto targetImage = createUP<ImageU8>(targetDesc);
-        convertFormat<U8>(m_Format, m_Data, targetImage->m_Data, desc);
+        auto targetImage = createUP<ImageU8>(m_Width, m_Height, desc.targetFormat, UNINITIALIZED);
+        if (desc.flipVertical) {
+            // The rows are written in flipped order, the conversion works row by row instead of on the whole buffer
+            transformPixels<U8, U8>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, getTransformDesc(desc));
+        }
+        else {
+            convertFormat<U8>(m_Format, m_Data, targetImage->m_Data, desc);
+        }
         return targetImage;
     }
 
+    void ImageU8::convertToFormatInPlace(const FormatConversionDesc& desc) {
+        if (getChannelCountFromFormat(desc.targetFormat) == getChannelCountFromFormat(m_Format)) {
+            convertFormatInPlace<U8>(m_Format, m_Data, desc);
+            m_Format = desc.targetFormat;
+            if (desc.flipVertical) {
+                flipVertical({desc.simdMode, desc.executionPolicy});
+            }
+        }
+        else {
+            PixelBuffer<U8> targetData(getPixelCount() * getChannelCountFromFormat(desc.targetFormat), UNINITIALIZED);
+            transformPixels<U8, U8>(m_Format, m_Width, m_Height, m_Data, targetData, getTransformDesc(desc));
+            m_Data = std::move(targetData);
+            m_Format = desc.targetFormat;
+        }
+    }
+
     UP<IImage> ImageU8::translateDataType(const TranslationDesc &desc) const {
         switch (desc.targetType) {
             case VL_UINT8: {
@@ -119,19 +162,36 @@ namespace Velyra::Image {
                 targetDesc.data = m_Data.data();
                 return createUP<ImageU8>(targetDesc);
             }
+            case VL_UINT16: {
+                auto targetImage = createUP<ImageU16>(m_Width, m_Height, m_Format, UNINITIALIZED);
+
+                // Get direct access to the target data
+                PixelBuffer<U16>& targetData = targetImage->m_Data;
+                TranslateDataType::translateDataType<U8, U16>(m_Data, targetData, desc);
+
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageU8 to ImageU16 with size ({}x{}) and format {}",
+                    m_Width, m_Height, m_Format);
+                return targetImage;
+            }
+            case VL_FLOAT16: {
+                auto targetImage = createUP<ImageF16>(m_Width, m_Height, m_Format, UNINITIALIZED);
+
+                // Get direct access to the target data
+                PixelBuffer<F16>& targetData = targetImage->m_Data;
+                TranslateDataType::translateDataType<U8, F16>(m_Data, targetData, desc);
+
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageU8 to ImageF16 with size ({}x{}) and format {}",
+                    m_Width, m_Height, m_Format);
+                return targetImage;
+            }
             case VL_FLOAT32: {
-                ImageF32Desc targetDesc;
-                targetDesc.width = m_Width;
-                targetDesc.height = m_Height;
-                targetDesc.format = m_Format;
-                targetDesc.data = nullptr;
-                auto targetImage = createUP<ImageF32>(targetDesc);
+                auto targetImage = createUP<ImageF32>(m_Width, m_Height, m_Format, UNINITIALIZED);
 
                 // Get direct access to the target data
-                std::vector<float>& targetData = targetImage->m_Data;
+                PixelBuffer<float>& targetData = targetImage->m_Data;
                 TranslateDataType::translateDataType<U8, float>(m_Data, targetData, desc);
 
-                SPDLOG_LOGGER_INFO(m_Logger, "Translated ImageU8 to ImageF32 with size ({}x{}) and format {}",
+                VL_IMAGE_LOG_HOT_PATH(m_Logger, "Translated ImageU8 to ImageF32 with size ({}x{}) and format {}",
                     m_Width, m_Height, m_Format);
                 return targetImage;
             }
@@ -141,5 +201,41 @@ namespace Velyra::Image {
             }
         }
     }
-}
 
+    UP<IImage> ImageU8::transform(const TransformDesc& desc) const {
+        TransformDesc transformDesc = desc;
+        if (transformDesc.targetFormat == VL_CHANNEL_FORMAT_MAX_VALUE) {
+            transformDesc.targetFormat = m_Format;
+        }
+        if (transformDesc.targetType == VL_TYPE_MAX_VALUE) {
+            transformDesc.targetType = m_DataType;
+        }
+
+        switch (transformDesc.targetType) {
+            case VL_UINT8: {
+                auto targetImage = createUP<ImageU8>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<U8, U8>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_UINT16: {
+                auto targetImage = createUP<ImageU16>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<U8, U16>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_FLOAT16: {
+                auto targetImage = createUP<ImageF16>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<U8, F16>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            case VL_FLOAT32: {
+                auto targetImage = createUP<ImageF32>(m_Width, m_Height, transformDesc.targetFormat, UNINITIALIZED);
+                transformPixels<U8, float>(m_Format, m_Width, m_Height, m_Data, targetImage->m_Data, transformDesc);
+                return targetImage;
+            }
+            default: {
+                SPDLOG_LOGGER_ERROR(m_Logger, "Unsupported target type for transform from U8: {}", desc.targetType);
+                return nullptr;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -1,20 +1,30 @@
 #pragma once
 
 #include <VelyraImage/IImage.hpp>
-#include <vector>
 
 #include "LoggerNames.hpp"
+#include "PixelBuffer.hpp"
 
 namespace Velyra::Image {
 
+    class ImageSource; // Forward declaration
+    class ImageU16; // Forward declaration
+    class ImageF16; // Forward declaration
     class ImageF32; // Forward declaration
 
     class ImageU8: public IImage {
     public:
         explicit ImageU8(const ImageLoadDesc& desc);
 
+        ImageU8(const ImageSource& source, const ImageLoadDesc& desc);
+
         explicit ImageU8(const ImageU8Desc& desc);
 
+        /**
+         * @brief Creates an image whose pixels are left uninitialized, for operations that overwrite every pixel.
+         */
+        ImageU8(Size width, Size height, VL_CHANNEL_FORMAT format, UninitializedTag);
+
         ~ImageU8() override = default;
 
         void write(const ImageWriteDesc& desc) const override;
@@ -27,12 +37,18 @@ namespace Velyra::Image {
 
         UP<IImage> convertToFormat(const FormatConversionDesc& desc) const override;
 
+        void convertToFormatInPlace(const FormatConversionDesc& desc) override;
+
         UP<IImage> translateDataType(const TranslationDesc& desc) const override;
 
+        UP<IImage> transform(const TransformDesc& desc) const override;
+
     private:
         friend class ImageF32; // Allow ImageF32 to access m_Data
+        friend class ImageU16; // Allow ImageU16 to access m_Data
+        friend class ImageF16; // Allow ImageF16 to access m_Data
         
-        std::vector<U8> m_Data;
+        PixelBuffer<U8> m_Data;
     };
 
 }
\ No newline at end of file
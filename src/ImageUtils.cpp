@@ -1,9 +1,95 @@
 #include "Pch.hpp"
 
 #include "ImageUtils.hpp"
+#include "SimdDispatch.hpp"
+#include "Executor/ParallelFor.hpp"
+#include "LoggerNames.hpp"
+#include "Metrics.hpp"
+
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <string_view>
 
 namespace Velyra::Image {
 
+    void FileCloser::operator()(FILE* file) const {
+        if (file != nullptr) {
+            fclose(file);
+        }
+    }
+
+    spdlog::logger* getCachedLogger(const char* loggerName) {
+        struct CachedLogger {
+            const char* name;
+            Utils::LogPtr logger;
+        };
+        static const std::array<CachedLogger, 5> loggers = {{
+            {LOGGER_BASE, Utils::getLogger(LOGGER_BASE)},
+            {LOGGER_UI8, Utils::getLogger(LOGGER_UI8)},
+            {LOGGER_UI16, Utils::getLogger(LOGGER_UI16)},
+            {LOGGER_F16, Utils::getLogger(LOGGER_F16)},
+            {LOGGER_F32, Utils::getLogger(LOGGER_F32)},
+        }};
+        for (const CachedLogger& cached : loggers) {
+            // Compared by content, an equal name at a different address is the same logger
+            if (std::string_view(cached.name) == loggerName) {
+                return cached.logger.get();
+            }
+        }
+        VL_THROW("Unknown logger: {}", loggerName);
+    }
+
+    FilePtr openFileForReading(const fs::path& fileName) {
+        FILE* file = nullptr;
+#if defined(_WIN32)
+        if (_wfopen_s(&file, fileName.c_str(), L"rb") != 0) {
+            return nullptr;
+        }
+#else
+        file = fopen(fileName.c_str(), "rb");
+#endif
+        return FilePtr(file);
+    }
+
+    FilePtr openFileForWriting(const fs::path& fileName) {
+        FILE* file = nullptr;
+#if defined(_WIN32)
+        if (_wfopen_s(&file, fileName.c_str(), L"wb") != 0) {
+            return nullptr;
+        }
+#else
+        file = fopen(fileName.c_str(), "wb");
+#endif
+        return FilePtr(file);
+    }
+
+    I32 getDecoderChannelCount(const VL_CHANNEL_FORMAT requestedFormat, const I32 fileChannelCount, const VL_FORMAT_CONVERSION_FILL fillMode) {
+        switch (requestedFormat) {
+            case VL_CHANNEL_R:
+            case VL_CHANNEL_RG:
+            case VL_CHANNEL_RGB:
+            case VL_CHANNEL_RGBA: break;
+            default: return 0; // stb_image cannot produce BGR(A), and MAX_VALUE means keep the native format
+        }
+        const auto requestedChannelCount = static_cast<I32>(getChannelCountFromFormat(requestedFormat));
+        if (requestedChannelCount == fileChannelCount) {
+            return 0;
+        }
+        // stb_image replicates grey into RGB, while convertFormat fills the missing channels, so only allow
+        // conversions within grey/grey-alpha or within RGB/RGBA (which only add or drop the last channel)
+        const bool requestedIsGrey = requestedChannelCount <= 2;
+        const bool fileIsGrey = fileChannelCount <= 2;
+        if (requestedIsGrey != fileIsGrey) {
+            return 0;
+        }
+        // stb_image fills an added channel with the maximum value
+        if (requestedChannelCount > fileChannelCount && fillMode != VL_FILL_MAX) {
+            return 0;
+        }
+        return requestedChannelCount;
+    }
+
     stbir_pixel_layout vlFormatToStbirFormat(const VL_CHANNEL_FORMAT format) {
         switch (format) {
             case VL_CHANNEL_R:      return STBIR_1CHANNEL;
@@ -16,21 +102,204 @@ namespace Velyra::Image {
         }
     }
 
-    VL_SIMD_MODE findBestMode(const VL_SIMD_MODE requestedMode) {
-        const Utils::CpuFeatures cpuFeatures = Utils::detectCpuFeatures();
-        if (requestedMode == VL_SIMD_BEST) {
-            // is AVX2 supported?
-            if (cpuFeatures.avx2) {
-                return VL_SIMD_AVX2;
+    namespace {
+
+        Size getStbirTypeSize(const stbir_datatype dataType) {
+            switch (dataType) {
+                case STBIR_TYPE_UINT16:
+                case STBIR_TYPE_HALF_FLOAT: return 2;
+                case STBIR_TYPE_FLOAT:      return 4;
+                default:                    return 1;
+            }
+        }
+
+        void runSplitsOnExecutor(void* executorContext, const int splitCount, vl_stbir_split_task* task, void* taskContext) {
+            auto* executor = static_cast<IExecutor*>(executorContext);
+            try {
+                executor->parallelFor(static_cast<Size>(splitCount), [&](const Size split) {
+                    task(taskContext, static_cast<int>(split));
+                });
+            }
+            catch (...) {
+                // Exceptions cannot pass through stb_image_resize2, splits that did not run make the resize fail
+            }
+        }
+
+    }
+
+    bool resizePixels(const void* input, const Size inputWidth, const Size inputHeight, void* output, const Size outputWidth,
+        const Size outputHeight, const VL_CHANNEL_FORMAT format, const stbir_datatype dataType, const VL_EXECUTION_POLICY policy) {
+        const Size pixelBytes = getChannelCountFromFormat(format) * getStbirTypeSize(dataType);
+        const Size totalBytes = (inputWidth * inputHeight + outputWidth * outputHeight) * pixelBytes;
+
+        SP<IExecutor> executor;
+        int maxSplits = 1;
+        if (policy == VL_EXECUTION_PARALLEL && totalBytes >= PARALLEL_MIN_BYTES) {
+            executor = getExecutor();
+            maxSplits = static_cast<int>(std::min<Size>(executor->getConcurrency(), VL_STBIR_MAX_SPLITS));
+        }
+        const SimdDispatchTable& table = getDispatchTable(VL_SIMD_BEST);
+        const ResizeFunction resize = table.resize;
+        const ScopedOperationMetrics metrics(VL_OPERATION_RESIZE, table.mode, totalBytes);
+        return resize(input, static_cast<int>(inputWidth), static_cast<int>(inputHeight), 0,
+            output, static_cast<int>(outputWidth), static_cast<int>(outputHeight), 0,
+            vlFormatToStbirFormat(format), dataType, maxSplits, maxSplits > 1 ? &runSplitsOnExecutor : nullptr,
+            executor.get()) != 0;
+    }
+
+    namespace {
+
+        SimdSupport detectSimdSupport() {
+            SimdSupport support;
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_cpu_init();
+            support.sse2 = __builtin_cpu_supports("sse2");
+            support.ssse3 = __builtin_cpu_supports("ssse3");
+            support.sse41 = __builtin_cpu_supports("sse4.1");
+            support.avx2 = __builtin_cpu_supports("avx2");
+            support.fma = __builtin_cpu_supports("fma");
+            support.f16c = __builtin_cpu_supports("f16c");
+            // The AVX-512 kernels also use the 128 and 256 bit masked forms of AVX512VL
+            support.avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                __builtin_cpu_supports("avx512vl");
+            support.avx512vbmi = support.avx512 && __builtin_cpu_supports("avx512vbmi");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int info[4];
+            __cpuid(info, 0);
+            const int maxLeaf = info[0];
+            __cpuid(info, 1);
+            support.sse2 = (info[3] & (1 << 26)) != 0;
+            support.ssse3 = (info[2] & (1 << 9)) != 0;
+            support.sse41 = (info[2] & (1 << 19)) != 0;
+            // AVX registers are only usable if the OS saves them on a context switch (OSXSAVE + XCR0 bits 1 and 2),
+            // AVX-512 additionally needs the opmask and upper ZMM state (XCR0 bits 5 to 7)
+            const bool osXSave = (info[2] & (1 << 27)) != 0;
+            const unsigned long long xcr0 = osXSave ? _xgetbv(0) : 0;
+            const bool osSavesYmm = (xcr0 & 0x6) == 0x6;
+            const bool osSavesZmm = osSavesYmm && (xcr0 & 0xE0) == 0xE0;
+            support.fma = osSavesYmm && (info[2] & (1 << 12)) != 0;
+            support.f16c = osSavesYmm && (info[2] & (1 << 29)) != 0;
+            if (maxLeaf >= 7) {
+                __cpuidex(info, 7, 0);
+                support.avx2 = osSavesYmm && (info[1] & (1 << 5)) != 0;
+                // AVX512F, AVX512BW and AVX512VL, bit 31 needs an unsigned shift
+                support.avx512 = osSavesZmm && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0 &&
+                    (info[1] & (1u << 31)) != 0;
+                support.avx512vbmi = support.avx512 && (info[2] & (1 << 1)) != 0;
+            }
+#endif
+            return support;
+        }
+
+        // Ordered from the widest to the narrowest instruction set
+        constexpr std::array<VL_SIMD_MODE, 6> SIMD_TIERS = {
+            VL_SIMD_AVX512, VL_SIMD_AVX2, VL_SIMD_SSE41, VL_SIMD_SSSE3, VL_SIMD_SSE2, VL_SIMD_SCALAR
+        };
+
+        Size getSimdTierIndex(const VL_SIMD_MODE mode) {
+            const auto it = std::find(SIMD_TIERS.begin(), SIMD_TIERS.end(), mode);
+            return static_cast<Size>(std::distance(SIMD_TIERS.begin(), it));
+        }
+
+        // Widest supported instruction set that is not wider than the requested one
+        VL_SIMD_MODE resolveSimdMode(const VL_SIMD_MODE requestedMode) {
+            const Size first = requestedMode == VL_SIMD_BEST ? 0 : getSimdTierIndex(requestedMode);
+            for (Size i = first; i < SIMD_TIERS.size(); ++i) {
+                if (isSimdModeSupported(SIMD_TIERS[i])) {
+                    return SIMD_TIERS[i];
+                }
             }
-            // Fallback to scalar
             return VL_SIMD_SCALAR;
         }
-        if (requestedMode == VL_SIMD_AVX2 && !cpuFeatures.avx2) {
-            SPDLOG_WARN("AVX2 not supported on this CPU, falling back to scalar translation");
+
+        std::string readEnvironmentVariable(const char* name) {
+#if defined(_MSC_VER)
+            char* buffer = nullptr;
+            Size length = 0;
+            if (_dupenv_s(&buffer, &length, name) != 0 || buffer == nullptr) {
+                return {};
+            }
+            std::string value(buffer);
+            free(buffer);
+            return value;
+#else
+            const char* value = std::getenv(name);
+            return value != nullptr ? std::string(value) : std::string();
+#endif
+        }
+
+        // VL_SIMD_BEST resolves to the mode set in SIMD_MODE_ENVIRONMENT_VARIABLE, if any
+        VL_SIMD_MODE resolveBestMode() {
+            const std::string value = readEnvironmentVariable(SIMD_MODE_ENVIRONMENT_VARIABLE);
+            if (value.empty()) {
+                return resolveSimdMode(VL_SIMD_BEST);
+            }
+            const VL_SIMD_MODE overrideMode = parseSimdMode(value);
+            if (overrideMode == VL_SIMD_MODE_MAX_VALUE) {
+                SPDLOG_WARN("Ignoring unknown SIMD mode '{}' in {}", value, SIMD_MODE_ENVIRONMENT_VARIABLE);
+                return resolveSimdMode(VL_SIMD_BEST);
+            }
+            const VL_SIMD_MODE resolvedMode = resolveSimdMode(overrideMode);
+            SPDLOG_INFO("{}={} selects SIMD mode {}", SIMD_MODE_ENVIRONMENT_VARIABLE, value, resolvedMode);
+            return resolvedMode;
+        }
+
+    }
+
+    const SimdSupport& getSimdSupport() {
+        static const SimdSupport support = detectSimdSupport();
+        return support;
+    }
+
+    bool isSimdModeSupported(const VL_SIMD_MODE mode) {
+        const SimdSupport& support = getSimdSupport();
+        switch (mode) {
+            case VL_SIMD_BEST:
+            case VL_SIMD_SCALAR: return true;
+            case VL_SIMD_SSE2:   return support.sse2;
+            case VL_SIMD_SSSE3:  return support.ssse3;
+            case VL_SIMD_SSE41:  return support.sse41;
+            case VL_SIMD_AVX2:   return support.avx2;
+            case VL_SIMD_AVX512: return support.avx512;
+            default:             return false;
+        }
+    }
+
+    VL_SIMD_MODE parseSimdMode(const std::string_view name) {
+        std::string lower(name);
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](const unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        if (lower == "best")   return VL_SIMD_BEST;
+        if (lower == "scalar") return VL_SIMD_SCALAR;
+        if (lower == "sse2")   return VL_SIMD_SSE2;
+        if (lower == "ssse3")  return VL_SIMD_SSSE3;
+        if (lower == "sse41")  return VL_SIMD_SSE41;
+        if (lower == "avx2")   return VL_SIMD_AVX2;
+        if (lower == "avx512") return VL_SIMD_AVX512;
+        return VL_SIMD_MODE_MAX_VALUE;
+    }
+
+    VL_SIMD_MODE findBestMode(const VL_SIMD_MODE requestedMode) {
+        // Resolved once, every later call is a table lookup
+        static const std::array<VL_SIMD_MODE, VL_SIMD_MODE_MAX_VALUE> resolvedModes = [] {
+            std::array<VL_SIMD_MODE, VL_SIMD_MODE_MAX_VALUE> modes{};
+            for (Size i = 0; i < modes.size(); ++i) {
+                const auto mode = static_cast<VL_SIMD_MODE>(i);
+                modes[i] = mode == VL_SIMD_BEST ? resolveBestMode() : resolveSimdMode(mode);
+            }
+            return modes;
+        }();
+        static std::array<std::atomic<bool>, VL_SIMD_MODE_MAX_VALUE> fallbackReported{};
+
+        if (requestedMode < VL_SIMD_BEST || requestedMode >= VL_SIMD_MODE_MAX_VALUE) {
             return VL_SIMD_SCALAR;
         }
-        return requestedMode;
+        const VL_SIMD_MODE resolvedMode = resolvedModes[requestedMode];
+        if (requestedMode != VL_SIMD_BEST && resolvedMode != requestedMode && !fallbackReported[requestedMode].exchange(true)) {
+            SPDLOG_WARN("SIMD mode {} not supported on this CPU, falling back to {}", requestedMode, resolvedMode);
+        }
+        return resolvedMode;
     }
 
 }
@@ -1,11 +1,84 @@
 #pragma once
 
 #include <VelyraImage/ImageDefs.hpp>
+#include <cstdio>
+#include <string_view>
 
 namespace Velyra::Image {
 
+    struct FileCloser {
+        void operator()(FILE* file) const;
+    };
+
+    using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+    /**
+     * @brief Opens a file for binary reading, the file is closed when the returned pointer goes out of scope.
+     * @return Pointer to the opened file, or nullptr if the file could not be opened
+     */
+    FilePtr openFileForReading(const fs::path& fileName);
+
+    /**
+     * @brief Opens (and truncates) a file for binary writing, the file is closed when the returned pointer goes out of scope.
+     * @return Pointer to the opened file, or nullptr if the file could not be opened
+     */
+    FilePtr openFileForWriting(const fs::path& fileName);
+
+    /**
+     * @brief Determines how many channels stb_image should decode into, so the decoder directly produces the requested format.
+     *        stb_image converts between grey/grey-alpha and RGB/RGBA only, and fills an added alpha channel with the
+     *        maximum value. Whenever that would differ from what convertFormat produces, 0 is returned and the image
+     *        should be decoded in its native channel count.
+     * @param requestedFormat Format requested by the user, VL_CHANNEL_FORMAT_MAX_VALUE if the native format should be kept
+     * @param fileChannelCount Number of channels stored in the image file
+     * @param fillMode Fill mode for channels that are not present in the file
+     * @return Channel count to pass to the decoder, or 0 to decode in the native channel count
+     */
+    I32 getDecoderChannelCount(VL_CHANNEL_FORMAT requestedFormat, I32 fileChannelCount, VL_FORMAT_CONVERSION_FILL fillMode);
+
     stbir_pixel_layout vlFormatToStbirFormat(VL_CHANNEL_FORMAT format);
 
+    /**
+     * @brief Resizes tightly packed pixels with stb_image_resize2 (clamped edges, default filters).
+     *        Large resizes are split into horizontal bands that run on the executor, small ones run inline.
+     * @return True on success
+     */
+    bool resizePixels(const void* input, Size inputWidth, Size inputHeight, void* output, Size outputWidth, Size outputHeight,
+        VL_CHANNEL_FORMAT format, stbir_datatype dataType, VL_EXECUTION_POLICY policy = VL_EXECUTION_PARALLEL);
+
+    /**
+     * @brief Instruction sets supported by the CPU (and the OS), detected once on first use.
+     */
+    struct SimdSupport {
+        bool sse2   = false;
+        bool ssse3  = false;
+        bool sse41  = false;
+        bool avx2   = false;
+        bool fma    = false;
+        bool f16c   = false;
+        bool avx512 = false; // AVX512-F, AVX512-BW and AVX512-VL
+        bool avx512vbmi = false;
+    };
+
+    const SimdSupport& getSimdSupport();
+
+    /**
+     * @brief Environment variable that overrides what VL_SIMD_BEST resolves to, e.g. VELYRA_IMAGE_SIMD=sse41.
+     *        Accepts the values of parseSimdMode and is read once, the first time a SIMD mode is resolved.
+     */
+    constexpr auto SIMD_MODE_ENVIRONMENT_VARIABLE = "VELYRA_IMAGE_SIMD";
+
+    /**
+     * @brief Parses best, scalar, sse2, ssse3, sse41, avx2 or avx512 (case-insensitive).
+     * @return The SIMD mode, or VL_SIMD_MODE_MAX_VALUE if the name is unknown
+     */
+    VL_SIMD_MODE parseSimdMode(std::string_view name);
+
+    /**
+     * @brief Resolves the SIMD mode to use. VL_SIMD_BEST selects the widest supported instruction set (or the one set
+     *        in SIMD_MODE_ENVIRONMENT_VARIABLE), an unsupported mode falls back to the widest supported instruction
+     *        set below it. The resolution is computed once, later calls only do a table lookup.
+     */
     VL_SIMD_MODE findBestMode(VL_SIMD_MODE requestedMode);
 
 }
\ No newline at end of file
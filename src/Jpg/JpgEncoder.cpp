@@ -0,0 +1,738 @@
+#include "../Pch.hpp"
+
+#include "JpgEncoder.hpp"
+#include "../ImageUtils.hpp"
+#include "../SimdDispatch.hpp"
+#include "../Executor/ParallelFor.hpp"
+
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+
+namespace Velyra::Image {
+
+    namespace {
+
+        // Position of every coefficient of a block (row major order) in the zigzag order of the file
+        constexpr std::array<U8, 64> ZIGZAG = {
+            0, 1, 5, 6, 14, 15, 27, 28, 2, 4, 7, 13, 16, 26, 29, 42, 3, 8, 12, 17, 25, 30, 41, 43, 9, 11, 18, 24, 31, 40,
+            44, 53, 10, 19, 23, 32, 39, 45, 52, 54, 20, 22, 33, 38, 46, 51, 55, 60, 21, 34, 37, 47, 50, 56, 59, 61, 35, 36,
+            48, 49, 57, 58, 62, 63
+        };
+
+        constexpr auto NATURAL_ORDER = [] {
+            std::array<U8, 64> order{};
+            for (Size i = 0; i < order.size(); ++i) {
+                order[ZIGZAG[i]] = static_cast<U8>(i);
+            }
+            return order;
+        }();
+
+        // Quantization tables of the JPEG standard (Annex K) at quality 50, in row major order
+        constexpr std::array<U8, 64> LUMA_QUANTIZERS = {
+            16, 11, 10, 16, 24, 40, 51, 61, 12, 12, 14, 19, 26, 58, 60, 55, 14, 13, 16, 24, 40, 57, 69, 56, 14, 17, 22, 29,
+            51, 87, 80, 62, 18, 22, 37, 56, 68, 109, 103, 77, 24, 35, 55, 64, 81, 104, 113, 92, 49, 64, 78, 87, 103, 121,
+            120, 101, 72, 92, 95, 98, 112, 100, 103, 99
+        };
+
+        constexpr std::array<U8, 64> CHROMA_QUANTIZERS = {
+            17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99, 24, 26, 56, 99, 99, 99, 99, 99, 47, 66, 99, 99,
+            99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+            99, 99, 99, 99, 99, 99, 99, 99
+        };
+
+        // The AAN DCT leaves every coefficient scaled by these factors (times 8), they are divided out while quantizing
+        constexpr std::array<float, 8> AAN_SCALES = {
+            1.0f * 2.828427125f, 1.387039845f * 2.828427125f, 1.306562965f * 2.828427125f, 1.175875602f * 2.828427125f,
+            1.0f * 2.828427125f, 0.785694958f * 2.828427125f, 0.541196100f * 2.828427125f, 0.275899379f * 2.828427125f
+        };
+
+        /**
+         * Huffman table in the layout of a DHT segment: the number of codes of every length from 1 to 16 bits,
+         * followed by the symbols in the order of their codes.
+         */
+        struct HuffmanSpec {
+            std::array<U8, 16> counts;
+            std::span<const U8> symbols;
+        };
+
+        // Huffman tables of the JPEG standard (Annex K.3)
+        constexpr std::array<U8, 12> DC_SYMBOLS = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+        constexpr std::array<U8, 162> LUMA_AC_SYMBOLS = {
+            0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71,
+            0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72,
+            0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37,
+            0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+            0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83,
+            0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3,
+            0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+            0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+            0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa
+        };
+
+        constexpr std::array<U8, 162> CHROMA_AC_SYMBOLS = {
+            0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22,
+            0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1,
+            0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36,
+            0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+            0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+            0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a,
+            0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba,
+            0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+            0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa
+        };
+
+        constexpr HuffmanSpec LUMA_DC_SPEC = {{0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0}, DC_SYMBOLS};
+        constexpr HuffmanSpec LUMA_AC_SPEC = {{0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d}, LUMA_AC_SYMBOLS};
+        constexpr HuffmanSpec CHROMA_DC_SPEC = {{0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0}, DC_SYMBOLS};
+        constexpr HuffmanSpec CHROMA_AC_SPEC = {{0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77}, CHROMA_AC_SYMBOLS};
+
+        constexpr U8 END_OF_BLOCK = 0x00;
+        constexpr U8 ZERO_RUN_16 = 0xF0;
+
+        // Grey images are written as YCbCr too, like stb_image_write does, so they load back as RGB
+        constexpr Size COMPONENT_COUNT = 3;
+
+        // MCU rows are grouped into bands of about this many source bytes, every band is one task on the executor
+        constexpr Size BAND_BYTES = PARALLEL_BLOCK_BYTES;
+
+        struct HuffmanTable {
+            std::array<U16, 256> codes{};
+            std::array<U8, 256> lengths{};
+        };
+
+        // Canonical codes: the codes of every length count up from the last code of the previous length, shifted left
+        constexpr HuffmanTable buildHuffmanTable(const HuffmanSpec& spec) {
+            HuffmanTable table;
+            U32 code = 0;
+            Size symbol = 0;
+            for (U32 length = 1; length <= spec.counts.size(); ++length) {
+                for (U32 i = 0; i < spec.counts[length - 1]; ++i, ++code, ++symbol) {
+                    table.codes[spec.symbols[symbol]] = static_cast<U16>(code);
+                    table.lengths[spec.symbols[symbol]] = static_cast<U8>(length);
+                }
+                code <<= 1;
+            }
+            return table;
+        }
+
+        constexpr HuffmanTable LUMA_DC_TABLE = buildHuffmanTable(LUMA_DC_SPEC);
+        constexpr HuffmanTable LUMA_AC_TABLE = buildHuffmanTable(LUMA_AC_SPEC);
+        constexpr HuffmanTable CHROMA_DC_TABLE = buildHuffmanTable(CHROMA_DC_SPEC);
+        constexpr HuffmanTable CHROMA_AC_TABLE = buildHuffmanTable(CHROMA_AC_SPEC);
+
+        /**
+         * Collects the entropy coded data MSB first. Every 0xFF byte is followed by a stuffed 0x00, so the data
+         * cannot be mistaken for a marker.
+         */
+        class BitWriter {
+        public:
+            explicit BitWriter(std::vector<U8>& output):
+            m_Output(output) {
+
+            }
+
+            // At most 32 bits per call
+            void write(const U32 bits, const U32 count) {
+                m_Buffer = m_Buffer << count | bits;
+                m_Count += count;
+                if (m_Count >= 32) {
+                    emitBytes(4);
+                }
+            }
+
+            /**
+             * Pads the last byte with 1 bits, as required before a marker.
+             */
+            void flush() {
+                const U32 padding = (8 - m_Count % 8) % 8;
+                write((1u << padding) - 1, padding);
+                emitBytes(m_Count / 8);
+            }
+
+        private:
+            void emitBytes(const U32 count) {
+                for (U32 i = 0; i < count; ++i) {
+                    m_Count -= 8;
+                    const auto byte = static_cast<U8>(m_Buffer >> m_Count);
+                    m_Output.push_back(byte);
+                    if (byte == 0xFF) {
+                        m_Output.push_back(0x00);
+                    }
+                }
+            }
+
+        private:
+            std::vector<U8>& m_Output;
+            U64 m_Buffer = 0; // The low m_Count bits are pending
+            U32 m_Count = 0;
+        };
+
+        /**
+         * Writes the Huffman code of symbol followed by the low `size` bits of value (the JPEG representation of
+         * negative values is value - 1).
+         */
+        void writeSymbol(BitWriter& writer, const HuffmanTable& table, const U32 symbol, const I32 value, const U32 size) {
+            const U32 bits = static_cast<U32>(value < 0 ? value - 1 : value) & ((1u << size) - 1);
+            writer.write(static_cast<U32>(table.codes[symbol]) << size | bits, table.lengths[symbol] + size);
+        }
+
+        U32 getCategory(const I32 value) {
+            return static_cast<U32>(std::bit_width(static_cast<U32>(std::abs(value))));
+        }
+
+        void encodeBlock(BitWriter& writer, const I16* coefficients, I32& previousDc, const HuffmanTable& dcTable,
+            const HuffmanTable& acTable) {
+            const I32 difference = coefficients[0] - previousDc;
+            previousDc = coefficients[0];
+            const U32 dcSize = getCategory(difference);
+            writeSymbol(writer, dcTable, dcSize, difference, dcSize);
+
+            U32 run = 0;
+            for (Size i = 1; i < 64; ++i) {
+                const I32 value = coefficients[NATURAL_ORDER[i]];
+                if (value == 0) {
+                    ++run;
+                    continue;
+                }
+                for (; run >= 16; run -= 16) {
+                    writer.write(acTable.codes[ZERO_RUN_16], acTable.lengths[ZERO_RUN_16]);
+                }
+                const U32 size = getCategory(value);
+                writeSymbol(writer, acTable, run << 4 | size, value, size);
+                run = 0;
+            }
+            if (run != 0) {
+                writer.write(acTable.codes[END_OF_BLOCK], acTable.lengths[END_OF_BLOCK]);
+            }
+        }
+
+        /**
+         * Scales a quantization table of the standard like libjpeg and stb_image_write do.
+         */
+        std::array<U8, 64> scaleQuantizers(const std::array<U8, 64>& quantizers, const U32 quality) {
+            const U32 clampedQuality = std::clamp(quality, 1u, 100u);
+            const U32 scale = clampedQuality < 50 ? 5000 / clampedQuality : 200 - clampedQuality * 2;
+            std::array<U8, 64> result{};
+            for (Size i = 0; i < result.size(); ++i) {
+                result[i] = static_cast<U8>(std::clamp<U32>((quantizers[i] * scale + 50) / 100, 1, 255));
+            }
+            return result;
+        }
+
+        std::array<float, 64> getDctScales(const std::array<U8, 64>& quantizers) {
+            std::array<float, 64> scales{};
+            for (Size row = 0; row < 8; ++row) {
+                for (Size column = 0; column < 8; ++column) {
+                    scales[row * 8 + column] = 1.0f / (static_cast<float>(quantizers[row * 8 + column]) * AAN_SCALES[row] * AAN_SCALES[column]);
+                }
+            }
+            return scales;
+        }
+
+        void appendU16(std::vector<U8>& output, const Size value) {
+            output.push_back(static_cast<U8>(value >> 8));
+            output.push_back(static_cast<U8>(value));
+        }
+
+        void appendMarker(std::vector<U8>& output, const U8 marker, const Size payloadSize) {
+            output.push_back(0xFF);
+            output.push_back(marker);
+            appendU16(output, payloadSize + 2); // The length includes itself
+        }
+
+        void appendHuffmanTable(std::vector<U8>& output, const U8 tableClassAndId, const HuffmanSpec& spec) {
+            output.push_back(tableClassAndId);
+            output.insert(output.end(), spec.counts.begin(), spec.counts.end());
+            output.insert(output.end(), spec.symbols.begin(), spec.symbols.end());
+        }
+
+        struct JpgLayout {
+            Size horizontalSampling = 1; // Luma blocks per MCU in each direction, chroma has one block per MCU
+            Size verticalSampling = 1;
+            Size mcuWidth = 0;
+            Size mcuHeight = 0;
+            Size mcusPerRow = 0;
+            Size mcuRowCount = 0;
+            Size paddedWidth = 0; // Width rounded up to whole MCUs
+            Size mcuRowsPerBand = 0;
+            Size bandCount = 0;
+        };
+
+        JpgLayout createLayout(const JpgEncodeDesc& desc) {
+            const Size channelCount = getChannelCountFromFormat(desc.format);
+            JpgLayout layout;
+            layout.horizontalSampling = desc.subsampling == VL_JPG_SUBSAMPLING_444 ? 1 : 2;
+            layout.verticalSampling = desc.subsampling == VL_JPG_SUBSAMPLING_420 ? 2 : 1;
+            layout.mcuWidth = 8 * layout.horizontalSampling;
+            layout.mcuHeight = 8 * layout.verticalSampling;
+            layout.mcusPerRow = (desc.width + layout.mcuWidth - 1) / layout.mcuWidth;
+            layout.mcuRowCount = (desc.height + layout.mcuHeight - 1) / layout.mcuHeight;
+            layout.paddedWidth = layout.mcusPerRow * layout.mcuWidth;
+            // The restart interval is stored in 16 bits
+            const Size mcuRowBytes = layout.mcuHeight * desc.width * channelCount;
+            layout.mcuRowsPerBand = std::clamp<Size>(BAND_BYTES / mcuRowBytes, 1, 0xFFFF / layout.mcusPerRow);
+            layout.bandCount = (layout.mcuRowCount + layout.mcuRowsPerBand - 1) / layout.mcuRowsPerBand;
+            return layout;
+        }
+
+        std::vector<U8> createHeader(const JpgEncodeDesc& desc, const JpgLayout& layout, const std::array<U8, 64>& lumaQuantizers,
+            const std::array<U8, 64>& chromaQuantizers) {
+            std::vector<U8> header = {0xFF, 0xD8}; // SOI
+
+            // JFIF 1.01, no thumbnail, square pixels
+            appendMarker(header, 0xE0, 14);
+            header.insert(header.end(), {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0});
+
+            // Quantization tables, in zigzag order
+            appendMarker(header, 0xDB, 65 * 2);
+            for (Size table = 0; table < 2; ++table) {
+                const std::array<U8, 64>& quantizers = table == 0 ? lumaQuantizers : chromaQuantizers;
+                header.push_back(static_cast<U8>(table));
+                for (Size i = 0; i < 64; ++i) {
+                    header.push_back(quantizers[NATURAL_ORDER[i]]);
+                }
+            }
+
+            // Baseline frame with the components Y, Cb and Cr, component i uses quantization table min(i, 1)
+            appendMarker(header, 0xC0, 6 + 3 * COMPONENT_COUNT);
+            header.push_back(8);
+            appendU16(header, desc.height);
+            appendU16(header, desc.width);
+            header.push_back(static_cast<U8>(COMPONENT_COUNT));
+            for (Size component = 0; component < COMPONENT_COUNT; ++component) {
+                header.push_back(static_cast<U8>(component + 1));
+                header.push_back(component == 0 ? static_cast<U8>(layout.horizontalSampling << 4 | layout.verticalSampling) : 0x11);
+                header.push_back(component == 0 ? 0 : 1);
+            }
+
+            const auto getSpecSize = [](const HuffmanSpec& spec) { return 1 + spec.counts.size() + spec.symbols.size(); };
+            appendMarker(header, 0xC4, getSpecSize(LUMA_DC_SPEC) + getSpecSize(LUMA_AC_SPEC) + getSpecSize(CHROMA_DC_SPEC) +
+                getSpecSize(CHROMA_AC_SPEC));
+            appendHuffmanTable(header, 0x00, LUMA_DC_SPEC);
+            appendHuffmanTable(header, 0x10, LUMA_AC_SPEC);
+            appendHuffmanTable(header, 0x01, CHROMA_DC_SPEC);
+            appendHuffmanTable(header, 0x11, CHROMA_AC_SPEC);
+
+            if (layout.bandCount > 1) {
+                appendMarker(header, 0xDD, 2);
+                appendU16(header, layout.mcuRowsPerBand * layout.mcusPerRow);
+            }
+
+            appendMarker(header, 0xDA, 4 + 2 * COMPONENT_COUNT);
+            header.push_back(static_cast<U8>(COMPONENT_COUNT));
+            for (Size component = 0; component < COMPONENT_COUNT; ++component) {
+                header.push_back(static_cast<U8>(component + 1));
+                header.push_back(component == 0 ? 0x00 : 0x11);
+            }
+            header.insert(header.end(), {0, 63, 0}); // Spectral selection 0 to 63, no successive approximation
+            return header;
+        }
+
+        // The DC coefficient of a block is coded as the difference to the previous block of the component
+        struct DcPredictions {
+            I32 y = 0;
+            I32 cb = 0;
+            I32 cr = 0;
+        };
+
+        /**
+         * Encodes the bands of an image, keeps the planes of one MCU row. Every task of the executor uses its own
+         * instance.
+         */
+        class BandEncoder {
+        public:
+            BandEncoder(const JpgEncodeDesc& desc, const JpgLayout& layout, const std::array<float, 64>& lumaScales,
+                const std::array<float, 64>& chromaScales):
+            m_Desc(desc),
+            m_Layout(layout),
+            m_LumaScales(lumaScales),
+            m_ChromaScales(chromaScales),
+            m_ChannelCount(getChannelCountFromFormat(desc.format)),
+            m_ChromaWidth(layout.paddedWidth / layout.horizontalSampling),
+            m_Y(layout.mcuHeight * layout.paddedWidth),
+            m_Cb(m_Y.size()),
+            m_Cr(m_Y.size()) {
+                const SimdDispatchTable& table = getDispatchTable(desc.simdMode);
+                m_ConvertColor = table.jpgConvertColor;
+                m_ForwardDct = table.jpgForwardDct;
+                if (m_ChannelCount >= 3 && desc.format != VL_CHANNEL_RGBA) {
+                    m_RgbaRow.resize(desc.width * 4);
+                }
+                if (layout.horizontalSampling != 1 || layout.verticalSampling != 1) {
+                    m_SubsampledCb.resize(8 * m_ChromaWidth);
+                    m_SubsampledCr.resize(8 * m_ChromaWidth);
+                }
+            }
+
+            /**
+             * @return The entropy coded data of the band, padded to whole bytes
+             */
+            std::vector<U8> encode(const Size band) {
+                std::vector<U8> output;
+                BitWriter writer(output);
+                DcPredictions predictions; // The DC predictions restart at every band
+                const Size rowBytes = m_Desc.width * m_ChannelCount;
+                const auto rowStride = static_cast<std::ptrdiff_t>(rowBytes);
+                const Size firstMcuRow = band * m_Layout.mcuRowsPerBand;
+                const Size endMcuRow = std::min(firstMcuRow + m_Layout.mcuRowsPerBand, m_Layout.mcuRowCount);
+                for (Size mcuRow = firstMcuRow; mcuRow < endMcuRow; ++mcuRow) {
+                    const Size y = mcuRow * m_Layout.mcuHeight;
+                    const Size rowCount = std::min(m_Layout.mcuHeight, m_Desc.height - y);
+                    if (m_Desc.flipVertical) {
+                        encodeMcuRow(writer, predictions, m_Desc.data + (m_Desc.height - 1 - y) * rowBytes, -rowStride, rowCount);
+                    }
+                    else {
+                        encodeMcuRow(writer, predictions, m_Desc.data + y * rowBytes, rowStride, rowCount);
+                    }
+                }
+                writer.flush();
+                return output;
+            }
+
+            /**
+             * Encodes one MCU row from rowCount (1 to mcuHeight) rows, the first row at firstRow and the others
+             * rowStride bytes apart.
+             */
+            void encodeMcuRow(BitWriter& writer, DcPredictions& predictions, const U8* firstRow, const std::ptrdiff_t rowStride,
+                const Size rowCount) {
+                alignas(32) std::array<I16, 64> coefficients{};
+                loadPlanes(firstRow, rowStride, rowCount);
+                const float* cb = m_SubsampledCb.empty() ? m_Cb.data() : m_SubsampledCb.data();
+                const float* cr = m_SubsampledCr.empty() ? m_Cr.data() : m_SubsampledCr.data();
+                for (Size mcu = 0; mcu < m_Layout.mcusPerRow; ++mcu) {
+                    for (Size blockY = 0; blockY < m_Layout.verticalSampling; ++blockY) {
+                        for (Size blockX = 0; blockX < m_Layout.horizontalSampling; ++blockX) {
+                            const float* block = m_Y.data() + blockY * 8 * m_Layout.paddedWidth + mcu * m_Layout.mcuWidth + blockX * 8;
+                            m_ForwardDct(block, m_Layout.paddedWidth, m_LumaScales.data(), coefficients.data());
+                            encodeBlock(writer, coefficients.data(), predictions.y, LUMA_DC_TABLE, LUMA_AC_TABLE);
+                        }
+                    }
+                    m_ForwardDct(cb + mcu * 8, m_ChromaWidth, m_ChromaScales.data(), coefficients.data());
+                    encodeBlock(writer, coefficients.data(), predictions.cb, CHROMA_DC_TABLE, CHROMA_AC_TABLE);
+                    m_ForwardDct(cr + mcu * 8, m_ChromaWidth, m_ChromaScales.data(), coefficients.data());
+                    encodeBlock(writer, coefficients.data(), predictions.cr, CHROMA_DC_TABLE, CHROMA_AC_TABLE);
+                }
+            }
+
+        private:
+            /**
+             * Converts the rows of an MCU row to the planes. Rows past rowCount and columns past the image repeat the
+             * last row and column, like stb_image_write does. R and RG images are grey, their chroma planes are zero.
+             */
+            void loadPlanes(const U8* firstRow, const std::ptrdiff_t rowStride, const Size rowCount) {
+                const Size width = m_Desc.width;
+                const Size rowBytes = width * m_ChannelCount;
+                for (Size row = 0; row < m_Layout.mcuHeight; ++row) {
+                    const U8* source = firstRow + static_cast<std::ptrdiff_t>(std::min(row, rowCount - 1)) * rowStride;
+                    float* yRow = m_Y.data() + row * m_Layout.paddedWidth;
+                    float* cbRow = m_Cb.data() + row * m_Layout.paddedWidth;
+                    float* crRow = m_Cr.data() + row * m_Layout.paddedWidth;
+                    if (m_ChannelCount < 3) {
+                        for (Size x = 0; x < width; ++x) {
+                            yRow[x] = static_cast<float>(source[x * m_ChannelCount]) - 128.0f;
+                        }
+                        std::fill(yRow + width, yRow + m_Layout.paddedWidth, yRow[width - 1]);
+                        std::fill(cbRow, cbRow + m_Layout.paddedWidth, 0.0f);
+                        std::fill(crRow, crRow + m_Layout.paddedWidth, 0.0f);
+                        continue;
+                    }
+                    const U8* rgba = source;
+                    if (!m_RgbaRow.empty()) {
+                        const SimdDispatchTable& table = getDispatchTable(m_Desc.simdMode);
+                        table.convertFormatU8(m_Desc.format, std::span(source, rowBytes), VL_CHANNEL_RGBA, m_RgbaRow, VL_FILL_MAX);
+                        rgba = m_RgbaRow.data();
+                    }
+                    m_ConvertColor(rgba, width, yRow, cbRow, crRow);
+                    std::fill(yRow + width, yRow + m_Layout.paddedWidth, yRow[width - 1]);
+                    std::fill(cbRow + width, cbRow + m_Layout.paddedWidth, cbRow[width - 1]);
+                    std::fill(crRow + width, crRow + m_Layout.paddedWidth, crRow[width - 1]);
+                }
+                if (!m_SubsampledCb.empty()) {
+                    subsample(m_Cb, m_SubsampledCb);
+                    subsample(m_Cr, m_SubsampledCr);
+                }
+            }
+
+            /**
+             * Averages every 2x1 (4:2:2) or 2x2 (4:2:0) samples of a full resolution plane.
+             */
+            void subsample(const std::vector<float>& plane, std::vector<float>& output) const {
+                const bool vertical = m_Layout.verticalSampling == 2;
+                for (Size y = 0; y < 8; ++y) {
+                    float* outputRow = output.data() + y * m_ChromaWidth;
+                    if (vertical) {
+                        const float* row0 = plane.data() + 2 * y * m_Layout.paddedWidth;
+                        const float* row1 = row0 + m_Layout.paddedWidth;
+                        for (Size x = 0; x < m_ChromaWidth; ++x) {
+                            outputRow[x] = (row0[2 * x] + row0[2 * x + 1] + row1[2 * x] + row1[2 * x + 1]) * 0.25f;
+                        }
+                    }
+                    else {
+                        const float* row = plane.data() + y * m_Layout.paddedWidth;
+                        for (Size x = 0; x < m_ChromaWidth; ++x) {
+                            outputRow[x] = (row[2 * x] + row[2 * x + 1]) * 0.5f;
+                        }
+                    }
+                }
+            }
+
+        private:
+            const JpgEncodeDesc& m_Desc;
+            const JpgLayout& m_Layout;
+            const std::array<float, 64>& m_LumaScales;
+            const std::array<float, 64>& m_ChromaScales;
+            const Size m_ChannelCount;
+            const Size m_ChromaWidth;
+            JpgConvertColorFunction m_ConvertColor = nullptr;
+            JpgForwardDctFunction m_ForwardDct = nullptr;
+            std::vector<U8> m_RgbaRow; // Rows of other formats are converted to RGBA first
+            std::vector<float> m_Y; // Planes of one MCU row, padded to whole MCUs
+            std::vector<float> m_Cb;
+            std::vector<float> m_Cr;
+            std::vector<float> m_SubsampledCb; // Only with subsampling
+            std::vector<float> m_SubsampledCr;
+        };
+
+        bool isValidDesc(const JpgEncodeDesc& desc) {
+            const U32 channelCount = getChannelCountFromFormat(desc.format);
+            return desc.width != 0 && desc.height != 0 && desc.width <= 0xFFFF && desc.height <= 0xFFFF &&
+                channelCount >= 1 && channelCount <= 4;
+        }
+
+    }
+
+    void convertRgbaToYcc_Scalar(const U8* rgba, const Size pixelCount, float* y, float* cb, float* cr) {
+        for (Size i = 0; i < pixelCount; ++i) {
+            const auto r = static_cast<float>(rgba[i * 4]);
+            const auto g = static_cast<float>(rgba[i * 4 + 1]);
+            const auto b = static_cast<float>(rgba[i * 4 + 2]);
+            y[i] = 0.29900f * r + 0.58700f * g + 0.11400f * b - 128.0f;
+            cb[i] = -0.16874f * r - 0.33126f * g + 0.50000f * b;
+            cr[i] = 0.50000f * r - 0.41869f * g - 0.08131f * b;
+        }
+    }
+
+    namespace {
+
+        void forwardDct1D(float* d0p, float* d1p, float* d2p, float* d3p, float* d4p, float* d5p, float* d6p, float* d7p) {
+            const float d0 = *d0p, d1 = *d1p, d2 = *d2p, d3 = *d3p, d4 = *d4p, d5 = *d5p, d6 = *d6p, d7 = *d7p;
+
+            const float tmp0 = d0 + d7;
+            const float tmp7 = d0 - d7;
+            const float tmp1 = d1 + d6;
+            const float tmp6 = d1 - d6;
+            const float tmp2 = d2 + d5;
+            const float tmp5 = d2 - d5;
+            const float tmp3 = d3 + d4;
+            const float tmp4 = d3 - d4;
+
+            // Even part
+            const float tmp10 = tmp0 + tmp3;
+            const float tmp13 = tmp0 - tmp3;
+            const float tmp11 = tmp1 + tmp2;
+            const float tmp12 = tmp1 - tmp2;
+            const float z1 = (tmp12 + tmp13) * 0.707106781f;
+            *d0p = tmp10 + tmp11;
+            *d4p = tmp10 - tmp11;
+            *d2p = tmp13 + z1;
+            *d6p = tmp13 - z1;
+
+            // Odd part
+            const float odd10 = tmp4 + tmp5;
+            const float odd11 = tmp5 + tmp6;
+            const float odd12 = tmp6 + tmp7;
+            const float z5 = (odd10 - odd12) * 0.382683433f;
+            const float z2 = odd10 * 0.541196100f + z5;
+            const float z4 = odd12 * 1.306562965f + z5;
+            const float z3 = odd11 * 0.707106781f;
+            const float z11 = tmp7 + z3;
+            const float z13 = tmp7 - z3;
+            *d5p = z13 + z2;
+            *d3p = z13 - z2;
+            *d1p = z11 + z4;
+            *d7p = z11 - z4;
+        }
+
+    }
+
+    void forwardDct_Scalar(const float* samples, const Size stride, const float* scales, I16* coefficients) {
+        std::array<float, 64> block{};
+        for (Size row = 0; row < 8; ++row) {
+            std::memcpy(block.data() + row * 8, samples + row * stride, 8 * sizeof(float));
+        }
+        float* d = block.data();
+        for (Size row = 0; row < 64; row += 8) {
+            forwardDct1D(d + row, d + row + 1, d + row + 2, d + row + 3, d + row + 4, d + row + 5, d + row + 6, d + row + 7);
+        }
+        for (Size column = 0; column < 8; ++column) {
+            forwardDct1D(d + column, d + column + 8, d + column + 16, d + column + 24, d + column + 32, d + column + 40,
+                d + column + 48, d + column + 56);
+        }
+        for (Size i = 0; i < 64; ++i) {
+            const float value = block[i] * scales[i];
+            coefficients[i] = static_cast<I16>(value < 0.0f ? value - 0.5f : value + 0.5f);
+        }
+    }
+
+    JpgEncodeDesc createJpgEncodeDesc(const ImageWriteDesc& writeDesc, const U8* data, const Size width, const Size height,
+        const VL_CHANNEL_FORMAT format) {
+        JpgEncodeDesc desc;
+        desc.data = data;
+        desc.width = width;
+        desc.height = height;
+        desc.format = format;
+        desc.flipVertical = writeDesc.flipOnWrite;
+        desc.quality = writeDesc.jpgQuality;
+        desc.subsampling = writeDesc.jpgSubsampling;
+        desc.simdMode = writeDesc.simdMode;
+        desc.executionPolicy = writeDesc.executionPolicy;
+        return desc;
+    }
+
+    std::vector<U8> encodeJpg(const JpgEncodeDesc& desc) {
+        if (!desc.data || !isValidDesc(desc)) {
+            return {};
+        }
+        const JpgLayout layout = createLayout(desc);
+        const std::array<U8, 64> lumaQuantizers = scaleQuantizers(LUMA_QUANTIZERS, desc.quality);
+        const std::array<U8, 64> chromaQuantizers = scaleQuantizers(CHROMA_QUANTIZERS, desc.quality);
+        const std::array<float, 64> lumaScales = getDctScales(lumaQuantizers);
+        const std::array<float, 64> chromaScales = getDctScales(chromaQuantizers);
+
+        std::vector<std::vector<U8>> bands(layout.bandCount);
+        const Size bandBytes = layout.mcuRowsPerBand * layout.mcuHeight * desc.width * getChannelCountFromFormat(desc.format);
+        parallelForBlocks(desc.executionPolicy, layout.bandCount, bandBytes, [&](const Size begin, const Size end) {
+            BandEncoder encoder(desc, layout, lumaScales, chromaScales);
+            for (Size band = begin; band < end; ++band) {
+                bands[band] = encoder.encode(band);
+            }
+        });
+
+        std::vector<U8> jpg = createHeader(desc, layout, lumaQuantizers, chromaQuantizers);
+        Size dataSize = 0;
+        for (const std::vector<U8>& band : bands) {
+            dataSize += band.size() + 2;
+        }
+        jpg.reserve(jpg.size() + dataSize + 2);
+        for (Size band = 0; band < bands.size(); ++band) {
+            if (band != 0) {
+                // RST0 to RST7 in turn
+                jpg.push_back(0xFF);
+                jpg.push_back(static_cast<U8>(0xD0 + (band - 1) % 8));
+            }
+            jpg.insert(jpg.end(), bands[band].begin(), bands[band].end());
+        }
+        jpg.push_back(0xFF);
+        jpg.push_back(0xD9); // EOI
+        return jpg;
+    }
+
+    /**
+     * The parts of the stream encoder that use the types of this file.
+     */
+    class JpgStreamEncoder::State {
+    public:
+        State(const JpgEncodeDesc& desc, std::vector<U8>& output):
+        desc(desc),
+        layout(createLayout(desc)),
+        lumaQuantizers(scaleQuantizers(LUMA_QUANTIZERS, desc.quality)),
+        chromaQuantizers(scaleQuantizers(CHROMA_QUANTIZERS, desc.quality)),
+        lumaScales(getDctScales(lumaQuantizers)),
+        chromaScales(getDctScales(chromaQuantizers)),
+        encoder(this->desc, layout, lumaScales, chromaScales),
+        writer(output),
+        rowBytes(desc.width * getChannelCountFromFormat(desc.format)) {
+
+        }
+
+        const JpgEncodeDesc desc;
+        const JpgLayout layout;
+        const std::array<U8, 64> lumaQuantizers;
+        const std::array<U8, 64> chromaQuantizers;
+        const std::array<float, 64> lumaScales;
+        const std::array<float, 64> chromaScales;
+        BandEncoder encoder;
+        BitWriter writer;
+        DcPredictions predictions;
+        const Size rowBytes;
+        Size mcuRow = 0; // MCU rows written so far
+        std::vector<U8> pendingRows; // The rows of the MCU row that is not complete yet
+        Size pendingRowCount = 0;
+    };
+
+    JpgStreamEncoder::JpgStreamEncoder(const JpgEncodeDesc& desc) {
+        if (!isValidDesc(desc)) {
+            VL_THROW("Cannot encode a JPG of size ({}x{}) with format {}", desc.width, desc.height, desc.format);
+        }
+        JpgEncodeDesc streamDesc = desc;
+        streamDesc.data = nullptr;
+        streamDesc.flipVertical = false;
+        m_State = createUP<State>(streamDesc, m_Output);
+        m_State->pendingRows.resize(m_State->layout.mcuHeight * m_State->rowBytes);
+        m_Output = createHeader(streamDesc, m_State->layout, m_State->lumaQuantizers, m_State->chromaQuantizers);
+    }
+
+    JpgStreamEncoder::~JpgStreamEncoder() = default;
+
+    void JpgStreamEncoder::writeRows(const U8* rows, Size rowCount) {
+        State& state = *m_State;
+        const Size mcuHeight = state.layout.mcuHeight;
+        while (rowCount != 0) {
+            // Complete MCU rows are encoded straight from the caller's rows, only the rest is copied
+            if (state.pendingRowCount == 0 && rowCount >= mcuHeight) {
+                encodeMcuRow(rows, mcuHeight);
+                rows += mcuHeight * state.rowBytes;
+                rowCount -= mcuHeight;
+                continue;
+            }
+            const Size copyCount = std::min(rowCount, mcuHeight - state.pendingRowCount);
+            std::memcpy(state.pendingRows.data() + state.pendingRowCount * state.rowBytes, rows, copyCount * state.rowBytes);
+            state.pendingRowCount += copyCount;
+            rows += copyCount * state.rowBytes;
+            rowCount -= copyCount;
+            if (state.pendingRowCount == mcuHeight) {
+                encodeMcuRow(state.pendingRows.data(), mcuHeight);
+                state.pendingRowCount = 0;
+            }
+        }
+    }
+
+    void JpgStreamEncoder::finish() {
+        State& state = *m_State;
+        if (state.pendingRowCount != 0) {
+            encodeMcuRow(state.pendingRows.data(), state.pendingRowCount);
+            state.pendingRowCount = 0;
+        }
+        state.writer.flush();
+        m_Output.push_back(0xFF);
+        m_Output.push_back(0xD9); // EOI
+    }
+
+    void JpgStreamEncoder::encodeMcuRow(const U8* rows, const Size rowCount) {
+        State& state = *m_State;
+        // The same bands and restart markers as encodeJpg
+        if (state.mcuRow != 0 && state.mcuRow % state.layout.mcuRowsPerBand == 0) {
+            state.writer.flush();
+            m_Output.push_back(0xFF);
+            m_Output.push_back(static_cast<U8>(0xD0 + (state.mcuRow / state.layout.mcuRowsPerBand - 1) % 8));
+            state.predictions = {};
+        }
+        state.encoder.encodeMcuRow(state.writer, state.predictions, rows, static_cast<std::ptrdiff_t>(state.rowBytes), rowCount);
+        ++state.mcuRow;
+    }
+
+    bool writeJpg(const fs::path& fileName, const JpgEncodeDesc& desc) {
+        const std::vector<U8> jpg = encodeJpg(desc);
+        if (jpg.empty()) {
+            return false;
+        }
+        const FilePtr file = openFileForWriting(fileName);
+        if (!file) {
+            return false;
+        }
+        return std::fwrite(jpg.data(), 1, jpg.size(), file.get()) == jpg.size();
+    }
+
+}
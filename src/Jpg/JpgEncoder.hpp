@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+
+#include <VelyraImage/ImageDefs.hpp>
+
+namespace Velyra::Image {
+
+    struct JpgEncodeDesc {
+        const U8* data = nullptr; // Tightly packed rows
+        Size width = 0; // At most 65535
+        Size height = 0; // At most 65535
+        VL_CHANNEL_FORMAT format = VL_CHANNEL_RGB; // R and RG are written as YCbCr with zero chroma, alpha is dropped
+        bool flipVertical = false; // Write the rows in reverse order
+        U32 quality = 100; // 1 to 100, scales the quantization tables of the JPEG standard like libjpeg
+        VL_JPG_SUBSAMPLING subsampling = VL_JPG_SUBSAMPLING_444;
+        VL_SIMD_MODE simdMode = VL_SIMD_BEST; // Colour conversion and DCT kernels
+        VL_EXECUTION_POLICY executionPolicy = VL_EXECUTION_PARALLEL;
+    };
+
+    /**
+     * @brief Takes the JPG options (flip, quality, subsampling, SIMD mode and execution policy) from an ImageWriteDesc.
+     */
+    JpgEncodeDesc createJpgEncodeDesc(const ImageWriteDesc& writeDesc, const U8* data, Size width, Size height,
+        VL_CHANNEL_FORMAT format);
+
+    /**
+     * @brief Encodes an image as baseline JPEG with the standard Huffman tables, the same format as stb_image_write.
+     *        The colour conversion and the forward DCT run through the SIMD dispatch. Large images are split into bands
+     *        of MCU rows that end with a restart marker, so the bands are encoded independently on the executor. The
+     *        bands do not depend on the execution policy, neither does the output.
+     * @return The JPG file contents, empty on failure
+     */
+    std::vector<U8> encodeJpg(const JpgEncodeDesc& desc);
+
+    /**
+     * @brief Encodes the image with encodeJpg and writes it to fileName.
+     * @return True on success
+     */
+    bool writeJpg(const fs::path& fileName, const JpgEncodeDesc& desc);
+
+    /**
+     * @brief Encodes a JPG MCU row by MCU row, for writers that never hold the whole image. Only the rows of the MCU row
+     *        that is not complete yet (8 or 16 rows, depending on the subsampling) are kept between calls. The bands
+     *        and restart markers are the same as encodeJpg, so is the output. The encoded file is appended to
+     *        getOutput, which the caller drains after every call.
+     */
+    class JpgStreamEncoder {
+    public:
+        /**
+         * @param desc Dimensions, format and the options of the image, data, flipVertical and executionPolicy are
+         *        ignored. Throws if invalid.
+         */
+        explicit JpgStreamEncoder(const JpgEncodeDesc& desc);
+
+        ~JpgStreamEncoder();
+
+        void writeRows(const U8* rows, Size rowCount);
+
+        /**
+         * @brief Encodes the remaining rows and writes the end of the file, call after all rows have been written.
+         */
+        void finish();
+
+        std::vector<U8>& getOutput() { return m_Output; }
+
+    private:
+        void encodeMcuRow(const U8* rows, Size rowCount);
+
+    private:
+        class State; // The layout, band encoder and entropy coder, which are private to the encoder
+        UP<State> m_State;
+        std::vector<U8> m_Output;
+    };
+
+    /**
+     * @brief Converts RGBA pixels to the YCbCr of JFIF. Y is shifted by -128, so all planes are centred around zero
+     *        like the DCT input.
+     */
+    void convertRgbaToYcc_Scalar(const U8* rgba, Size pixelCount, float* y, float* cb, float* cr);
+
+    void convertRgbaToYcc_AVX2(const U8* rgba, Size pixelCount, float* y, float* cb, float* cr);
+
+    /**
+     * @brief Forward DCT (the AAN algorithm of stb_image_write) of an 8x8 block, followed by quantization.
+     * @param samples First sample of the block, the rows are stride floats apart
+     * @param scales Reciprocals of the quantizers multiplied with the AAN scale factors, in row major order
+     * @param coefficients Receives the quantized coefficients in row major order, rounded half away from zero
+     */
+    void forwardDct_Scalar(const float* samples, Size stride, const float* scales, I16* coefficients);
+
+    void forwardDct_AVX2(const float* samples, Size stride, const float* scales, I16* coefficients);
+
+}
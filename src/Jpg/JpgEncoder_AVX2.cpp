@@ -0,0 +1,138 @@
+#include "../Pch.hpp"
+
+#include "JpgEncoder.hpp"
+#include "../SimdTarget.hpp"
+
+/*
+ * AVX2 kernels, compiled with AVX2 enabled and only called if the CPU supports it. The arithmetic is done in the
+ * order of the scalar kernels, so both give the same results.
+ */
+
+VL_SIMD_TARGET_BEGIN("avx2")
+
+namespace Velyra::Image {
+
+    namespace {
+
+        /**
+         * The 1D AAN DCT of forwardDct_Scalar, for 8 vectors at once.
+         */
+        void forwardDct1D(__m256 (&d)[8]) {
+            const __m256 tmp0 = _mm256_add_ps(d[0], d[7]);
+            const __m256 tmp7 = _mm256_sub_ps(d[0], d[7]);
+            const __m256 tmp1 = _mm256_add_ps(d[1], d[6]);
+            const __m256 tmp6 = _mm256_sub_ps(d[1], d[6]);
+            const __m256 tmp2 = _mm256_add_ps(d[2], d[5]);
+            const __m256 tmp5 = _mm256_sub_ps(d[2], d[5]);
+            const __m256 tmp3 = _mm256_add_ps(d[3], d[4]);
+            const __m256 tmp4 = _mm256_sub_ps(d[3], d[4]);
+
+            // Even part
+            const __m256 tmp10 = _mm256_add_ps(tmp0, tmp3);
+            const __m256 tmp13 = _mm256_sub_ps(tmp0, tmp3);
+            const __m256 tmp11 = _mm256_add_ps(tmp1, tmp2);
+            const __m256 tmp12 = _mm256_sub_ps(tmp1, tmp2);
+            const __m256 z1 = _mm256_mul_ps(_mm256_add_ps(tmp12, tmp13), _mm256_set1_ps(0.707106781f));
+            d[0] = _mm256_add_ps(tmp10, tmp11);
+            d[4] = _mm256_sub_ps(tmp10, tmp11);
+            d[2] = _mm256_add_ps(tmp13, z1);
+            d[6] = _mm256_sub_ps(tmp13, z1);
+
+            // Odd part
+            const __m256 odd10 = _mm256_add_ps(tmp4, tmp5);
+            const __m256 odd11 = _mm256_add_ps(tmp5, tmp6);
+            const __m256 odd12 = _mm256_add_ps(tmp6, tmp7);
+            const __m256 z5 = _mm256_mul_ps(_mm256_sub_ps(odd10, odd12), _mm256_set1_ps(0.382683433f));
+            const __m256 z2 = _mm256_add_ps(_mm256_mul_ps(odd10, _mm256_set1_ps(0.541196100f)), z5);
+            const __m256 z4 = _mm256_add_ps(_mm256_mul_ps(odd12, _mm256_set1_ps(1.306562965f)), z5);
+            const __m256 z3 = _mm256_mul_ps(odd11, _mm256_set1_ps(0.707106781f));
+            const __m256 z11 = _mm256_add_ps(tmp7, z3);
+            const __m256 z13 = _mm256_sub_ps(tmp7, z3);
+            d[5] = _mm256_add_ps(z13, z2);
+            d[3] = _mm256_sub_ps(z13, z2);
+            d[1] = _mm256_add_ps(z11, z4);
+            d[7] = _mm256_sub_ps(z11, z4);
+        }
+
+        void transpose8x8(__m256 (&r)[8]) {
+            const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+            const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+            const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+            const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+            const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+            const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+            const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+            const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+            const __m256 s0 = _mm256_shuffle_ps(t0, t2, 0x44);
+            const __m256 s1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+            const __m256 s2 = _mm256_shuffle_ps(t1, t3, 0x44);
+            const __m256 s3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+            const __m256 s4 = _mm256_shuffle_ps(t4, t6, 0x44);
+            const __m256 s5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+            const __m256 s6 = _mm256_shuffle_ps(t5, t7, 0x44);
+            const __m256 s7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+            r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+            r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+            r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+            r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+            r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+            r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+            r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+            r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+        }
+
+        // Rounds half away from zero and truncates, like the scalar kernel
+        __m256i quantize(const __m256 value, const float* scales) {
+            const __m256 scaled = _mm256_mul_ps(value, _mm256_loadu_ps(scales));
+            const __m256 half = _mm256_or_ps(_mm256_and_ps(scaled, _mm256_set1_ps(-0.0f)), _mm256_set1_ps(0.5f));
+            return _mm256_cvttps_epi32(_mm256_add_ps(scaled, half));
+        }
+
+    }
+
+    void convertRgbaToYcc_AVX2(const U8* rgba, const Size pixelCount, float* y, float* cb, float* cr) {
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        Size i = 0;
+        for (; i + 8 <= pixelCount; i += 8) {
+            const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rgba + i * 4));
+            const __m256 r = _mm256_cvtepi32_ps(_mm256_and_si256(pixels, byteMask));
+            const __m256 g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask));
+            const __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask));
+
+            __m256 luma = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(0.29900f), r), _mm256_mul_ps(_mm256_set1_ps(0.58700f), g));
+            luma = _mm256_add_ps(luma, _mm256_mul_ps(_mm256_set1_ps(0.11400f), b));
+            _mm256_storeu_ps(y + i, _mm256_sub_ps(luma, _mm256_set1_ps(128.0f)));
+
+            __m256 blue = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(-0.16874f), r), _mm256_mul_ps(_mm256_set1_ps(0.33126f), g));
+            blue = _mm256_add_ps(blue, _mm256_mul_ps(_mm256_set1_ps(0.50000f), b));
+            _mm256_storeu_ps(cb + i, blue);
+
+            __m256 red = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(0.50000f), r), _mm256_mul_ps(_mm256_set1_ps(0.41869f), g));
+            red = _mm256_sub_ps(red, _mm256_mul_ps(_mm256_set1_ps(0.08131f), b));
+            _mm256_storeu_ps(cr + i, red);
+        }
+        convertRgbaToYcc_Scalar(rgba + i * 4, pixelCount - i, y + i, cb + i, cr + i);
+    }
+
+    void forwardDct_AVX2(const float* samples, const Size stride, const float* scales, I16* coefficients) {
+        __m256 rows[8];
+        for (Size row = 0; row < 8; ++row) {
+            rows[row] = _mm256_loadu_ps(samples + row * stride);
+        }
+        // The scalar kernel transforms the rows first, every vector holds one column after the transpose
+        transpose8x8(rows);
+        forwardDct1D(rows);
+        transpose8x8(rows);
+        forwardDct1D(rows);
+        for (Size row = 0; row < 8; row += 2) {
+            const __m256i first = quantize(rows[row], scales + row * 8);
+            const __m256i second = quantize(rows[row + 1], scales + row * 8 + 8);
+            // The pack works per 128-bit lane, the permute restores the order of the rows
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(first, second), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(coefficients + row * 8), packed);
+        }
+    }
+
+}
+
+VL_SIMD_TARGET_END
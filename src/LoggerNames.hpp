@@ -1,9 +1,30 @@
 #pragma once
 
+#include <VelyraUtils/Logging/LoggingFwd.hpp>
+
 namespace Velyra::Image {
 
-    constexpr auto LOGGER_BASE = "VL-IMG-BAS";
-    constexpr auto LOGGER_UI8  = "VL-IMG-UI8";
-    constexpr auto LOGGER_UI16 = "VL-IMG-UI16";
-    constexpr auto LOGGER_F32  = "VL-IMG-F32";
-}
\ No newline at end of file
+    inline constexpr char LOGGER_BASE[] = "VL-IMG-BAS";
+    inline constexpr char LOGGER_UI8[]  = "VL-IMG-UI8";
+    inline constexpr char LOGGER_UI16[] = "VL-IMG-UI16";
+    inline constexpr char LOGGER_F16[]  = "VL-IMG-F16";
+    inline constexpr char LOGGER_F32[]  = "VL-IMG-F32";
+
+    /**
+     * @brief Returns the logger of one of the names above. Utils::getLogger is a locked registry lookup, these
+     *        loggers are looked up once and cached for the lifetime of the program.
+     */
+    spdlog::logger* getCachedLogger(const char* loggerName);
+
+}
+
+/*
+ * Logging for code that runs once per image (creating, loading and translating images). Creating thousands of small
+ * images must not format thousands of log lines, so these calls are compiled out unless the library is built with
+ * VELYRA_IMAGE_HOT_PATH_LOGGING, in which case they log at debug level. Warnings and errors are always logged.
+ */
+#if defined(VL_IMAGE_HOT_PATH_LOGGING)
+    #define VL_IMAGE_LOG_HOT_PATH(logger, ...) SPDLOG_LOGGER_CALL(logger, spdlog::level::debug, __VA_ARGS__)
+#else
+    #define VL_IMAGE_LOG_HOT_PATH(logger, ...) (void)0
+#endif
@@ -0,0 +1,101 @@
+#include "Pch.hpp"
+
+#include "MappedFile.hpp"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Velyra::Image {
+
+    MappedFile::MappedFile(const fs::path& fileName) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileW(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr) {
+            return;
+        }
+        // The view keeps the mapping alive, so both handles can be closed right away
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (view == nullptr) {
+            return;
+        }
+        m_Data = static_cast<const std::byte*>(view);
+        m_Size = static_cast<Size>(fileSize.QuadPart);
+#else
+        const int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+            close(fd);
+            return;
+        }
+        const auto fileSize = static_cast<Size>(fileStat.st_size);
+        void* view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps the file alive, so the descriptor can be closed right away
+        close(fd);
+        if (view == MAP_FAILED) {
+            return;
+        }
+        // Decoders read the file front to back
+        madvise(view, fileSize, MADV_SEQUENTIAL);
+        m_Data = static_cast<const std::byte*>(view);
+        m_Size = fileSize;
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        unmap();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept:
+    m_Data(other.m_Data),
+    m_Size(other.m_Size) {
+        other.m_Data = nullptr;
+        other.m_Size = 0;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            m_Data = other.m_Data;
+            m_Size = other.m_Size;
+            other.m_Data = nullptr;
+            other.m_Size = 0;
+        }
+        return *this;
+    }
+
+    void MappedFile::unmap() {
+        if (m_Data == nullptr) {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(m_Data);
+#else
+        munmap(const_cast<std::byte*>(m_Data), m_Size);
+#endif
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+
+}
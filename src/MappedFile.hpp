@@ -0,0 +1,39 @@
+#pragma once
+
+#include <VelyraImage/ImageDefs.hpp>
+#include <span>
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Read-only memory mapping of a complete file. The mapping is released when the object is destroyed.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        explicit MappedFile(const fs::path& fileName);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool isValid() const { return m_Data != nullptr; }
+
+        std::span<const std::byte> getData() const { return {m_Data, m_Size}; }
+
+    private:
+        void unmap();
+
+    private:
+        const std::byte* m_Data = nullptr;
+        Size m_Size = 0;
+    };
+
+}
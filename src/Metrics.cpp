@@ -0,0 +1,88 @@
+#include "Pch.hpp"
+
+#include "Metrics.hpp"
+
+#include <atomic>
+
+namespace Velyra::Image {
+
+    namespace {
+
+        // One cache line per counter set, threads running different operations do not share lines
+        struct alignas(64) AtomicOperationMetrics {
+            std::atomic<U64> count{0};
+            std::atomic<U64> bytes{0};
+            std::atomic<U64> nanoseconds{0};
+        };
+
+        struct MetricsRegistry {
+            alignas(64) std::atomic<U64> imagesCreated{0};
+            std::array<std::array<AtomicOperationMetrics, VL_SIMD_MODE_MAX_VALUE>, VL_IMAGE_OPERATION_MAX_VALUE> operations;
+        };
+
+        // Constant initialized, so it can be used during static initialization of other translation units
+        constinit MetricsRegistry s_Registry;
+
+    }
+
+    void recordImageCreated() {
+        s_Registry.imagesCreated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void recordOperation(const VL_IMAGE_OPERATION operation, const VL_SIMD_MODE mode, const Size bytes,
+        const std::chrono::nanoseconds duration) {
+        AtomicOperationMetrics& metrics = s_Registry.operations[operation][mode];
+        metrics.count.fetch_add(1, std::memory_order_relaxed);
+        metrics.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        metrics.nanoseconds.fetch_add(static_cast<U64>(duration.count()), std::memory_order_relaxed);
+    }
+
+    ScopedOperationMetrics::ScopedOperationMetrics(const VL_IMAGE_OPERATION operation, const VL_SIMD_MODE mode, const Size bytes):
+    m_Operation(operation),
+    m_Mode(mode),
+    m_Bytes(bytes),
+    m_Start(std::chrono::steady_clock::now()) {
+
+    }
+
+    ScopedOperationMetrics::~ScopedOperationMetrics() {
+        recordOperation(m_Operation, m_Mode, m_Bytes, std::chrono::steady_clock::now() - m_Start);
+    }
+
+    OperationMetrics ImageMetrics::getTotal(const VL_IMAGE_OPERATION operation) const {
+        OperationMetrics total;
+        for (const OperationMetrics& metrics : operations[operation]) {
+            total.count += metrics.count;
+            total.bytes += metrics.bytes;
+            total.nanoseconds += metrics.nanoseconds;
+        }
+        return total;
+    }
+
+    ImageMetrics getMetrics() {
+        ImageMetrics snapshot;
+        snapshot.imagesCreated = s_Registry.imagesCreated.load(std::memory_order_relaxed);
+        for (Size operation = 0; operation < snapshot.operations.size(); ++operation) {
+            for (Size mode = 0; mode < snapshot.operations[operation].size(); ++mode) {
+                const AtomicOperationMetrics& metrics = s_Registry.operations[operation][mode];
+                OperationMetrics& target = snapshot.operations[operation][mode];
+                target.count = metrics.count.load(std::memory_order_relaxed);
+                target.bytes = metrics.bytes.load(std::memory_order_relaxed);
+                target.nanoseconds = metrics.nanoseconds.load(std::memory_order_relaxed);
+            }
+        }
+        return snapshot;
+    }
+
+    void resetMetrics() {
+        s_Registry.imagesCreated.store(0, std::memory_order_relaxed);
+        for (auto& modes : s_Registry.operations) {
+            for (AtomicOperationMetrics& metrics : modes) {
+                metrics.count.store(0, std::memory_order_relaxed);
+                metrics.bytes.store(0, std::memory_order_relaxed);
+                metrics.nanoseconds.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <VelyraImage/Metrics.hpp>
+#include <chrono>
+
+namespace Velyra::Image {
+
+    void recordImageCreated();
+
+    void recordOperation(VL_IMAGE_OPERATION operation, VL_SIMD_MODE mode, Size bytes, std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Records the duration of an operation from construction to destruction. Out of line, because the
+     *        kernel headers that use it are also included by translation units built with wider instruction sets.
+     * @param mode The SIMD mode that runs, the mode of the dispatch table rather than the requested one
+     */
+    class ScopedOperationMetrics {
+    public:
+        ScopedOperationMetrics(VL_IMAGE_OPERATION operation, VL_SIMD_MODE mode, Size bytes);
+
+        ~ScopedOperationMetrics();
+
+        ScopedOperationMetrics(const ScopedOperationMetrics&) = delete;
+
+        ScopedOperationMetrics& operator=(const ScopedOperationMetrics&) = delete;
+
+        /**
+         * @brief Sets the byte count for operations that only know it once they finished (for example decoding).
+         */
+        void setBytes(const Size bytes) {
+            m_Bytes = bytes;
+        }
+
+    private:
+        const VL_IMAGE_OPERATION m_Operation;
+        const VL_SIMD_MODE m_Mode;
+        Size m_Bytes;
+        const std::chrono::steady_clock::time_point m_Start;
+    };
+
+}
@@ -8,8 +8,10 @@
 #include <stb_image_resize2.h>
 
 #include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #include <VelyraUtils/DevUtils/Conditions.hpp>
-#include <VelyraUtils/CpuFeatures.hpp>
 
 #include <spdlog/spdlog.h>
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "../Pch.hpp"
+
+#include <VelyraImage/Pipeline.hpp>
+#include <VelyraImage/ImageFactory.hpp>
+
+#include "RowStages.hpp"
+#include "RowSinks.hpp"
+#include "../Metrics.hpp"
+
+namespace Velyra::Image {
+
+    Size RowLayout::getRowSize() const {
+        return width * getChannelCountFromFormat(format) * Utils::getTypeSize(dataType);
+    }
+
+    UP<IRowSource> RowPipeline::createImageSource(const IImage& image, const bool flipVertical) {
+        return createUP<ImageRowSource>(image, flipVertical);
+    }
+
+    UP<IRowSource> RowPipeline::createFileSource(const ImageLoadDesc& desc) {
+        return createUP<ImageRowSource>(ImageFactory::createImage(desc), false); // flipOnLoad is applied by the decode
+    }
+
+    UP<IRowSource> RowPipeline::convertToFormat(UP<IRowSource> source, const FormatConversionDesc& desc) {
+        TransformDesc transformDesc;
+        transformDesc.targetFormat = desc.targetFormat;
+        transformDesc.fillMode = desc.fillMode;
+        transformDesc.flipVertical = desc.flipVertical;
+        transformDesc.simdMode = desc.simdMode;
+        transformDesc.executionPolicy = desc.executionPolicy;
+        return createUP<TransformRowSource>(std::move(source), transformDesc);
+    }
+
+    UP<IRowSource> RowPipeline::translateDataType(UP<IRowSource> source, const TranslationDesc& desc) {
+        TransformDesc transformDesc;
+        transformDesc.targetType = desc.targetType;
+        transformDesc.simdMode = desc.simdMode;
+        transformDesc.executionPolicy = desc.executionPolicy;
+        return createUP<TransformRowSource>(std::move(source), transformDesc);
+    }
+
+    UP<IRowSource> RowPipeline::transform(UP<IRowSource> source, const TransformDesc& desc) {
+        return createUP<TransformRowSource>(std::move(source), desc);
+    }
+
+    UP<IRowSource> RowPipeline::resize(UP<IRowSource> source, const Size width, const Size height) {
+        return createUP<ResizeRowSource>(std::move(source), width, height);
+    }
+
+    UP<IRowSink> RowPipeline::createFileSink(const ImageWriteDesc& desc) {
+        switch (desc.fileType) {
+            case VL_IMAGE_PNG: return createUP<PngRowSink>(desc);
+            case VL_IMAGE_BMP: return createUP<BmpRowSink>(desc);
+            case VL_IMAGE_HDR: return createUP<HdrRowSink>(desc);
+            case VL_IMAGE_JPG: return createUP<JpgRowSink>(desc);
+            default: VL_THROW("Image: {} cannot be written to file type: {}", desc.fileName.string(), desc.fileType);
+        }
+    }
+
+    void RowPipeline::run(IRowSource& source, IRowSink& sink, const Size stripRowCount) {
+        if (stripRowCount == 0) {
+            VL_THROW("Row pipelines need at least one row per strip");
+        }
+        const RowLayout& layout = source.getLayout();
+        sink.begin(layout);
+        Size rowCount = 0;
+        for (RowStrip strip = source.readRows(stripRowCount); strip.rowCount != 0; strip = source.readRows(stripRowCount)) {
+            sink.writeRows(strip);
+            rowCount += strip.rowCount;
+        }
+        if (rowCount != layout.height) {
+            VL_THROW("Row source produced {} of {} rows", rowCount, layout.height);
+        }
+        sink.end();
+    }
+
+    void RowPipeline::write(IRowSource& source, const ImageWriteDesc& desc, const Size stripRowCount) {
+        const RowLayout& layout = source.getLayout();
+        const ScopedOperationMetrics metrics(VL_OPERATION_WRITE, VL_SIMD_BEST, layout.height * layout.getRowSize());
+        const UP<IRowSink> sink = createFileSink(desc);
+        run(source, *sink, stripRowCount);
+    }
+
+    UP<IImage> RowPipeline::toImage(IRowSource& source, const Size stripRowCount) {
+        ImageRowSink sink;
+        run(source, sink, stripRowCount);
+        return sink.getImage();
+    }
+
+}
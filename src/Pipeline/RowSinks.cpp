@@ -0,0 +1,385 @@
+#include "../Pch.hpp"
+
+#include "RowSinks.hpp"
+#include "RowStages.hpp"
+#include "../ImageU8.hpp"
+#include "../ImageU16.hpp"
+#include "../ImageF16.hpp"
+#include "../ImageF32.hpp"
+#include "../DataTypeConversion/DataTypeConversion.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Velyra::Image {
+
+    namespace {
+
+        void appendLittleEndian(std::vector<U8>& output, const U32 value, const Size byteCount) {
+            for (Size i = 0; i < byteCount; ++i) {
+                output.push_back(static_cast<U8>(value >> (8 * i)));
+            }
+        }
+
+        void checkDimensions(const RowLayout& layout, const ImageWriteDesc& desc) {
+            constexpr Size maxDimension = std::numeric_limits<I32>::max();
+            if (layout.width == 0 || layout.height == 0 || layout.width > maxDimension || layout.height > maxDimension) {
+                VL_THROW("Image: {} cannot be written with size ({}x{})", desc.fileName.string(), layout.width, layout.height);
+            }
+        }
+
+        void checkDataType(const RowLayout& layout, const ImageWriteDesc& desc, std::initializer_list<VL_TYPE> supportedTypes) {
+            if (std::find(supportedTypes.begin(), supportedTypes.end(), layout.dataType) == supportedTypes.end()) {
+                VL_THROW("Image: {} cannot be written as file type {} from data type {}", desc.fileName.string(),
+                    desc.fileType, layout.dataType);
+            }
+        }
+
+        void checkNotFlipped(const ImageWriteDesc& desc) {
+            if (desc.flipOnWrite) {
+                VL_THROW("Image: {} cannot be flipped while streaming to file type {}, use a flipped source instead",
+                    desc.fileName.string(), desc.fileType);
+            }
+        }
+
+        // Same conversion as stb_image_write, the mantissas are truncated
+        void linearToRgbe(U8* rgbe, const float red, const float green, const float blue) {
+            const float maxComponent = std::max(red, std::max(green, blue));
+            if (maxComponent < 1e-32f) {
+                rgbe[0] = rgbe[1] = rgbe[2] = rgbe[3] = 0;
+            }
+            else {
+                int exponent = 0;
+                const float normalize = std::frexp(maxComponent, &exponent) * 256.0f / maxComponent;
+                rgbe[0] = static_cast<U8>(red * normalize);
+                rgbe[1] = static_cast<U8>(green * normalize);
+                rgbe[2] = static_cast<U8>(blue * normalize);
+                rgbe[3] = static_cast<U8>(exponent + 128);
+            }
+        }
+
+    }
+
+    FileRowSink::FileRowSink(const ImageWriteDesc& desc):
+    m_Desc(desc) {
+
+    }
+
+    void FileRowSink::openFile() {
+        m_File = openFileForWriting(m_Desc.fileName);
+        if (!m_File) {
+            VL_THROW("Image: {} could not be opened for writing", m_Desc.fileName.string());
+        }
+    }
+
+    void FileRowSink::writeToFile(const void* data, const Size byteCount) {
+        if (std::fwrite(data, 1, byteCount, m_File.get()) != byteCount) {
+            VL_THROW("Image: {} failed to write", m_Desc.fileName.string());
+        }
+    }
+
+    void FileRowSink::seekFile(const U64 offset) {
+#if defined(_MSC_VER)
+        const bool success = _fseeki64(m_File.get(), static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+        const bool success = fseeko(m_File.get(), static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        if (!success) {
+            VL_THROW("Image: {} failed to seek to offset {}", m_Desc.fileName.string(), offset);
+        }
+    }
+
+    void FileRowSink::closeFile() {
+        FILE* file = m_File.release();
+        if (std::fclose(file) != 0) {
+            VL_THROW("Image: {} failed to write", m_Desc.fileName.string());
+        }
+    }
+
+    PngRowSink::PngRowSink(const ImageWriteDesc& desc):
+    FileRowSink(desc) {
+
+    }
+
+    void PngRowSink::begin(const RowLayout& layout) {
+        checkDimensions(layout, m_Desc);
+        checkDataType(layout, m_Desc, {VL_UINT8, VL_UINT16});
+        checkNotFlipped(m_Desc);
+        PngEncodeDesc encodeDesc;
+        encodeDesc.width = layout.width;
+        encodeDesc.height = layout.height;
+        encodeDesc.channelCount = getChannelCountFromFormat(layout.format);
+        encodeDesc.bitDepth = layout.dataType == VL_UINT16 ? 16 : 8;
+        encodeDesc.compressionLevel = m_Desc.compressionLevel;
+        m_Encoder = createUP<PngStreamEncoder>(encodeDesc);
+        openFile();
+        drainEncoder();
+    }
+
+    void PngRowSink::writeRows(const RowStrip& strip) {
+        m_Encoder->writeRows(strip.data, strip.rowCount);
+        drainEncoder();
+    }
+
+    void PngRowSink::end() {
+        m_Encoder->finish();
+        drainEncoder();
+        closeFile();
+    }
+
+    void PngRowSink::drainEncoder() {
+        std::vector<U8>& output = m_Encoder->getOutput();
+        writeToFile(output.data(), output.size());
+        output.clear();
+    }
+
+    BmpRowSink::BmpRowSink(const ImageWriteDesc& desc):
+    FileRowSink(desc) {
+
+    }
+
+    void BmpRowSink::begin(const RowLayout& layout) {
+        checkDimensions(layout, m_Desc);
+        checkDataType(layout, m_Desc, {VL_UINT8});
+        m_Layout = layout;
+        m_ChannelCount = getChannelCountFromFormat(layout.format);
+        const bool hasAlpha = m_ChannelCount == 4;
+        const Size pixelSize = hasAlpha ? 4 : 3;
+        const Size padding = hasAlpha ? 0 : (4 - layout.width * 3 % 4) % 4;
+        m_FileRowSize = layout.width * pixelSize + padding;
+        const U64 dataSize = static_cast<U64>(m_FileRowSize) * layout.height;
+        const U32 infoSize = hasAlpha ? 108 : 40;
+        m_HeaderSize = 14 + infoSize;
+        if (m_HeaderSize + dataSize > std::numeric_limits<U32>::max()) {
+            VL_THROW("Image: {} is too large for BMP", m_Desc.fileName.string());
+        }
+
+        std::vector<U8> header = {'B', 'M'};
+        appendLittleEndian(header, static_cast<U32>(m_HeaderSize + dataSize), 4);
+        appendLittleEndian(header, 0, 4); // Reserved
+        appendLittleEndian(header, m_HeaderSize, 4);
+        appendLittleEndian(header, infoSize, 4);
+        appendLittleEndian(header, static_cast<U32>(layout.width), 4);
+        appendLittleEndian(header, static_cast<U32>(layout.height), 4); // Positive, the rows are stored bottom to top
+        appendLittleEndian(header, 1, 2); // Planes
+        appendLittleEndian(header, hasAlpha ? 32 : 24, 2);
+        appendLittleEndian(header, hasAlpha ? 3 : 0, 4); // BI_BITFIELDS or BI_RGB
+        header.insert(header.end(), 20, 0); // Image size, resolution and palette
+        if (hasAlpha) {
+            for (const U32 mask : {0x00FF0000u, 0x0000FF00u, 0x000000FFu, 0xFF000000u}) {
+                appendLittleEndian(header, mask, 4);
+            }
+            header.insert(header.end(), 52, 0); // Color space, end points and gamma
+        }
+        openFile();
+        writeToFile(header.data(), header.size());
+    }
+
+    void BmpRowSink::writeRows(const RowStrip& strip) {
+        m_Rows.assign(strip.rowCount * m_FileRowSize, 0);
+        const Size rowSize = m_Layout.getRowSize();
+        const auto* source = static_cast<const U8*>(strip.data);
+        for (Size i = 0; i < strip.rowCount; ++i) {
+            // The strip is written as one block, bottom to top unless flipped
+            const Size blockRow = m_Desc.flipOnWrite ? i : strip.rowCount - 1 - i;
+            const U8* row = source + i * rowSize;
+            U8* target = m_Rows.data() + blockRow * m_FileRowSize;
+            for (Size x = 0; x < m_Layout.width; ++x) {
+                const U8* pixel = row + x * m_ChannelCount;
+                switch (m_ChannelCount) {
+                    case 1:
+                    case 2: {
+                        target[0] = target[1] = target[2] = pixel[0];
+                        target += 3;
+                        break;
+                    }
+                    case 3: {
+                        target[0] = pixel[2];
+                        target[1] = pixel[1];
+                        target[2] = pixel[0];
+                        target += 3;
+                        break;
+                    }
+                    default: {
+                        target[0] = pixel[2];
+                        target[1] = pixel[1];
+                        target[2] = pixel[0];
+                        target[3] = pixel[3];
+                        target += 4;
+                        break;
+                    }
+                }
+            }
+        }
+        const Size firstFileRow = m_Desc.flipOnWrite ? strip.firstRow : m_Layout.height - strip.firstRow - strip.rowCount;
+        seekFile(m_HeaderSize + static_cast<U64>(firstFileRow) * m_FileRowSize);
+        writeToFile(m_Rows.data(), m_Rows.size());
+    }
+
+    void BmpRowSink::end() {
+        closeFile();
+    }
+
+    HdrRowSink::HdrRowSink(const ImageWriteDesc& desc):
+    FileRowSink(desc) {
+
+    }
+
+    void HdrRowSink::begin(const RowLayout& layout) {
+        checkDimensions(layout, m_Desc);
+        checkDataType(layout, m_Desc, {VL_FLOAT32, VL_FLOAT16});
+        checkNotFlipped(m_Desc); // stb_image only reads top to bottom HDR files
+        m_Layout = layout;
+        m_ChannelCount = getChannelCountFromFormat(layout.format);
+        m_Components.resize(layout.width * 4);
+        if (layout.dataType == VL_FLOAT16) {
+            m_FloatRow.resize(layout.width * m_ChannelCount);
+        }
+        const std::string header = fmt::format("#?RADIANCE\n# Written by VelyraImage\nFORMAT=32-bit_rle_rgbe\n"
+            "EXPOSURE=          1.0000000000000\n\n-Y {} +X {}\n", layout.height, layout.width);
+        openFile();
+        writeToFile(header.data(), header.size());
+    }
+
+    void HdrRowSink::writeRows(const RowStrip& strip) {
+        m_Output.clear();
+        const Size rowSize = m_Layout.getRowSize();
+        const Size rowCount = m_Layout.width * m_ChannelCount;
+        const auto* source = static_cast<const U8*>(strip.data);
+        for (Size y = 0; y < strip.rowCount; ++y) {
+            const U8* row = source + y * rowSize;
+            if (m_Layout.dataType == VL_FLOAT16) {
+                TranslationDesc translationDesc;
+                translationDesc.targetType = VL_FLOAT32;
+                translationDesc.executionPolicy = VL_EXECUTION_SEQUENTIAL;
+                TranslateDataType::translateDataType<F16, float>({reinterpret_cast<const F16*>(row), rowCount},
+                    m_FloatRow, translationDesc);
+                encodeScanline(m_FloatRow.data());
+            }
+            else {
+                encodeScanline(reinterpret_cast<const float*>(row));
+            }
+        }
+        writeToFile(m_Output.data(), m_Output.size());
+    }
+
+    void HdrRowSink::end() {
+        closeFile();
+    }
+
+    void HdrRowSink::encodeScanline(const float* row) {
+        const Size width = m_Layout.width;
+        for (Size x = 0; x < width; ++x) {
+            const float* pixel = row + x * m_ChannelCount;
+            U8 rgbe[4];
+            if (m_ChannelCount >= 3) {
+                linearToRgbe(rgbe, pixel[0], pixel[1], pixel[2]);
+            }
+            else {
+                linearToRgbe(rgbe, pixel[0], pixel[0], pixel[0]);
+            }
+            for (Size c = 0; c < 4; ++c) {
+                m_Components[x + width * c] = rgbe[c];
+            }
+        }
+
+        // Run length encoding only works for widths in [8, 32768), other scanlines are stored flat
+        if (width < 8 || width >= 32768) {
+            for (Size x = 0; x < width; ++x) {
+                for (Size c = 0; c < 4; ++c) {
+                    m_Output.push_back(m_Components[x + width * c]);
+                }
+            }
+            return;
+        }
+        m_Output.insert(m_Output.end(), {2, 2, static_cast<U8>(width >> 8), static_cast<U8>(width & 0xFF)});
+        for (Size c = 0; c < 4; ++c) {
+            // Every component is encoded separately, runs of at least 3 equal bytes become (128 + length, byte)
+            const U8* component = m_Components.data() + width * c;
+            Size x = 0;
+            while (x < width) {
+                Size runStart = x;
+                while (runStart + 2 < width && !(component[runStart] == component[runStart + 1] &&
+                    component[runStart] == component[runStart + 2])) {
+                    ++runStart;
+                }
+                if (runStart + 2 >= width) {
+                    runStart = width;
+                }
+                while (x < runStart) {
+                    const Size length = std::min<Size>(runStart - x, 128);
+                    m_Output.push_back(static_cast<U8>(length));
+                    m_Output.insert(m_Output.end(), component + x, component + x + length);
+                    x += length;
+                }
+                if (runStart + 2 < width) {
+                    Size runEnd = runStart;
+                    while (runEnd < width && component[runEnd] == component[runStart]) {
+                        ++runEnd;
+                    }
+                    while (x < runEnd) {
+                        const Size length = std::min<Size>(runEnd - x, 127);
+                        m_Output.push_back(static_cast<U8>(length + 128));
+                        m_Output.push_back(component[runStart]);
+                        x += length;
+                    }
+                }
+            }
+        }
+    }
+
+    JpgRowSink::JpgRowSink(const ImageWriteDesc& desc):
+    FileRowSink(desc) {
+
+    }
+
+    void JpgRowSink::begin(const RowLayout& layout) {
+        checkDimensions(layout, m_Desc);
+        checkDataType(layout, m_Desc, {VL_UINT8});
+        checkNotFlipped(m_Desc);
+        m_Encoder = createUP<JpgStreamEncoder>(createJpgEncodeDesc(m_Desc, nullptr, layout.width, layout.height, layout.format));
+        openFile();
+        drainEncoder();
+    }
+
+    void JpgRowSink::writeRows(const RowStrip& strip) {
+        m_Encoder->writeRows(static_cast<const U8*>(strip.data), strip.rowCount);
+        drainEncoder();
+    }
+
+    void JpgRowSink::end() {
+        m_Encoder->finish();
+        drainEncoder();
+        closeFile();
+    }
+
+    void JpgRowSink::drainEncoder() {
+        std::vector<U8>& output = m_Encoder->getOutput();
+        writeToFile(output.data(), output.size());
+        output.clear();
+    }
+
+    void ImageRowSink::begin(const RowLayout& layout) {
+        m_RowSize = layout.getRowSize();
+        m_Image = visitDataType(layout.dataType, [&]<typename T>(TypeTag<T>) -> UP<IImage> {
+            if constexpr (std::is_same_v<T, U8>) {
+                return createUP<ImageU8>(layout.width, layout.height, layout.format, UNINITIALIZED);
+            }
+            else if constexpr (std::is_same_v<T, U16>) {
+                return createUP<ImageU16>(layout.width, layout.height, layout.format, UNINITIALIZED);
+            }
+            else if constexpr (std::is_same_v<T, F16>) {
+                return createUP<ImageF16>(layout.width, layout.height, layout.format, UNINITIALIZED);
+            }
+            else {
+                return createUP<ImageF32>(layout.width, layout.height, layout.format, UNINITIALIZED);
+            }
+        });
+    }
+
+    void ImageRowSink::writeRows(const RowStrip& strip) {
+        std::memcpy(static_cast<U8*>(m_Image->getData()) + strip.firstRow * m_RowSize, strip.data, strip.rowCount * m_RowSize);
+    }
+
+}
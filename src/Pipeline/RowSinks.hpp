@@ -0,0 +1,141 @@
+#pragma once
+
+#include <VelyraImage/Pipeline.hpp>
+#include <vector>
+
+#include "../ImageUtils.hpp"
+#include "../Png/PngEncoder.hpp"
+#include "../Jpg/JpgEncoder.hpp"
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Base of the sinks that write a file, opens the file in begin and checks every write.
+     */
+    class FileRowSink : public IRowSink {
+    protected:
+        explicit FileRowSink(const ImageWriteDesc& desc);
+
+        void openFile();
+
+        void writeToFile(const void* data, Size byteCount);
+
+        /**
+         * @brief Moves the write position to an absolute offset in the file.
+         */
+        void seekFile(U64 offset);
+
+        void closeFile();
+
+    protected:
+        const ImageWriteDesc m_Desc;
+        FilePtr m_File;
+    };
+
+    /**
+     * @brief Writes UINT8 and UINT16 rows as PNG with PngStreamEncoder.
+     */
+    class PngRowSink : public FileRowSink {
+    public:
+        explicit PngRowSink(const ImageWriteDesc& desc);
+
+        void begin(const RowLayout& layout) override;
+
+        void writeRows(const RowStrip& strip) override;
+
+        void end() override;
+
+    private:
+        void drainEncoder();
+
+    private:
+        UP<PngStreamEncoder> m_Encoder;
+    };
+
+    /**
+     * @brief Writes UINT8 rows as BMP with the headers and pixel layout of stb_image_write: 32-bit BGRA for 4 channels,
+     *        24-bit BGR otherwise (grey is expanded, the alpha of grey-alpha is dropped). BMP stores the rows from
+     *        bottom to top, every strip is written to its final position in the file.
+     */
+    class BmpRowSink : public FileRowSink {
+    public:
+        explicit BmpRowSink(const ImageWriteDesc& desc);
+
+        void begin(const RowLayout& layout) override;
+
+        void writeRows(const RowStrip& strip) override;
+
+        void end() override;
+
+    private:
+        RowLayout m_Layout;
+        U32 m_ChannelCount = 0;
+        U32 m_HeaderSize = 0;
+        Size m_FileRowSize = 0;
+        std::vector<U8> m_Rows;
+    };
+
+    /**
+     * @brief Writes FLOAT32 and FLOAT16 rows as Radiance HDR, with the run length encoded scanlines of stb_image_write.
+     */
+    class HdrRowSink : public FileRowSink {
+    public:
+        explicit HdrRowSink(const ImageWriteDesc& desc);
+
+        void begin(const RowLayout& layout) override;
+
+        void writeRows(const RowStrip& strip) override;
+
+        void end() override;
+
+    private:
+        void encodeScanline(const float* row);
+
+    private:
+        RowLayout m_Layout;
+        U32 m_ChannelCount = 0;
+        std::vector<float> m_FloatRow; // FLOAT16 rows are translated into this row first
+        std::vector<U8> m_Components; // The RGBE components of one scanline, one plane per component
+        std::vector<U8> m_Output;
+    };
+
+    /**
+     * @brief Writes UINT8 rows as JPG with JpgStreamEncoder, every complete MCU row is encoded and written as it
+     *        arrives.
+     */
+    class JpgRowSink : public FileRowSink {
+    public:
+        explicit JpgRowSink(const ImageWriteDesc& desc);
+
+        void begin(const RowLayout& layout) override;
+
+        void writeRows(const RowStrip& strip) override;
+
+        void end() override;
+
+    private:
+        void drainEncoder();
+
+    private:
+        UP<JpgStreamEncoder> m_Encoder;
+    };
+
+    /**
+     * @brief Collects the rows into an image of the type of the rows.
+     */
+    class ImageRowSink : public IRowSink {
+    public:
+        void begin(const RowLayout& layout) override;
+
+        void writeRows(const RowStrip& strip) override;
+
+        void end() override {}
+
+        UP<IImage> getImage() { return std::move(m_Image); }
+
+    private:
+        UP<IImage> m_Image;
+        Size m_RowSize = 0;
+    };
+
+}
@@ -0,0 +1,233 @@
+#include "../Pch.hpp"
+
+#include "RowStages.hpp"
+#include "../Metrics.hpp"
+#include "../FormatConversion/FormatConversion.hpp"
+#include "../DataTypeConversion/DataTypeConversion.hpp"
+#include "../Transform/Transform.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Velyra::Image {
+
+    stbir_datatype vlTypeToStbirType(const VL_TYPE dataType) {
+        switch (dataType) {
+            case VL_UINT8:      return STBIR_TYPE_UINT8;
+            case VL_UINT16:     return STBIR_TYPE_UINT16;
+            case VL_FLOAT16:    return STBIR_TYPE_HALF_FLOAT;
+            case VL_FLOAT32:    return STBIR_TYPE_FLOAT;
+            default:            VL_THROW("Unsupported VL_TYPE {} for stb_image_resize conversion", dataType);
+        }
+    }
+
+    ImageRowSource::ImageRowSource(const IImage& image, const bool flipVertical):
+    m_Image(image),
+    m_FlipVertical(flipVertical),
+    m_Layout{image.getWidth(), image.getHeight(), image.getChannelFormat(), image.getDataType()} {
+
+    }
+
+    ImageRowSource::ImageRowSource(UP<IImage> image, const bool flipVertical):
+    m_OwnedImage(std::move(image)),
+    m_Image(*m_OwnedImage),
+    m_FlipVertical(flipVertical),
+    m_Layout{m_Image.getWidth(), m_Image.getHeight(), m_Image.getChannelFormat(), m_Image.getDataType()} {
+
+    }
+
+    RowStrip ImageRowSource::readRows(const Size maxRowCount) {
+        RowStrip strip;
+        strip.firstRow = m_NextRow;
+        strip.rowCount = std::min(maxRowCount, m_Layout.height - m_NextRow);
+        if (strip.rowCount == 0) {
+            return strip;
+        }
+        const Size rowSize = m_Layout.getRowSize();
+        const auto* data = static_cast<const U8*>(m_Image.getData());
+        if (m_FlipVertical) {
+            m_FlippedRows.resize(strip.rowCount * rowSize);
+            for (Size i = 0; i < strip.rowCount; ++i) {
+                const Size sourceRow = m_Layout.height - 1 - (m_NextRow + i);
+                std::memcpy(m_FlippedRows.data() + i * rowSize, data + sourceRow * rowSize, rowSize);
+            }
+            strip.data = m_FlippedRows.data();
+        }
+        else {
+            strip.data = data + m_NextRow * rowSize; // The rows are already contiguous, no copy needed
+        }
+        m_NextRow += strip.rowCount;
+        return strip;
+    }
+
+    TransformRowSource::TransformRowSource(UP<IRowSource> source, const TransformDesc& desc):
+    m_Source(std::move(source)),
+    m_Desc(desc),
+    m_Layout(m_Source->getLayout()) {
+        if (m_Desc.flipVertical) {
+            VL_THROW("Row pipelines cannot flip while converting, use a flipped source instead");
+        }
+        if (m_Desc.targetFormat == VL_CHANNEL_FORMAT_MAX_VALUE) {
+            m_Desc.targetFormat = m_Layout.format;
+        }
+        if (m_Desc.targetType == VL_TYPE_MAX_VALUE) {
+            m_Desc.targetType = m_Layout.dataType;
+        }
+        if (!getSwizzle(m_Layout.format, m_Desc.targetFormat).isValid()) {
+            VL_THROW("Unsupported format conversion from {} to {}", m_Layout.format, m_Desc.targetFormat);
+        }
+        const bool hasTranslation = visitDataType(m_Layout.dataType, [&]<typename SrcType>(TypeTag<SrcType>) {
+            return visitDataType(m_Desc.targetType, [&]<typename DstType>(TypeTag<DstType>) {
+                return HAS_TRANSLATION<SrcType, DstType>;
+            });
+        });
+        if (!hasTranslation) {
+            VL_THROW("Unsupported data type translation from {} to {}", m_Layout.dataType, m_Desc.targetType);
+        }
+        m_Layout.format = m_Desc.targetFormat;
+        m_Layout.dataType = m_Desc.targetType;
+    }
+
+    RowStrip TransformRowSource::readRows(const Size maxRowCount) {
+        const RowStrip strip = m_Source->readRows(maxRowCount);
+        const RowLayout& sourceLayout = m_Source->getLayout();
+        if (strip.rowCount == 0 || (sourceLayout.format == m_Layout.format && sourceLayout.dataType == m_Layout.dataType)) {
+            return strip;
+        }
+        m_Rows.resize(strip.rowCount * m_Layout.getRowSize());
+        visitDataType(sourceLayout.dataType, [&]<typename SrcType>(TypeTag<SrcType>) {
+            visitDataType(m_Layout.dataType, [&]<typename DstType>(TypeTag<DstType>) {
+                if constexpr (HAS_TRANSLATION<SrcType, DstType>) {
+                    transformStrip<SrcType, DstType>(strip);
+                }
+            });
+        });
+        return {m_Rows.data(), strip.firstRow, strip.rowCount};
+    }
+
+    template<typename SrcType, typename DstType>
+    void TransformRowSource::transformStrip(const RowStrip& strip) {
+        const RowLayout& sourceLayout = m_Source->getLayout();
+        const Size sourceCount = strip.rowCount * sourceLayout.width * getChannelCountFromFormat(sourceLayout.format);
+        const std::span<const SrcType> source(static_cast<const SrcType*>(strip.data), sourceCount);
+        const std::span<DstType> target(reinterpret_cast<DstType*>(m_Rows.data()), m_Rows.size() / sizeof(DstType));
+        if constexpr (std::is_same_v<SrcType, DstType>) {
+            FormatConversionDesc conversionDesc;
+            conversionDesc.targetFormat = m_Desc.targetFormat;
+            conversionDesc.fillMode = m_Desc.fillMode;
+            conversionDesc.simdMode = m_Desc.simdMode;
+            conversionDesc.executionPolicy = m_Desc.executionPolicy;
+            convertFormat<SrcType>(sourceLayout.format, source, target, conversionDesc);
+        }
+        else if (sourceLayout.format == m_Layout.format) {
+            TranslationDesc translationDesc;
+            translationDesc.targetType = m_Desc.targetType;
+            translationDesc.simdMode = m_Desc.simdMode;
+            translationDesc.executionPolicy = m_Desc.executionPolicy;
+            TranslateDataType::translateDataType<SrcType, DstType>(source, target, translationDesc);
+        }
+        else {
+            transformPixels<SrcType, DstType>(sourceLayout.format, sourceLayout.width, strip.rowCount, source, target, m_Desc);
+        }
+    }
+
+    ResizeRowSource::ResizeRowSource(UP<IRowSource> source, const Size width, const Size height):
+    m_Source(std::move(source)),
+    m_SourceLayout(m_Source->getLayout()),
+    m_Layout(m_SourceLayout),
+    m_Table(getDispatchTable(VL_SIMD_BEST)),
+    m_PixelLayout(vlFormatToStbirFormat(m_SourceLayout.format)),
+    m_DataType(vlTypeToStbirType(m_SourceLayout.dataType)) {
+        constexpr Size maxDimension = std::numeric_limits<int>::max();
+        if (width == 0 || height == 0 || width > maxDimension || height > maxDimension || m_SourceLayout.width == 0 ||
+            m_SourceLayout.height == 0 || m_SourceLayout.width > maxDimension || m_SourceLayout.height > maxDimension) {
+            VL_THROW("Rows cannot be resized from ({}x{}) to ({}x{})", m_SourceLayout.width, m_SourceLayout.height, width, height);
+        }
+        m_Layout.width = width;
+        m_Layout.height = height;
+        m_ErrorRow.resize(m_SourceLayout.getRowSize());
+    }
+
+    RowStrip ResizeRowSource::readRows(const Size maxRowCount) {
+        RowStrip strip;
+        strip.firstRow = m_NextRow;
+        strip.rowCount = std::min(maxRowCount, m_Layout.height - m_NextRow);
+        if (strip.rowCount == 0) {
+            return strip;
+        }
+
+        // Drop the input rows that neither this strip nor any later one can reach
+        const Size sourceRowSize = m_SourceLayout.getRowSize();
+        const Size firstInputRow = getFirstInputRow(m_NextRow);
+        if (firstInputRow > m_WindowFirstRow) {
+            const Size dropCount = std::min(firstInputRow - m_WindowFirstRow, m_WindowRowCount);
+            m_Window.erase(m_Window.begin(), m_Window.begin() + static_cast<std::ptrdiff_t>(dropCount * sourceRowSize));
+            m_WindowFirstRow += dropCount;
+            m_WindowRowCount -= dropCount;
+        }
+
+        m_PullRowCount = maxRowCount;
+        m_PulledBytes = 0;
+        m_Rows.resize(strip.rowCount * m_Layout.getRowSize());
+        ScopedOperationMetrics metrics(VL_OPERATION_RESIZE, m_Table.mode, 0);
+        const int result = m_Table.resizeRows(static_cast<int>(m_SourceLayout.width), static_cast<int>(m_SourceLayout.height),
+            static_cast<int>(m_Layout.width), static_cast<int>(m_Layout.height), static_cast<int>(m_NextRow),
+            static_cast<int>(strip.rowCount), m_PixelLayout, m_DataType, &readInputRow, this, m_Rows.data());
+        metrics.setBytes(m_PulledBytes + m_Rows.size());
+        if (m_Error) {
+            std::rethrow_exception(std::exchange(m_Error, nullptr));
+        }
+        if (result == 0) {
+            VL_THROW("Failed to resize rows {} to {} from ({}x{}) to ({}x{})", m_NextRow, m_NextRow + strip.rowCount,
+                m_SourceLayout.width, m_SourceLayout.height, m_Layout.width, m_Layout.height);
+        }
+        strip.data = m_Rows.data();
+        m_NextRow += strip.rowCount;
+        return strip;
+    }
+
+    const void* ResizeRowSource::readInputRow(void*, const void*, int, const int x, const int y, void* context) {
+        auto* stage = static_cast<ResizeRowSource*>(context);
+        if (!stage->m_Error) {
+            try {
+                const Size pixelSize = stage->m_SourceLayout.getRowSize() / stage->m_SourceLayout.width;
+                return stage->getInputRow(static_cast<Size>(y)) + static_cast<Size>(x) * pixelSize;
+            }
+            catch (...) {
+                stage->m_Error = std::current_exception();
+            }
+        }
+        return stage->m_ErrorRow.data();
+    }
+
+    const U8* ResizeRowSource::getInputRow(const Size row) {
+        if (row < m_WindowFirstRow) {
+            VL_THROW("Resize read input row {} after it was dropped", row);
+        }
+        const Size rowSize = m_SourceLayout.getRowSize();
+        while (row >= m_WindowFirstRow + m_WindowRowCount) {
+            const RowStrip strip = m_Source->readRows(m_PullRowCount);
+            if (strip.rowCount == 0) {
+                VL_THROW("Row source ended after {} of {} rows", m_WindowFirstRow + m_WindowRowCount, m_SourceLayout.height);
+            }
+            const auto* data = static_cast<const U8*>(strip.data);
+            const Size byteCount = strip.rowCount * rowSize;
+            m_Window.insert(m_Window.end(), data, data + byteCount);
+            m_WindowRowCount += strip.rowCount;
+            m_PulledBytes += byteCount;
+        }
+        return m_Window.data() + (row - m_WindowFirstRow) * rowSize;
+    }
+
+    Size ResizeRowSource::getFirstInputRow(const Size outputRow) const {
+        // The default filters reach 2 pixels from the center, measured in output pixels when downsampling. Two more
+        // rows cover the rounding of the filter extents in stb_image_resize2.
+        const double scale = static_cast<double>(m_SourceLayout.height) / static_cast<double>(m_Layout.height);
+        const double center = (static_cast<double>(outputRow) + 0.5) * scale - 0.5;
+        const double radius = 2.0 * std::max(scale, 1.0);
+        const double firstRow = std::floor(center - radius) - 2.0;
+        return firstRow > 0.0 ? static_cast<Size>(firstRow) : 0;
+    }
+
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <VelyraImage/Pipeline.hpp>
+#include <VelyraUtils/DevUtils/Conditions.hpp>
+#include <exception>
+#include <vector>
+
+#include "../ImageUtils.hpp"
+#include "../SimdDispatch.hpp"
+
+namespace Velyra::Image {
+
+    template<typename T>
+    struct TypeTag {
+        using Type = T;
+    };
+
+    /**
+     * @brief Calls function with the TypeTag of the C++ type that stores dataType, throws for types without images.
+     */
+    template<typename Function>
+    decltype(auto) visitDataType(const VL_TYPE dataType, Function&& function) {
+        switch (dataType) {
+            case VL_UINT8: return function(TypeTag<U8>{});
+            case VL_UINT16: return function(TypeTag<U16>{});
+            case VL_FLOAT16: return function(TypeTag<F16>{});
+            case VL_FLOAT32: return function(TypeTag<float>{});
+            default: VL_THROW("Unsupported data type for row pipelines: {}", dataType);
+        }
+    }
+
+    /**
+     * @brief True if the dispatch table has a translation from SrcType to DstType (or both are the same).
+     */
+    template<typename SrcType, typename DstType>
+    inline constexpr bool HAS_TRANSLATION = std::is_same_v<SrcType, DstType> ||
+        !((std::is_same_v<SrcType, U16> && std::is_same_v<DstType, F16>) || (std::is_same_v<SrcType, F16> && std::is_same_v<DstType, U16>));
+
+    stbir_datatype vlTypeToStbirType(VL_TYPE dataType);
+
+    class ImageRowSource : public IRowSource {
+    public:
+        ImageRowSource(const IImage& image, bool flipVertical);
+
+        /**
+         * @brief Reads the rows of an image owned by the source.
+         */
+        ImageRowSource(UP<IImage> image, bool flipVertical);
+
+        const RowLayout& getLayout() const override { return m_Layout; }
+
+        RowStrip readRows(Size maxRowCount) override;
+
+    private:
+        UP<IImage> m_OwnedImage;
+        const IImage& m_Image;
+        const bool m_FlipVertical;
+        RowLayout m_Layout;
+        Size m_NextRow = 0;
+        std::vector<U8> m_FlippedRows;
+    };
+
+    /**
+     * @brief Converts the format and the type of every strip. Uses convertFormat if only the format changes,
+     *        translateDataType if only the type changes and transformPixels if both change.
+     */
+    class TransformRowSource : public IRowSource {
+    public:
+        /**
+         * @param desc Unset fields keep the format or type of the source, flipVertical must be false
+         */
+        TransformRowSource(UP<IRowSource> source, const TransformDesc& desc);
+
+        const RowLayout& getLayout() const override { return m_Layout; }
+
+        RowStrip readRows(Size maxRowCount) override;
+
+    private:
+        template<typename SrcType, typename DstType>
+        void transformStrip(const RowStrip& strip);
+
+    private:
+        UP<IRowSource> m_Source;
+        TransformDesc m_Desc;
+        RowLayout m_Layout;
+        std::vector<U8> m_Rows;
+    };
+
+    /**
+     * @brief Resizes strip by strip with the resizeRows function of the dispatch table. The input rows are pulled from
+     *        the source when stb_image_resize2 asks for them and kept in a window, rows that no later output row can
+     *        reach are dropped before every strip.
+     */
+    class ResizeRowSource : public IRowSource {
+    public:
+        ResizeRowSource(UP<IRowSource> source, Size width, Size height);
+
+        const RowLayout& getLayout() const override { return m_Layout; }
+
+        RowStrip readRows(Size maxRowCount) override;
+
+    private:
+        static const void* readInputRow(void* optionalOutput, const void* inputPointer, int pixelCount, int x, int y, void* context);
+
+        const U8* getInputRow(Size row);
+
+        /**
+         * @return The first input row that the filter can read for output row outputRow (or any row below it)
+         */
+        Size getFirstInputRow(Size outputRow) const;
+
+    private:
+        UP<IRowSource> m_Source;
+        const RowLayout m_SourceLayout;
+        RowLayout m_Layout;
+        const SimdDispatchTable& m_Table;
+        const stbir_pixel_layout m_PixelLayout;
+        const stbir_datatype m_DataType;
+
+        std::vector<U8> m_Window; // Input rows [m_WindowFirstRow, m_WindowFirstRow + m_WindowRowCount)
+        Size m_WindowFirstRow = 0;
+        Size m_WindowRowCount = 0;
+        Size m_PullRowCount = 0;
+        Size m_PulledBytes = 0;
+        std::vector<U8> m_ErrorRow; // Handed to stb_image_resize2 once reading a row failed
+
+        std::vector<U8> m_Rows;
+        Size m_NextRow = 0;
+        std::exception_ptr m_Error; // Exceptions cannot pass through stb_image_resize2, they are rethrown after it returns
+    };
+
+}
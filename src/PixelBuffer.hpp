@@ -0,0 +1,198 @@
+#pragma once
+
+#include <VelyraUtils/Types/Types.hpp>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Allocator that default-initializes elements instead of value-initializing them.
+     *        For pixel types this means resize() leaves the new elements uninitialized, so buffers that are fully
+     *        overwritten afterwards are not written twice.
+     */
+    template<typename T, typename A = std::allocator<T>>
+    class DefaultInitAllocator: public A {
+        using Traits = std::allocator_traits<A>;
+    public:
+        template<typename U>
+        struct rebind {
+            using other = DefaultInitAllocator<U, typename Traits::template rebind_alloc<U>>;
+        };
+
+        using A::A;
+
+        template<typename U>
+        void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+            ::new(static_cast<void*>(ptr)) U;
+        }
+
+        template<typename U, typename... Args>
+        void construct(U* ptr, Args&&... args) {
+            Traits::construct(static_cast<A&>(*this), ptr, std::forward<Args>(args)...);
+        }
+    };
+
+    /**
+     * @brief Tag to request a buffer (or image) whose contents are left uninitialized.
+     *        Only use this when every element is written before it is read.
+     */
+    struct UninitializedTag {
+        explicit UninitializedTag() = default;
+    };
+
+    inline constexpr UninitializedTag UNINITIALIZED{};
+
+    /**
+     * @brief Contiguous pixel storage of an image.
+     *        The buffer is either owned by the library, or adopted from somewhere else (for example a buffer returned
+     *        by stb_image, a memory mapping or a pool) together with the deleter that releases it. Adopting a buffer
+     *        does not copy it. Copying a PixelBuffer always produces an owned copy.
+     */
+    template<typename T>
+    class PixelBuffer {
+    public:
+        using Deleter = std::function<void(T*)>;
+
+        PixelBuffer() = default;
+
+        PixelBuffer(const Size count, UninitializedTag):
+        m_Owned(count),
+        m_Data(m_Owned.data()),
+        m_Count(count) {
+
+        }
+
+        PixelBuffer(const Size count, const T value):
+        m_Owned(count, value),
+        m_Data(m_Owned.data()),
+        m_Count(count) {
+
+        }
+
+        PixelBuffer(const T* data, const Size count):
+        m_Owned(data, data + count),
+        m_Data(m_Owned.data()),
+        m_Count(count) {
+
+        }
+
+        PixelBuffer(const PixelBuffer& other):
+        PixelBuffer(other.m_Data, other.m_Count) {
+
+        }
+
+        PixelBuffer(PixelBuffer&& other) noexcept {
+            moveFrom(other);
+        }
+
+        ~PixelBuffer() {
+            releaseAdopted();
+        }
+
+        PixelBuffer& operator=(const PixelBuffer& other) {
+            if (this != &other) {
+                assign(other.m_Data, other.m_Count);
+            }
+            return *this;
+        }
+
+        PixelBuffer& operator=(PixelBuffer&& other) noexcept {
+            if (this != &other) {
+                releaseAdopted();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Takes ownership of a foreign buffer without copying it.
+         * @param data Buffer holding at least count elements
+         * @param count Number of elements in the buffer
+         * @param deleter Called with data once the buffer is no longer needed
+         */
+        static PixelBuffer adopt(T* data, const Size count, Deleter deleter) {
+            PixelBuffer buffer;
+            buffer.m_Data = data;
+            buffer.m_Count = count;
+            buffer.m_Deleter = std::move(deleter);
+            return buffer;
+        }
+
+        /**
+         * @brief Replaces the contents with an owned buffer of count elements.
+         *        The previous contents are not preserved and new elements are left uninitialized.
+         */
+        void resize(const Size count) {
+            releaseAdopted();
+            m_Owned.resize(count);
+            m_Data = m_Owned.data();
+            m_Count = count;
+        }
+
+        /**
+         * @brief Replaces the contents with an owned copy of the given data.
+         */
+        void assign(const T* data, const Size count) {
+            releaseAdopted();
+            m_Owned.assign(data, data + count);
+            m_Data = m_Owned.data();
+            m_Count = count;
+        }
+
+        T* data() { return m_Data; }
+
+        const T* data() const { return m_Data; }
+
+        Size size() const { return m_Count; }
+
+        bool empty() const { return m_Count == 0; }
+
+        /**
+         * @return True if the buffer was adopted and is released by a custom deleter
+         */
+        bool isAdopted() const { return static_cast<bool>(m_Deleter); }
+
+        T* begin() { return m_Data; }
+
+        T* end() { return m_Data + m_Count; }
+
+        const T* begin() const { return m_Data; }
+
+        const T* end() const { return m_Data + m_Count; }
+
+        T& operator[](const Size index) { return m_Data[index]; }
+
+        const T& operator[](const Size index) const { return m_Data[index]; }
+
+    private:
+        void releaseAdopted() {
+            if (m_Deleter) {
+                m_Deleter(m_Data);
+                m_Deleter = nullptr;
+                m_Data = nullptr;
+                m_Count = 0;
+            }
+        }
+
+        void moveFrom(PixelBuffer& other) {
+            // Moving a vector keeps its allocation, so m_Data stays valid for owned buffers as well
+            m_Owned = std::move(other.m_Owned);
+            m_Data = other.m_Data;
+            m_Count = other.m_Count;
+            m_Deleter = std::move(other.m_Deleter);
+            other.m_Data = nullptr;
+            other.m_Count = 0;
+            other.m_Deleter = nullptr;
+        }
+
+    private:
+        std::vector<T, DefaultInitAllocator<T>> m_Owned;
+        T* m_Data = nullptr;
+        Size m_Count = 0;
+        Deleter m_Deleter;
+    };
+
+}
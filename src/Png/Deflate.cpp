@@ -0,0 +1,388 @@
+#include "../Pch.hpp"
+
+#include "Deflate.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace Velyra::Image {
+
+    namespace {
+
+        constexpr Size WINDOW_SIZE = 32768;
+        constexpr Size MIN_MATCH = 3;
+        constexpr Size MAX_MATCH = 258;
+        constexpr U32 HASH_BITS = 15;
+        constexpr Size MAX_STORED_BLOCK = 65535;
+        constexpr U32 ADLER_MODULUS = 65521;
+
+        struct LevelConfig {
+            Size maxChainLength; // Longest hash chain searched for a match
+            Size niceLength; // A match of this length ends the search
+            bool lazy; // Check if the match at the next byte is longer before a match is emitted
+        };
+
+        // Level 0 stores the data, the higher levels trade speed for size like the levels of zlib
+        constexpr std::array<LevelConfig, 10> LEVEL_CONFIGS = {{
+            {0, 0, false}, {4, 8, false}, {6, 16, false}, {8, 32, false}, {8, 16, true}, {12, 32, true},
+            {16, 64, true}, {24, 128, true}, {32, 258, true}, {128, 258, true}
+        }};
+
+        constexpr std::array<U16, 29> LENGTH_BASE = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+        };
+        constexpr std::array<U8, 29> LENGTH_EXTRA_BITS = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+        };
+        constexpr std::array<U16, 30> DISTANCE_BASE = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+            6145, 8193, 12289, 16385, 24577
+        };
+        constexpr std::array<U8, 30> DISTANCE_EXTRA_BITS = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+        };
+
+        constexpr U32 reverseBits(U32 value, const U32 count) {
+            U32 reversed = 0;
+            for (U32 i = 0; i < count; ++i) {
+                reversed = (reversed << 1) | (value & 1);
+                value >>= 1;
+            }
+            return reversed;
+        }
+
+        struct HuffmanCode {
+            U16 bits; // Already reversed, DEFLATE writes Huffman codes starting with the most significant bit
+            U8 length;
+        };
+
+        // Fixed literal/length code of RFC 1951 section 3.2.6
+        constexpr auto FIXED_LITERAL_CODES = [] {
+            std::array<HuffmanCode, 288> codes{};
+            for (U32 symbol = 0; symbol < codes.size(); ++symbol) {
+                U32 code = 0;
+                U32 length = 0;
+                if (symbol < 144) {
+                    code = 0x30 + symbol;
+                    length = 8;
+                }
+                else if (symbol < 256) {
+                    code = 0x190 + symbol - 144;
+                    length = 9;
+                }
+                else if (symbol < 280) {
+                    code = symbol - 256;
+                    length = 7;
+                }
+                else {
+                    code = 0xC0 + symbol - 280;
+                    length = 8;
+                }
+                codes[symbol] = {static_cast<U16>(reverseBits(code, length)), static_cast<U8>(length)};
+            }
+            return codes;
+        }();
+
+        // Index into LENGTH_BASE for every match length
+        constexpr auto LENGTH_CODES = [] {
+            std::array<U8, MAX_MATCH + 1> codes{};
+            for (Size length = MIN_MATCH; length <= MAX_MATCH; ++length) {
+                Size code = 0;
+                while (code + 1 < LENGTH_BASE.size() && LENGTH_BASE[code + 1] <= length) {
+                    ++code;
+                }
+                codes[length] = static_cast<U8>(code);
+            }
+            return codes;
+        }();
+
+        U32 getDistanceCode(const Size distance) {
+            U32 code = 0;
+            while (code + 1 < DISTANCE_BASE.size() && DISTANCE_BASE[code + 1] <= distance) {
+                ++code;
+            }
+            return code;
+        }
+
+        /**
+         * Number of equal leading bytes of a and b, at most maxLength. Compares 8 bytes at a time, on little endian
+         * CPUs the first differing byte is the lowest non-zero byte of the difference.
+         */
+        Size getMatchLength(const U8* a, const U8* b, const Size maxLength) {
+            Size length = 0;
+            if constexpr (std::endian::native == std::endian::little) {
+                for (; length + sizeof(U64) <= maxLength; length += sizeof(U64)) {
+                    U64 wordA;
+                    U64 wordB;
+                    std::memcpy(&wordA, a + length, sizeof(U64));
+                    std::memcpy(&wordB, b + length, sizeof(U64));
+                    if (const U64 difference = wordA ^ wordB; difference != 0) {
+                        return length + static_cast<Size>(std::countr_zero(difference)) / 8;
+                    }
+                }
+            }
+            while (length < maxLength && a[length] == b[length]) {
+                ++length;
+            }
+            return length;
+        }
+
+        U32 hash3(const U8* data) {
+            const U32 value = static_cast<U32>(data[0]) << 16 | static_cast<U32>(data[1]) << 8 | data[2];
+            return (value * 2654435761u) >> (32 - HASH_BITS);
+        }
+
+    }
+
+    DeflateEncoder::DeflateEncoder(const U32 level):
+    m_Level(std::min<U32>(level, 9)),
+    m_MaxChainLength(LEVEL_CONFIGS[m_Level].maxChainLength),
+    m_NiceLength(LEVEL_CONFIGS[m_Level].niceLength),
+    m_Lazy(LEVEL_CONFIGS[m_Level].lazy) {
+        if (m_Level != 0) {
+            m_Head.assign(Size{1} << HASH_BITS, 0);
+            m_Previous.assign(WINDOW_SIZE, 0);
+        }
+    }
+
+    void DeflateEncoder::setDictionary(std::span<const U8> dictionary) {
+        if (m_Position != 0 || !m_Buffer.empty()) {
+            VL_THROW("The deflate dictionary has to be set before any data is written");
+        }
+        dictionary = dictionary.last(std::min(dictionary.size(), WINDOW_SIZE));
+        m_Buffer.assign(dictionary.begin(), dictionary.end());
+        m_Position = dictionary.size();
+        if (m_Level != 0) {
+            for (Size position = 0; position < m_Position; ++position) {
+                insertHash(position);
+            }
+        }
+    }
+
+    void DeflateEncoder::write(const std::span<const U8> data) {
+        m_Buffer.insert(m_Buffer.end(), data.begin(), data.end());
+        compress(false);
+    }
+
+    void DeflateEncoder::flush() {
+        compress(true);
+        endFixedBlock();
+        // Empty stored block: BFINAL = 0, BTYPE = 00, LEN = 0, NLEN = 0xFFFF
+        writeBits(0, 3);
+        alignToByte();
+        m_Output.insert(m_Output.end(), {0x00, 0x00, 0xFF, 0xFF});
+    }
+
+    void DeflateEncoder::finish() {
+        compress(true);
+        endFixedBlock();
+        // Empty final block with fixed codes: BFINAL = 1, BTYPE = 01, end of block
+        writeBits(1, 1);
+        writeBits(1, 2);
+        writeBits(FIXED_LITERAL_CODES[256].bits, FIXED_LITERAL_CODES[256].length);
+        alignToByte();
+    }
+
+    void DeflateEncoder::compress(const bool all) {
+        const Size end = m_BufferStart + m_Buffer.size();
+        if (m_Level == 0) {
+            // Without compression the stored blocks are written as soon as a full block is available
+            const Size available = end - m_Position;
+            const Size storedCount = all ? available : available - available % MAX_STORED_BLOCK;
+            if (storedCount != 0) {
+                storeBlocks({m_Buffer.data() + (m_Position - m_BufferStart), storedCount}, false);
+                m_Position += storedCount;
+            }
+        }
+        else {
+            // Keep MAX_MATCH bytes of lookahead unless all data has to be compressed
+            const Size limit = all ? end : (end > MAX_MATCH ? end - MAX_MATCH : 0);
+            Size length = 0;
+            Size distance = 0;
+            bool matchFound = false; // The match at m_Position was already found by the lazy check
+            while (m_Position < limit) {
+                if (!matchFound) {
+                    length = findMatch(m_Position, end, distance);
+                }
+                matchFound = false;
+                insertHash(m_Position);
+                if (m_Lazy && length >= MIN_MATCH && length < m_NiceLength && m_Position + 1 < limit) {
+                    // Lazy matching: emit a literal if the match starting at the next byte is longer
+                    Size nextDistance = 0;
+                    const Size nextLength = findMatch(m_Position + 1, end, nextDistance);
+                    if (nextLength > length) {
+                        writeLiteral(m_Buffer[m_Position - m_BufferStart]);
+                        ++m_Position;
+                        length = nextLength;
+                        distance = nextDistance;
+                        matchFound = true;
+                        continue;
+                    }
+                }
+                if (length >= MIN_MATCH) {
+                    writeMatch(length, distance);
+                    for (Size i = 1; i < length; ++i) {
+                        insertHash(m_Position + i);
+                    }
+                    m_Position += length;
+                }
+                else {
+                    writeLiteral(m_Buffer[m_Position - m_BufferStart]);
+                    ++m_Position;
+                }
+            }
+        }
+
+        // Drop the data that is neither pending nor part of the window
+        const Size keepFrom = m_Position > WINDOW_SIZE ? m_Position - WINDOW_SIZE : 0;
+        if (keepFrom > m_BufferStart && keepFrom - m_BufferStart >= WINDOW_SIZE) {
+            m_Buffer.erase(m_Buffer.begin(), m_Buffer.begin() + static_cast<std::ptrdiff_t>(keepFrom - m_BufferStart));
+            m_BufferStart = keepFrom;
+        }
+    }
+
+    void DeflateEncoder::storeBlocks(std::span<const U8> data, const bool final) {
+        endFixedBlock();
+        while (!data.empty()) {
+            const Size count = std::min(data.size(), MAX_STORED_BLOCK);
+            writeBits(final && count == data.size() ? 1 : 0, 1);
+            writeBits(0, 2);
+            alignToByte();
+            const auto length = static_cast<U16>(count);
+            m_Output.insert(m_Output.end(), {static_cast<U8>(length), static_cast<U8>(length >> 8),
+                static_cast<U8>(~length), static_cast<U8>(~length >> 8)});
+            m_Output.insert(m_Output.end(), data.begin(), data.begin() + static_cast<std::ptrdiff_t>(count));
+            data = data.subspan(count);
+        }
+    }
+
+    void DeflateEncoder::beginFixedBlock() {
+        if (!m_BlockOpen) {
+            writeBits(0, 1); // BFINAL = 0, the stream is ended by finish
+            writeBits(1, 2); // BTYPE = 01, fixed Huffman codes
+            m_BlockOpen = true;
+        }
+    }
+
+    void DeflateEncoder::endFixedBlock() {
+        if (m_BlockOpen) {
+            writeBits(FIXED_LITERAL_CODES[256].bits, FIXED_LITERAL_CODES[256].length);
+            m_BlockOpen = false;
+        }
+    }
+
+    void DeflateEncoder::writeLiteral(const U8 value) {
+        beginFixedBlock();
+        writeBits(FIXED_LITERAL_CODES[value].bits, FIXED_LITERAL_CODES[value].length);
+    }
+
+    void DeflateEncoder::writeMatch(const Size length, const Size distance) {
+        beginFixedBlock();
+        const U8 lengthCode = LENGTH_CODES[length];
+        const HuffmanCode& code = FIXED_LITERAL_CODES[257 + lengthCode];
+        writeBits(code.bits, code.length);
+        writeBits(static_cast<U32>(length - LENGTH_BASE[lengthCode]), LENGTH_EXTRA_BITS[lengthCode]);
+        const U32 distanceCode = getDistanceCode(distance);
+        writeBits(reverseBits(distanceCode, 5), 5);
+        writeBits(static_cast<U32>(distance - DISTANCE_BASE[distanceCode]), DISTANCE_EXTRA_BITS[distanceCode]);
+    }
+
+    void DeflateEncoder::writeBits(const U32 bits, const U32 count) {
+        m_BitBuffer |= static_cast<U64>(bits) << m_BitCount;
+        m_BitCount += count;
+        // Bits are written 32 at a time, count is at most 16 so the buffer never overflows
+        if (m_BitCount >= 32) {
+            const Size size = m_Output.size();
+            m_Output.resize(size + 4);
+            U8* output = m_Output.data() + size;
+            output[0] = static_cast<U8>(m_BitBuffer);
+            output[1] = static_cast<U8>(m_BitBuffer >> 8);
+            output[2] = static_cast<U8>(m_BitBuffer >> 16);
+            output[3] = static_cast<U8>(m_BitBuffer >> 24);
+            m_BitBuffer >>= 32;
+            m_BitCount -= 32;
+        }
+    }
+
+    void DeflateEncoder::alignToByte() {
+        m_BitCount = (m_BitCount + 7) & ~7u;
+        while (m_BitCount != 0) {
+            m_Output.push_back(static_cast<U8>(m_BitBuffer));
+            m_BitBuffer >>= 8;
+            m_BitCount -= 8;
+        }
+    }
+
+    void DeflateEncoder::insertHash(const Size position) {
+        if (position + MIN_MATCH > m_BufferStart + m_Buffer.size()) {
+            return;
+        }
+        const U32 hash = hash3(m_Buffer.data() + (position - m_BufferStart));
+        m_Previous[position % WINDOW_SIZE] = m_Head[hash];
+        m_Head[hash] = position + 1;
+    }
+
+    Size DeflateEncoder::findMatch(const Size position, const Size end, Size& distance) const {
+        if (position + MIN_MATCH > end) {
+            return 0;
+        }
+        const U8* current = m_Buffer.data() + (position - m_BufferStart);
+        const Size maxLength = std::min(MAX_MATCH, end - position);
+        Size bestLength = MIN_MATCH - 1;
+        Size entry = m_Head[hash3(current)];
+        for (Size chain = 0; chain < m_MaxChainLength && entry != 0; ++chain) {
+            const Size candidate = entry - 1;
+            if (candidate >= position || position - candidate > WINDOW_SIZE || candidate < m_BufferStart) {
+                break;
+            }
+            const U8* match = m_Buffer.data() + (candidate - m_BufferStart);
+            // Only compare the whole match if it can beat the best one
+            if (match[bestLength] == current[bestLength]) {
+                const Size length = getMatchLength(match, current, maxLength);
+                if (length > bestLength) {
+                    bestLength = length;
+                    distance = position - candidate;
+                    if (length >= std::min(maxLength, m_NiceLength)) {
+                        break;
+                    }
+                }
+            }
+            const Size next = m_Previous[candidate % WINDOW_SIZE];
+            if (next == 0 || next - 1 >= candidate) {
+                break; // The slot was reused by a newer position, the rest of the chain left the window
+            }
+            entry = next;
+        }
+        return bestLength >= MIN_MATCH ? bestLength : 0;
+    }
+
+    U32 updateAdler32(const U32 adler, std::span<const U8> data) {
+        // 5552 is the largest n for which 255 * n * (n + 1) / 2 + (n + 1) * 65520 fits in 32 bits
+        constexpr Size maxBlock = 5552;
+        U32 a = adler & 0xFFFF;
+        U32 b = adler >> 16;
+        while (!data.empty()) {
+            const Size count = std::min(data.size(), maxBlock);
+            for (Size i = 0; i < count; ++i) {
+                a += data[i];
+                b += a;
+            }
+            a %= ADLER_MODULUS;
+            b %= ADLER_MODULUS;
+            data = data.subspan(count);
+        }
+        return b << 16 | a;
+    }
+
+    U32 combineAdler32(const U32 first, const U32 second, const Size secondLength) {
+        // The sum of the second piece starts at the sum of the first one instead of 1, which adds the first sum to
+        // every step of the second piece: b = b1 + b2 + length2 * (a1 - 1) and a = a1 + a2 - 1
+        const U64 length = secondLength % ADLER_MODULUS;
+        const U64 firstA = first & 0xFFFF;
+        const U64 firstB = first >> 16;
+        const U64 a = (firstA + (second & 0xFFFF) + ADLER_MODULUS - 1) % ADLER_MODULUS;
+        const U64 b = (firstB + (second >> 16) + length * firstA + ADLER_MODULUS - length) % ADLER_MODULUS;
+        return static_cast<U32>(b << 16 | a);
+    }
+
+}
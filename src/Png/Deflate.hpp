@@ -0,0 +1,106 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <VelyraImage/ImageDefs.hpp>
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Streaming DEFLATE (RFC 1951) compressor with fixed Huffman codes, the same format stbi_zlib_compress
+     *        produces. Unlike stbi_zlib_compress it does not need all data at once: the data is written in pieces and
+     *        the compressed bytes can be drained from getOutput after every write, so only the 32 KiB window and the
+     *        pending output are held in memory.
+     */
+    class DeflateEncoder {
+    public:
+        /**
+         * @param level 0 stores the data uncompressed, 1 (fastest) to 9 (smallest output) search longer hash chains
+         */
+        explicit DeflateEncoder(U32 level);
+
+        /**
+         * @brief Primes the window with data that precedes the stream (at most the last 32 KiB are used), so the first
+         *        matches can refer to it. The decoder must have produced the same bytes before this stream, as when
+         *        streams compressed in parallel are concatenated. Call before the first write.
+         */
+        void setDictionary(std::span<const U8> dictionary);
+
+        /**
+         * @brief Compresses data. The last bytes are held back until more data arrives, flush or finish is called,
+         *        so matches can span consecutive writes.
+         */
+        void write(std::span<const U8> data);
+
+        /**
+         * @brief Compresses all pending data and aligns the output to a byte boundary with an empty stored block
+         *        (a zlib sync flush). Streams compressed separately can be concatenated at flush points.
+         */
+        void flush();
+
+        /**
+         * @brief Compresses all pending data and ends the stream with a final block.
+         */
+        void finish();
+
+        /**
+         * @brief Compressed bytes produced so far, the caller may consume and clear them at any time.
+         */
+        std::vector<U8>& getOutput() { return m_Output; }
+
+    private:
+        void compress(bool all);
+
+        void storeBlocks(std::span<const U8> data, bool final);
+
+        void beginFixedBlock();
+
+        void endFixedBlock();
+
+        void writeLiteral(U8 value);
+
+        void writeMatch(Size length, Size distance);
+
+        void writeBits(U32 bits, U32 count);
+
+        void alignToByte();
+
+        void insertHash(Size position);
+
+        Size findMatch(Size position, Size end, Size& distance) const;
+
+    private:
+        const U32 m_Level;
+        const Size m_MaxChainLength;
+        const Size m_NiceLength;
+        const bool m_Lazy;
+
+        std::vector<U8> m_Output;
+        U64 m_BitBuffer = 0;
+        U32 m_BitCount = 0;
+        bool m_BlockOpen = false;
+
+        // Uncompressed data: up to one window of history followed by the pending bytes. Positions are counted from
+        // the start of the stream, m_BufferStart is the position of m_Buffer[0].
+        std::vector<U8> m_Buffer;
+        Size m_BufferStart = 0;
+        Size m_Position = 0; // Next position to compress
+
+        // Hash chains of 3 byte sequences, entries are positions + 1 so 0 means empty
+        std::vector<Size> m_Head;
+        std::vector<Size> m_Previous;
+    };
+
+    /**
+     * @brief Updates an Adler-32 checksum (the zlib checksum), start with 1.
+     */
+    U32 updateAdler32(U32 adler, std::span<const U8> data);
+
+    /**
+     * @brief Combines the Adler-32 checksums of two consecutive pieces of data into the checksum of both.
+     * @param secondLength Length of the second piece
+     */
+    U32 combineAdler32(U32 first, U32 second, Size secondLength);
+
+}
@@ -0,0 +1,315 @@
+#include "../Pch.hpp"
+
+#include "PngEncoder.hpp"
+#include "../ImageUtils.hpp"
+#include "../Executor/ParallelFor.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace Velyra::Image {
+
+    namespace {
+
+        constexpr std::array<U8, 8> PNG_SIGNATURE = {137, 80, 78, 71, 13, 10, 26, 10};
+
+        // Filtered data is compressed in blocks of this size, each block is one task on the executor
+        constexpr Size DEFLATE_BLOCK_SIZE = PARALLEL_BLOCK_BYTES;
+
+        constexpr auto CRC_TABLE = [] {
+            std::array<U32, 256> table{};
+            for (U32 n = 0; n < table.size(); ++n) {
+                U32 c = n;
+                for (U32 k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                table[n] = c;
+            }
+            return table;
+        }();
+
+        U32 updateCrc(U32 crc, const U8* data, const Size count) {
+            for (Size i = 0; i < count; ++i) {
+                crc = CRC_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+            return crc;
+        }
+
+        void appendU32(std::vector<U8>& output, const U32 value) {
+            output.push_back(static_cast<U8>(value >> 24));
+            output.push_back(static_cast<U8>(value >> 16));
+            output.push_back(static_cast<U8>(value >> 8));
+            output.push_back(static_cast<U8>(value));
+        }
+
+        void appendChunk(std::vector<U8>& output, const char* type, const U8* data, const Size count) {
+            appendU32(output, static_cast<U32>(count));
+            const Size typeStart = output.size();
+            output.insert(output.end(), type, type + 4);
+            output.insert(output.end(), data, data + count);
+            const U32 crc = updateCrc(0xFFFFFFFFu, output.data() + typeStart, 4 + count);
+            appendU32(output, crc ^ 0xFFFFFFFFu);
+        }
+
+        U8 paethPredictor(const I32 a, const I32 b, const I32 c) {
+            const I32 p = a + b - c;
+            const I32 pa = std::abs(p - a);
+            const I32 pb = std::abs(p - b);
+            const I32 pc = std::abs(p - c);
+            if (pa <= pb && pa <= pc) {
+                return static_cast<U8>(a);
+            }
+            return static_cast<U8>(pb <= pc ? b : c);
+        }
+
+        /**
+         * Filters one row with one of the five PNG filters. The bytes left of the row are zero, as defined by the PNG
+         * specification. Every filter has its own loop, so the compiler can vectorize them.
+         */
+        void filterRow(const U8* row, const U8* previous, const Size rowBytes, const Size bytesPerPixel, const U8 filterType,
+            U8* filtered) {
+            const Size firstBytes = std::min(bytesPerPixel, rowBytes);
+            switch (filterType) {
+                case 1: // Sub
+                    std::memcpy(filtered, row, firstBytes);
+                    for (Size i = firstBytes; i < rowBytes; ++i) {
+                        filtered[i] = static_cast<U8>(row[i] - row[i - bytesPerPixel]);
+                    }
+                    break;
+                case 2: // Up
+                    for (Size i = 0; i < rowBytes; ++i) {
+                        filtered[i] = static_cast<U8>(row[i] - previous[i]);
+                    }
+                    break;
+                case 3: // Average
+                    for (Size i = 0; i < firstBytes; ++i) {
+                        filtered[i] = static_cast<U8>(row[i] - (previous[i] >> 1));
+                    }
+                    for (Size i = firstBytes; i < rowBytes; ++i) {
+                        filtered[i] = static_cast<U8>(row[i] - ((row[i - bytesPerPixel] + previous[i]) >> 1));
+                    }
+                    break;
+                case 4: // Paeth, which predicts the byte above when the left bytes are zero
+                    for (Size i = 0; i < firstBytes; ++i) {
+                        filtered[i] = static_cast<U8>(row[i] - previous[i]);
+                    }
+                    for (Size i = firstBytes; i < rowBytes; ++i) {
+                        filtered[i] = static_cast<U8>(row[i] - paethPredictor(row[i - bytesPerPixel], previous[i],
+                            previous[i - bytesPerPixel]));
+                    }
+                    break;
+                default: // None
+                    std::memcpy(filtered, row, rowBytes);
+                    break;
+            }
+        }
+
+        U8 getColorType(const U32 channelCount) {
+            switch (channelCount) {
+                case 1: return 0; // Greyscale
+                case 2: return 4; // Greyscale with alpha
+                case 3: return 2; // Truecolor
+                default: return 6; // Truecolor with alpha
+            }
+        }
+
+        bool isValidDesc(const PngEncodeDesc& desc) {
+            constexpr Size maxDimension = std::numeric_limits<I32>::max();
+            return desc.width != 0 && desc.height != 0 && desc.width <= maxDimension && desc.height <= maxDimension &&
+                desc.channelCount >= 1 && desc.channelCount <= 4 && (desc.bitDepth == 8 || desc.bitDepth == 16);
+        }
+
+        std::vector<U8> createHeader(const PngEncodeDesc& desc) {
+            std::vector<U8> header;
+            appendU32(header, static_cast<U32>(desc.width));
+            appendU32(header, static_cast<U32>(desc.height));
+            header.push_back(static_cast<U8>(desc.bitDepth));
+            header.push_back(getColorType(desc.channelCount));
+            header.insert(header.end(), 3, 0); // Compression, filter and interlace method
+            return header;
+        }
+
+    }
+
+    AdaptiveRowFilter::AdaptiveRowFilter(const PngEncodeDesc& desc):
+    m_BytesPerPixel(desc.channelCount * desc.bitDepth / 8),
+    m_RowBytes(desc.width * m_BytesPerPixel),
+    m_BitDepth(desc.bitDepth),
+    m_Current(m_RowBytes),
+    m_Previous(m_RowBytes),
+    m_Candidate(m_RowBytes),
+    m_Best(m_RowBytes) {
+
+    }
+
+    void AdaptiveRowFilter::filter(const U8* row, U8* output) {
+        loadRow(row, m_Current.data());
+
+        // Estimate the entropy of every filter by the sum of the absolute filtered bytes, the smallest wins
+        U8 bestFilter = 0;
+        Size bestEstimate = std::numeric_limits<Size>::max();
+        for (U8 filterType = 0; filterType < 5; ++filterType) {
+            filterRow(m_Current.data(), m_Previous.data(), m_RowBytes, m_BytesPerPixel, filterType,
+                m_Candidate.data());
+            Size estimate = 0;
+            for (const U8 value : m_Candidate) {
+                estimate += static_cast<Size>(std::abs(static_cast<I32>(static_cast<signed char>(value))));
+            }
+            if (estimate < bestEstimate) {
+                bestEstimate = estimate;
+                bestFilter = filterType;
+                std::swap(m_Candidate, m_Best);
+            }
+        }
+        output[0] = bestFilter;
+        std::memcpy(output + 1, m_Best.data(), m_RowBytes);
+        std::swap(m_Current, m_Previous);
+    }
+
+    void AdaptiveRowFilter::setPreviousRow(const U8* row) {
+        loadRow(row, m_Previous.data());
+    }
+
+    void AdaptiveRowFilter::loadRow(const U8* row, U8* output) const {
+        if (m_BitDepth == 16) {
+            // PNG stores 16-bit samples in big endian order
+            for (Size i = 0; i < m_RowBytes; i += 2) {
+                U16 sample;
+                std::memcpy(&sample, row + i, sizeof(sample));
+                output[i] = static_cast<U8>(sample >> 8);
+                output[i + 1] = static_cast<U8>(sample);
+            }
+        }
+        else {
+            std::memcpy(output, row, m_RowBytes);
+        }
+    }
+
+    std::vector<U8> encodePng(const PngEncodeDesc& desc) {
+        if (!desc.data || !isValidDesc(desc)) {
+            return {};
+        }
+        const Size rowBytes = desc.width * desc.channelCount * desc.bitDepth / 8;
+        const Size filteredRowBytes = rowBytes + 1;
+        const auto* source = static_cast<const U8*>(desc.data);
+        const auto getSourceRow = [&](const Size y) {
+            return source + (desc.flipVertical ? desc.height - 1 - y : y) * rowBytes;
+        };
+
+        // A block of rows only needs the unfiltered row above it, so the blocks filter independently
+        std::vector<U8> filteredData(desc.height * filteredRowBytes);
+        parallelForBlocks(desc.executionPolicy, desc.height, rowBytes + filteredRowBytes, [&](const Size begin, const Size end) {
+            AdaptiveRowFilter rowFilter(desc);
+            if (begin != 0) {
+                rowFilter.setPreviousRow(getSourceRow(begin - 1));
+            }
+            for (Size y = begin; y < end; ++y) {
+                rowFilter.filter(getSourceRow(y), filteredData.data() + y * filteredRowBytes);
+            }
+        });
+
+        const Size blockCount = (filteredData.size() + DEFLATE_BLOCK_SIZE - 1) / DEFLATE_BLOCK_SIZE;
+        std::vector<std::vector<U8>> compressedBlocks(blockCount);
+        std::vector<U32> blockAdler32(blockCount);
+        parallelForBlocks(desc.executionPolicy, blockCount, DEFLATE_BLOCK_SIZE, [&](const Size begin, const Size end) {
+            for (Size block = begin; block < end; ++block) {
+                const std::span<const U8> filtered(filteredData);
+                const Size offset = block * DEFLATE_BLOCK_SIZE;
+                const std::span<const U8> data = filtered.subspan(offset, std::min(DEFLATE_BLOCK_SIZE, filtered.size() - offset));
+                DeflateEncoder deflate(desc.compressionLevel);
+                deflate.setDictionary(filtered.first(offset));
+                deflate.write(data);
+                if (block + 1 == blockCount) {
+                    deflate.finish();
+                }
+                else {
+                    deflate.flush();
+                }
+                compressedBlocks[block] = std::move(deflate.getOutput());
+                blockAdler32[block] = updateAdler32(1, data);
+            }
+        });
+
+        U32 adler32 = blockAdler32[0];
+        for (Size block = 1; block < blockCount; ++block) {
+            const Size blockSize = std::min(DEFLATE_BLOCK_SIZE, filteredData.size() - block * DEFLATE_BLOCK_SIZE);
+            adler32 = combineAdler32(adler32, blockAdler32[block], blockSize);
+        }
+        // zlib header: deflate with a 32 KiB window, the same flags as stbi_zlib_compress
+        compressedBlocks.front().insert(compressedBlocks.front().begin(), {0x78, 0x5E});
+        appendU32(compressedBlocks.back(), adler32);
+
+        // Every block is written as its own IDAT chunk, which also keeps the chunks below the 2^31 byte limit
+        Size compressedSize = 0;
+        for (const std::vector<U8>& compressed : compressedBlocks) {
+            compressedSize += compressed.size() + 12;
+        }
+        const std::vector<U8> header = createHeader(desc);
+        std::vector<U8> png;
+        png.reserve(PNG_SIGNATURE.size() + 2 * 12 + header.size() + compressedSize);
+        png.insert(png.end(), PNG_SIGNATURE.begin(), PNG_SIGNATURE.end());
+        appendChunk(png, "IHDR", header.data(), header.size());
+        for (const std::vector<U8>& compressed : compressedBlocks) {
+            appendChunk(png, "IDAT", compressed.data(), compressed.size());
+        }
+        appendChunk(png, "IEND", nullptr, 0);
+        return png;
+    }
+
+    bool writePng(const fs::path& fileName, const PngEncodeDesc& desc) {
+        const std::vector<U8> png = encodePng(desc);
+        if (png.empty()) {
+            return false;
+        }
+        const FilePtr file = openFileForWriting(fileName);
+        if (!file) {
+            return false;
+        }
+        return std::fwrite(png.data(), 1, png.size(), file.get()) == png.size();
+    }
+
+    PngStreamEncoder::PngStreamEncoder(const PngEncodeDesc& desc):
+    m_RowBytes(desc.width * desc.channelCount * desc.bitDepth / 8),
+    m_RowFilter(desc),
+    m_FilteredRow(m_RowBytes + 1),
+    m_Deflate(desc.compressionLevel) {
+        if (!isValidDesc(desc)) {
+            VL_THROW("Cannot encode a PNG of size ({}x{}) with {} channels and {} bits per channel", desc.width,
+                desc.height, desc.channelCount, desc.bitDepth);
+        }
+        const std::vector<U8> header = createHeader(desc);
+        m_Output.insert(m_Output.end(), PNG_SIGNATURE.begin(), PNG_SIGNATURE.end());
+        appendChunk(m_Output, "IHDR", header.data(), header.size());
+        // zlib header: deflate with a 32 KiB window, the same flags as stbi_zlib_compress
+        m_PendingData = {0x78, 0x5E};
+    }
+
+    void PngStreamEncoder::writeRows(const void* rows, const Size rowCount) {
+        const auto* source = static_cast<const U8*>(rows);
+        for (Size y = 0; y < rowCount; ++y) {
+            m_RowFilter.filter(source + y * m_RowBytes, m_FilteredRow.data());
+            m_Adler32 = updateAdler32(m_Adler32, m_FilteredRow);
+            m_Deflate.write(m_FilteredRow);
+        }
+        std::vector<U8>& compressed = m_Deflate.getOutput();
+        m_PendingData.insert(m_PendingData.end(), compressed.begin(), compressed.end());
+        compressed.clear();
+        if (m_PendingData.size() >= IDAT_CHUNK_SIZE) {
+            appendChunk(m_Output, "IDAT", m_PendingData.data(), m_PendingData.size());
+            m_PendingData.clear();
+        }
+    }
+
+    void PngStreamEncoder::finish() {
+        m_Deflate.finish();
+        std::vector<U8>& compressed = m_Deflate.getOutput();
+        m_PendingData.insert(m_PendingData.end(), compressed.begin(), compressed.end());
+        compressed.clear();
+        appendU32(m_PendingData, m_Adler32);
+        appendChunk(m_Output, "IDAT", m_PendingData.data(), m_PendingData.size());
+        appendChunk(m_Output, "IEND", nullptr, 0);
+        m_PendingData.clear();
+    }
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <VelyraImage/ImageDefs.hpp>
+
+#include "Deflate.hpp"
+
+namespace Velyra::Image {
+
+    struct PngEncodeDesc {
+        const void* data = nullptr; // Tightly packed rows, 16-bit samples in native byte order
+        Size width = 0;
+        Size height = 0;
+        U32 channelCount = 0; // 1 (grey), 2 (grey, alpha), 3 (RGB) or 4 (RGBA)
+        U32 bitDepth = 8; // 8 or 16 bits per channel
+        bool flipVertical = false; // Write the rows in reverse order
+        U32 compressionLevel = 6; // See DeflateEncoder
+        VL_EXECUTION_POLICY executionPolicy = VL_EXECUTION_PARALLEL;
+    };
+
+    /**
+     * @brief Encodes an image as PNG with 8 or 16 bits per channel. Every row is filtered with the filter that
+     *        minimizes the sum of the absolute filtered bytes (the same heuristic as stb_image_write). Large images are
+     *        filtered in blocks of rows and compressed in blocks of data on the executor. Like pigz, every block is
+     *        compressed with the end of the previous block as dictionary and ends with a sync flush, so the blocks
+     *        concatenate to one zlib stream. The output does not depend on the execution policy.
+     * @return The PNG file contents, empty on failure
+     */
+    std::vector<U8> encodePng(const PngEncodeDesc& desc);
+
+    /**
+     * @brief Encodes the image with encodePng and writes it to fileName.
+     * @return True on success
+     */
+    bool writePng(const fs::path& fileName, const PngEncodeDesc& desc);
+
+    /**
+     * @brief Filters PNG rows one at a time, with the filter that minimizes the sum of the absolute filtered bytes
+     *        (the same heuristic as stb_image_write). Keeps the previous row, which the filters predict from.
+     */
+    class AdaptiveRowFilter {
+    public:
+        /**
+         * @param desc Dimensions and bit depth of the image, data and flipVertical are ignored
+         */
+        explicit AdaptiveRowFilter(const PngEncodeDesc& desc);
+
+        /**
+         * @brief Filters the next row.
+         * @param row Row in the layout of PngEncodeDesc::data
+         * @param output Receives the filter type followed by the filtered row (row size + 1 bytes)
+         */
+        void filter(const U8* row, U8* output);
+
+        /**
+         * @brief Sets the row the next row is predicted from, to start filtering in the middle of an image.
+         * @param row Row in the layout of PngEncodeDesc::data
+         */
+        void setPreviousRow(const U8* row);
+
+    private:
+        /**
+         * @brief Copies a row to output, in big endian order for 16-bit samples.
+         */
+        void loadRow(const U8* row, U8* output) const;
+
+    private:
+        const Size m_BytesPerPixel;
+        const Size m_RowBytes;
+        const U32 m_BitDepth;
+        std::vector<U8> m_Current;
+        std::vector<U8> m_Previous; // The row above the first row is zero
+        std::vector<U8> m_Candidate;
+        std::vector<U8> m_Best;
+    };
+
+    /**
+     * @brief Encodes a PNG row by row, for writers that never hold the whole image. The rows are filtered like encodePng
+     *        does and compressed with DeflateEncoder as they arrive. The encoded file is appended to getOutput, which
+     *        the caller drains after every call.
+     */
+    class PngStreamEncoder {
+    public:
+        /**
+         * @param desc Dimensions, bit depth and compression level of the image, data, flipVertical and executionPolicy
+         *        are ignored. Throws if invalid.
+         */
+        explicit PngStreamEncoder(const PngEncodeDesc& desc);
+
+        void writeRows(const void* rows, Size rowCount);
+
+        /**
+         * @brief Writes the remaining data and the end of the file, call after all rows have been written.
+         */
+        void finish();
+
+        std::vector<U8>& getOutput() { return m_Output; }
+
+    private:
+        // Compressed data is collected into IDAT chunks of at least this size
+        static constexpr Size IDAT_CHUNK_SIZE = 1 << 16;
+
+        const Size m_RowBytes;
+        AdaptiveRowFilter m_RowFilter;
+        std::vector<U8> m_FilteredRow;
+        DeflateEncoder m_Deflate;
+        U32 m_Adler32 = 1;
+        std::vector<U8> m_PendingData; // zlib stream not yet written as a chunk
+        std::vector<U8> m_Output;
+    };
+
+}
@@ -0,0 +1,182 @@
+#include "Pch.hpp"
+
+#include "SimdDispatch.hpp"
+#include "ImageUtils.hpp"
+#include "FormatConversion/FormatConversion.hpp"
+#include "DataTypeConversion/DataTypeConversion.hpp"
+#include "Flip/Flip.hpp"
+#include "Jpg/JpgEncoder.hpp"
+
+namespace Velyra::Image {
+
+    namespace {
+
+        void setF16Functions(SimdDispatchTable& table) {
+            using namespace TranslateDataType;
+
+            // F16 swizzles move the same 16-bit patterns as U16 swizzles, only the fill values differ
+            table.convertFormatF16 = &convertFormat_Scalar<F16>;
+            table.swizzleInPlaceF16 = &swizzleInPlace_Scalar<F16>;
+
+            // The conversion instructions are part of AVX-512F and of F16C, the SSE modes have no vector conversion
+            const SimdSupport& support = getSimdSupport();
+            if (table.mode == VL_SIMD_AVX512) {
+                table.translateF16ToF32 = &translateDataType_AVX512;
+                table.translateF32ToF16 = &translateDataType_AVX512;
+                table.translateU8ToF16 = &translateDataType_AVX512;
+                table.translateF16ToU8 = &translateDataType_AVX512;
+            }
+            else if (table.mode == VL_SIMD_AVX2 && support.f16c) {
+                table.translateF16ToF32 = &translateDataType_F16C;
+                table.translateF32ToF16 = &translateDataType_F16C;
+                table.translateU8ToF16 = &translateDataType_F16C;
+                table.translateF16ToU8 = &translateDataType_F16C;
+            }
+            else {
+                table.translateF16ToF32 = &translateDataType_Scalar;
+                table.translateF32ToF16 = &translateDataType_Scalar;
+                table.translateU8ToF16 = &translateDataType_Scalar;
+                table.translateF16ToU8 = &translateDataType_Scalar;
+            }
+        }
+
+        void setResizeFunction(SimdDispatchTable& table) {
+            const SimdSupport& support = getSimdSupport();
+            const bool wideMode = table.mode == VL_SIMD_AVX2 || table.mode == VL_SIMD_AVX512;
+            if (wideMode && support.fma && support.f16c) {
+                table.resize = &vl_stbir_resize_avx2;
+                table.resizeRows = &vl_stbir_resize_rows_avx2;
+            }
+            else {
+                table.resize = &vl_stbir_resize_baseline;
+                table.resizeRows = &vl_stbir_resize_rows_baseline;
+            }
+        }
+
+        void setJpgFunctions(SimdDispatchTable& table) {
+            if (table.mode == VL_SIMD_AVX2 || table.mode == VL_SIMD_AVX512) {
+                table.jpgConvertColor = &convertRgbaToYcc_AVX2;
+                table.jpgForwardDct = &forwardDct_AVX2;
+            }
+            else {
+                table.jpgConvertColor = &convertRgbaToYcc_Scalar;
+                table.jpgForwardDct = &forwardDct_Scalar;
+            }
+        }
+
+        SimdDispatchTable createDispatchTable(const VL_SIMD_MODE mode) {
+            using namespace TranslateDataType;
+
+            SimdDispatchTable table;
+            table.mode = mode;
+            switch (mode) {
+                case VL_SIMD_AVX512: {
+                    table.convertFormatU8 = &convertFormat_U8_AVX512;
+                    table.convertFormatF32 = &convertFormat_F32_AVX512;
+                    table.swizzleInPlaceU8 = &swizzleInPlace_U8_AVX512;
+                    table.swizzleInPlaceF32 = &swizzleInPlace_F32_AVX512;
+                    table.translateU8ToF32 = &translateDataType_AVX512;
+                    table.translateF32ToU8 = &translateDataType_AVX512;
+                    table.translateU8ToU16 = &translateDataType_AVX512;
+                    table.translateU16ToU8 = &translateDataType_AVX512;
+                    table.translateU16ToF32 = &translateDataType_AVX512;
+                    table.translateF32ToU16 = &translateDataType_AVX512;
+                    table.swapRows = &swapRows_AVX512;
+                    break;
+                }
+                case VL_SIMD_AVX2: {
+                    table.convertFormatU8 = &convertFormat_U8_AVX2;
+                    table.convertFormatF32 = &convertFormat_F32_AVX2;
+                    table.swizzleInPlaceU8 = &swizzleInPlace_U8_AVX2;
+                    table.swizzleInPlaceF32 = &swizzleInPlace_F32_AVX2;
+                    table.translateU8ToF32 = &translateDataType_AVX2;
+                    table.translateF32ToU8 = &translateDataType_AVX2;
+                    table.translateU8ToU16 = &translateDataType_AVX2;
+                    table.translateU16ToU8 = &translateDataType_AVX2;
+                    table.translateU16ToF32 = &translateDataType_AVX2;
+                    table.translateF32ToU16 = &translateDataType_AVX2;
+                    table.swapRows = &swapRows_AVX2;
+                    break;
+                }
+                case VL_SIMD_SSE41: {
+                    table.convertFormatU8 = &convertFormat_U8_SSSE3;
+                    table.convertFormatF32 = &convertFormat_F32_SSE2;
+                    table.swizzleInPlaceU8 = &swizzleInPlace_U8_SSSE3;
+                    table.swizzleInPlaceF32 = &swizzleInPlace_F32_SSE2;
+                    table.translateU8ToF32 = &translateDataType_SSE41;
+                    table.translateF32ToU8 = &translateDataType_SSE41;
+                    table.translateU8ToU16 = &translateDataType_SSE2;
+                    table.translateU16ToU8 = &translateDataType_SSE2;
+                    table.translateU16ToF32 = &translateDataType_SSE2;
+                    table.translateF32ToU16 = &translateDataType_SSE41;
+                    table.swapRows = &swapRows_SSE2;
+                    break;
+                }
+                case VL_SIMD_SSSE3: {
+                    table.convertFormatU8 = &convertFormat_U8_SSSE3;
+                    table.convertFormatF32 = &convertFormat_F32_SSE2;
+                    table.swizzleInPlaceU8 = &swizzleInPlace_U8_SSSE3;
+                    table.swizzleInPlaceF32 = &swizzleInPlace_F32_SSE2;
+                    table.translateU8ToF32 = &translateDataType_SSE2;
+                    table.translateF32ToU8 = &translateDataType_SSE2;
+                    table.translateU8ToU16 = &translateDataType_SSE2;
+                    table.translateU16ToU8 = &translateDataType_SSE2;
+                    table.translateU16ToF32 = &translateDataType_SSE2;
+                    table.translateF32ToU16 = &translateDataType_SSE2;
+                    table.swapRows = &swapRows_SSE2;
+                    break;
+                }
+                case VL_SIMD_SSE2: {
+                    table.convertFormatU8 = &convertFormat_U8_SSE2;
+                    table.convertFormatF32 = &convertFormat_F32_SSE2;
+                    table.swizzleInPlaceU8 = &swizzleInPlace_U8_SSE2;
+                    table.swizzleInPlaceF32 = &swizzleInPlace_F32_SSE2;
+                    table.translateU8ToF32 = &translateDataType_SSE2;
+                    table.translateF32ToU8 = &translateDataType_SSE2;
+                    table.translateU8ToU16 = &translateDataType_SSE2;
+                    table.translateU16ToU8 = &translateDataType_SSE2;
+                    table.translateU16ToF32 = &translateDataType_SSE2;
+                    table.translateF32ToU16 = &translateDataType_SSE2;
+                    table.swapRows = &swapRows_SSE2;
+                    break;
+                }
+                default: {
+                    table.mode = VL_SIMD_SCALAR;
+                    table.convertFormatU8 = &convertFormat_Scalar<U8>;
+                    table.convertFormatF32 = &convertFormat_Scalar<float>;
+                    table.swizzleInPlaceU8 = &swizzleInPlace_Scalar<U8>;
+                    table.swizzleInPlaceF32 = &swizzleInPlace_Scalar<float>;
+                    table.translateU8ToF32 = &translateDataType_Scalar;
+                    table.translateF32ToU8 = &translateDataType_Scalar;
+                    table.translateU8ToU16 = &translateDataType_Scalar;
+                    table.translateU16ToU8 = &translateDataType_Scalar;
+                    table.translateU16ToF32 = &translateDataType_Scalar;
+                    table.translateF32ToU16 = &translateDataType_Scalar;
+                    table.swapRows = &swapRows_Scalar;
+                    break;
+                }
+            }
+            // U16 swizzles use the scalar kernels in every mode, the swizzle is resolved at compile time so they are
+            // still branch free
+            table.convertFormatU16 = &convertFormat_Scalar<U16>;
+            table.swizzleInPlaceU16 = &swizzleInPlace_Scalar<U16>;
+            setF16Functions(table);
+            setResizeFunction(table);
+            setJpgFunctions(table);
+            return table;
+        }
+
+    }
+
+    const SimdDispatchTable& getDispatchTable(const VL_SIMD_MODE requestedMode) {
+        static const std::array<SimdDispatchTable, VL_SIMD_MODE_MAX_VALUE> tables = [] {
+            std::array<SimdDispatchTable, VL_SIMD_MODE_MAX_VALUE> result{};
+            for (Size i = 0; i < result.size(); ++i) {
+                result[i] = createDispatchTable(static_cast<VL_SIMD_MODE>(i));
+            }
+            return result;
+        }();
+        return tables[findBestMode(requestedMode)];
+    }
+
+}
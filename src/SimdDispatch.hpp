@@ -0,0 +1,142 @@
+#pragma once
+
+#include <VelyraImage/ImageDefs.hpp>
+#include <span>
+#include <stb_image_resize2_variants.h>
+
+namespace Velyra::Image {
+
+    template<typename T>
+    using ConvertFormatFunction = void(*)(VL_CHANNEL_FORMAT sourceFormat, std::span<const T> sourceData,
+        VL_CHANNEL_FORMAT targetFormat, std::span<T> targetData, VL_FORMAT_CONVERSION_FILL fillMode);
+
+    template<typename T>
+    using SwizzleInPlaceFunction = void(*)(VL_CHANNEL_FORMAT sourceFormat, VL_CHANNEL_FORMAT targetFormat, std::span<T> data);
+
+    template<typename SrcType, typename DstType>
+    using TranslateDataTypeFunction = void(*)(std::span<const SrcType> source, std::span<DstType> destination);
+
+    using SwapRowsFunction = void(*)(U8* first, U8* second, Size byteCount);
+
+    using ResizeFunction = vl_stbir_resize_function*;
+
+    using ResizeRowsFunction = vl_stbir_resize_rows_function*;
+
+    using JpgConvertColorFunction = void(*)(const U8* rgba, Size pixelCount, float* y, float* cb, float* cr);
+
+    using JpgForwardDctFunction = void(*)(const float* samples, Size stride, const float* scales, I16* coefficients);
+
+    /**
+     * @brief Kernels of every operation for one SIMD mode.
+     *        The tables are built once, so selecting a kernel only costs a lookup instead of a CPU feature check.
+     */
+    struct SimdDispatchTable {
+        VL_SIMD_MODE mode = VL_SIMD_SCALAR;
+
+        ConvertFormatFunction<U8> convertFormatU8 = nullptr;
+        ConvertFormatFunction<float> convertFormatF32 = nullptr;
+        ConvertFormatFunction<U16> convertFormatU16 = nullptr;
+        ConvertFormatFunction<F16> convertFormatF16 = nullptr;
+
+        SwizzleInPlaceFunction<U8> swizzleInPlaceU8 = nullptr;
+        SwizzleInPlaceFunction<float> swizzleInPlaceF32 = nullptr;
+        SwizzleInPlaceFunction<U16> swizzleInPlaceU16 = nullptr;
+        SwizzleInPlaceFunction<F16> swizzleInPlaceF16 = nullptr;
+
+        TranslateDataTypeFunction<U8, float> translateU8ToF32 = nullptr;
+        TranslateDataTypeFunction<float, U8> translateF32ToU8 = nullptr;
+        TranslateDataTypeFunction<U8, U16> translateU8ToU16 = nullptr;
+        TranslateDataTypeFunction<U16, U8> translateU16ToU8 = nullptr;
+        TranslateDataTypeFunction<U16, float> translateU16ToF32 = nullptr;
+        TranslateDataTypeFunction<float, U16> translateF32ToU16 = nullptr;
+        TranslateDataTypeFunction<F16, float> translateF16ToF32 = nullptr;
+        TranslateDataTypeFunction<float, F16> translateF32ToF16 = nullptr;
+        TranslateDataTypeFunction<U8, F16> translateU8ToF16 = nullptr;
+        TranslateDataTypeFunction<F16, U8> translateF16ToU8 = nullptr;
+
+        SwapRowsFunction swapRows = nullptr;
+
+        // stb_image_resize2 only has a baseline and an AVX2 build, the narrower modes use the baseline build
+        ResizeFunction resize = nullptr;
+        ResizeRowsFunction resizeRows = nullptr;
+
+        // The JPG encoder only has scalar and AVX2 kernels, the SSE modes use the scalar ones
+        JpgConvertColorFunction jpgConvertColor = nullptr;
+        JpgForwardDctFunction jpgForwardDct = nullptr;
+
+        template<typename T>
+        ConvertFormatFunction<T> getConvertFormat() const {
+            if constexpr (std::is_same_v<T, U8>) {
+                return convertFormatU8;
+            }
+            else if constexpr (std::is_same_v<T, U16>) {
+                return convertFormatU16;
+            }
+            else if constexpr (std::is_same_v<T, F16>) {
+                return convertFormatF16;
+            }
+            else {
+                static_assert(std::is_same_v<T, float>, "No format conversion kernels for this type");
+                return convertFormatF32;
+            }
+        }
+
+        template<typename T>
+        SwizzleInPlaceFunction<T> getSwizzleInPlace() const {
+            if constexpr (std::is_same_v<T, U8>) {
+                return swizzleInPlaceU8;
+            }
+            else if constexpr (std::is_same_v<T, U16>) {
+                return swizzleInPlaceU16;
+            }
+            else if constexpr (std::is_same_v<T, F16>) {
+                return swizzleInPlaceF16;
+            }
+            else {
+                static_assert(std::is_same_v<T, float>, "No in place swizzle kernels for this type");
+                return swizzleInPlaceF32;
+            }
+        }
+
+        template<typename SrcType, typename DstType>
+        TranslateDataTypeFunction<SrcType, DstType> getTranslateDataType() const {
+            if constexpr (std::is_same_v<SrcType, U8> && std::is_same_v<DstType, float>) {
+                return translateU8ToF32;
+            }
+            else if constexpr (std::is_same_v<SrcType, U8> && std::is_same_v<DstType, U16>) {
+                return translateU8ToU16;
+            }
+            else if constexpr (std::is_same_v<SrcType, U16> && std::is_same_v<DstType, U8>) {
+                return translateU16ToU8;
+            }
+            else if constexpr (std::is_same_v<SrcType, U16> && std::is_same_v<DstType, float>) {
+                return translateU16ToF32;
+            }
+            else if constexpr (std::is_same_v<SrcType, float> && std::is_same_v<DstType, U16>) {
+                return translateF32ToU16;
+            }
+            else if constexpr (std::is_same_v<SrcType, F16> && std::is_same_v<DstType, float>) {
+                return translateF16ToF32;
+            }
+            else if constexpr (std::is_same_v<SrcType, float> && std::is_same_v<DstType, F16>) {
+                return translateF32ToF16;
+            }
+            else if constexpr (std::is_same_v<SrcType, U8> && std::is_same_v<DstType, F16>) {
+                return translateU8ToF16;
+            }
+            else if constexpr (std::is_same_v<SrcType, F16> && std::is_same_v<DstType, U8>) {
+                return translateF16ToU8;
+            }
+            else {
+                static_assert(std::is_same_v<SrcType, float> && std::is_same_v<DstType, U8>, "No translation kernels for this type pair");
+                return translateF32ToU8;
+            }
+        }
+    };
+
+    /**
+     * @brief Returns the kernels for the requested mode after resolving it with findBestMode.
+     */
+    const SimdDispatchTable& getDispatchTable(VL_SIMD_MODE requestedMode);
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+/*
+ * The kernels of an instruction set are compiled for it by enclosing them in VL_SIMD_TARGET_BEGIN and
+ * VL_SIMD_TARGET_END, instead of passing the instruction set to the compiler for the whole translation unit. Only the
+ * functions defined inside the region use the wider instructions. The inline functions and templates of the headers
+ * (the standard library in particular) are compiled for the baseline, so the copy the linker keeps is safe on every
+ * CPU. All headers must be included before the region.
+ */
+
+#define VL_SIMD_PRAGMA(x) _Pragma(#x)
+
+#if defined(__clang__)
+#define VL_SIMD_TARGET_BEGIN(isa) VL_SIMD_PRAGMA(clang attribute push(__attribute__((target(isa))), apply_to = function))
+#define VL_SIMD_TARGET_END VL_SIMD_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+#define VL_SIMD_TARGET_BEGIN(isa) VL_SIMD_PRAGMA(GCC push_options) VL_SIMD_PRAGMA(GCC target(isa))
+#define VL_SIMD_TARGET_END VL_SIMD_PRAGMA(GCC pop_options)
+#else
+// MSVC emits the intrinsics of every instruction set without /arch
+#define VL_SIMD_TARGET_BEGIN(isa)
+#define VL_SIMD_TARGET_END
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <VelyraImage/ImageDefs.hpp>
+#include <VelyraUtils/DevUtils/Conditions.hpp>
+
+#include "../SimdDispatch.hpp"
+#include "../Executor/ParallelFor.hpp"
+#include "../Metrics.hpp"
+#include "../FormatConversion/Swizzle.hpp"
+
+namespace Velyra::Image {
+
+    /**
+     * @brief Returns the transform that does the same as a format conversion with desc.
+     */
+    inline TransformDesc getTransformDesc(const FormatConversionDesc& desc) {
+        TransformDesc transformDesc;
+        transformDesc.targetFormat = desc.targetFormat;
+        transformDesc.fillMode = desc.fillMode;
+        transformDesc.flipVertical = desc.flipVertical;
+        transformDesc.simdMode = desc.simdMode;
+        transformDesc.executionPolicy = desc.executionPolicy;
+        return transformDesc;
+    }
+
+    /**
+     * @brief Converts the channel format, the data type and optionally flips the rows in one pass over the image.
+     *        The image is processed row by row with the kernels of the dispatch table. If both the format and the type
+     *        change, the format conversion runs on the narrower type into a row sized scratch buffer that stays in
+     *        the L1 cache, so the source and target images are only streamed once.
+     * @param sourceData width * height pixels in sourceFormat
+     * @param targetData width * height pixels in desc.targetFormat
+     */
+    template<typename SrcType, typename DstType>
+    void transformPixels(const VL_CHANNEL_FORMAT sourceFormat, const Size width, const Size height,
+        std::span<const SrcType> sourceData, std::span<DstType> targetData, const TransformDesc& desc) {
+        const SimdDispatchTable& table = getDispatchTable(desc.simdMode);
+        const Swizzle swizzle = getSwizzle(sourceFormat, desc.targetFormat);
+        if (!swizzle.isValid()) {
+            VL_THROW("Unsupported format conversion from {} to {}", sourceFormat, desc.targetFormat);
+        }
+        const ScopedOperationMetrics metrics(VL_OPERATION_TRANSFORM, table.mode, sourceData.size_bytes() + targetData.size_bytes());
+        const Size sourceRowCount = width * swizzle.sourceStride;
+        const Size targetRowCount = width * swizzle.targetStride;
+        const bool sameFormat = sourceFormat == desc.targetFormat;
+
+        const Size bytesPerRow = sourceRowCount * sizeof(SrcType) + targetRowCount * sizeof(DstType);
+        parallelForBlocks(desc.executionPolicy, height, bytesPerRow, [&](const Size begin, const Size end) {
+            // The format conversion runs on the narrower of both types, the scratch row holds its result
+            using ScratchType = std::conditional_t<(sizeof(SrcType) <= sizeof(DstType)), SrcType, DstType>;
+            std::vector<ScratchType> scratch;
+            if constexpr (!std::is_same_v<SrcType, DstType>) {
+                if (!sameFormat) {
+                    scratch.resize(std::is_same_v<ScratchType, SrcType> ? targetRowCount : sourceRowCount);
+                }
+            }
+
+            for (Size y = begin; y < end; ++y) {
+                const Size sourceRow = desc.flipVertical ? height - 1 - y : y;
+                const auto source = sourceData.subspan(sourceRow * sourceRowCount, sourceRowCount);
+                const auto target = targetData.subspan(y * targetRowCount, targetRowCount);
+
+                if constexpr (std::is_same_v<SrcType, DstType>) {
+                    if (sameFormat) {
+                        std::memcpy(target.data(), source.data(), source.size_bytes());
+                    }
+                    else {
+                        table.getConvertFormat<SrcType>()(sourceFormat, source, desc.targetFormat, target, desc.fillMode);
+                    }
+                }
+                else {
+                    const auto translate = table.getTranslateDataType<SrcType, DstType>();
+                    if (sameFormat) {
+                        translate(source, target);
+                    }
+                    else if constexpr (std::is_same_v<ScratchType, SrcType>) {
+                        // Widening, swizzle the small source values first
+                        table.getConvertFormat<SrcType>()(sourceFormat, source, desc.targetFormat, scratch, desc.fillMode);
+                        translate(scratch, target);
+                    }
+                    else {
+                        // Narrowing, translate first so the swizzle moves the small target values
+                        translate(source, scratch);
+                        table.getConvertFormat<DstType>()(sourceFormat, scratch, desc.targetFormat, target, desc.fillMode);
+                    }
+                }
+            }
+        });
+    }
+
+}
@@ -1,2 +0,0 @@
-#define STB_IMAGE_RESIZE_IMPLEMENTATION
-#include "stb_image_resize2.h"
\ No newline at end of file
@@ -0,0 +1,12 @@
+/* Compiled with AVX2, FMA and F16C enabled, only called if the CPU supports all three */
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#define STB_IMAGE_RESIZE_STATIC
+#define STBIR_AVX2
+#define STBIR_FP16C
+#define STBIR_USE_FMA
+#include "stb_image_resize2.h"
+#include "stb_image_resize2_variants.h"
+
+#define VL_STBIR_RESIZE_NAME vl_stbir_resize_avx2
+#define VL_STBIR_RESIZE_ROWS_NAME vl_stbir_resize_rows_avx2
+#include "stb_image_resize2_variant.inl"
@@ -0,0 +1,8 @@
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#define STB_IMAGE_RESIZE_STATIC
+#include "stb_image_resize2.h"
+#include "stb_image_resize2_variants.h"
+
+#define VL_STBIR_RESIZE_NAME vl_stbir_resize_baseline
+#define VL_STBIR_RESIZE_ROWS_NAME vl_stbir_resize_rows_baseline
+#include "stb_image_resize2_variant.inl"
@@ -0,0 +1,92 @@
+/*
+ * Body of the stb_image_resize2 variants, included after the implementation of stb_image_resize2.h.
+ * VL_STBIR_RESIZE_NAME and VL_STBIR_RESIZE_ROWS_NAME are the exported names of the variant.
+ */
+
+#include <math.h>
+
+typedef struct {
+    STBIR_RESIZE* resize;
+    int results[VL_STBIR_MAX_SPLITS];
+} vl_stbir_split_context;
+
+static void vl_stbir_run_split(void* task_context, int split_index) {
+    vl_stbir_split_context* context = (vl_stbir_split_context*) task_context;
+    context->results[split_index] = stbir_resize_extended_split(context->resize, split_index, 1);
+}
+
+int VL_STBIR_RESIZE_NAME(const void* input_pixels, int input_w, int input_h, int input_stride_in_bytes,
+    void* output_pixels, int output_w, int output_h, int output_stride_in_bytes, stbir_pixel_layout pixel_layout,
+    stbir_datatype data_type, int max_splits, vl_stbir_run_splits* run_splits, void* executor_context) {
+    STBIR_RESIZE resize;
+    vl_stbir_split_context context;
+    int split_count;
+    int result = 1;
+    int i;
+
+    stbir_resize_init(&resize, input_pixels, input_w, input_h, input_stride_in_bytes,
+        output_pixels, output_w, output_h, output_stride_in_bytes, pixel_layout, data_type);
+
+    if (max_splits < 1 || run_splits == 0) {
+        max_splits = 1;
+    }
+    if (max_splits > VL_STBIR_MAX_SPLITS) {
+        max_splits = VL_STBIR_MAX_SPLITS;
+    }
+    split_count = stbir_build_samplers_with_splits(&resize, max_splits);
+    if (split_count == 0) {
+        return 0;
+    }
+
+    if (split_count == 1) {
+        result = stbir_resize_extended_split(&resize, 0, 1);
+    }
+    else {
+        context.resize = &resize;
+        for (i = 0; i < split_count; ++i) {
+            context.results[i] = 0;
+        }
+        run_splits(executor_context, split_count, vl_stbir_run_split, &context);
+        for (i = 0; i < split_count; ++i) {
+            result = result && context.results[i];
+        }
+    }
+
+    stbir_free_samplers(&resize);
+    return result;
+}
+
+int VL_STBIR_RESIZE_ROWS_NAME(int input_w, int input_h, int output_w, int output_h, int output_y,
+    int output_row_count, stbir_pixel_layout pixel_layout, stbir_datatype data_type, stbir_input_callback* input_cb,
+    void* input_context, void* output_pixels) {
+    STBIR_RESIZE resize;
+    double band_start;
+    double band_size;
+    double band_end;
+
+    /* The input pixel pointer is never dereferenced, the callback provides all input rows. With a zero output stride
+     * stbir does not offset the output by the subrect, so the strip lands at output_pixels. An output callback is
+     * avoided on purpose: the AVX2 encoders convert in place in that case and the overlapping tail of a row reads
+     * values that were already converted. */
+    stbir_resize_init(&resize, 0, input_w, input_h, 0, output_pixels, output_w, output_h, 0, pixel_layout, data_type);
+    stbir_set_pixel_callbacks(&resize, input_cb, 0);
+    stbir_set_user_data(&resize, input_context);
+
+    /* The output subrect receives the whole input region, the matching input band keeps the mapping of the whole
+     * image resize and limits the decode to the input rows that contribute to the strip. The band is nudged until
+     * its size is exactly the size of the subrect, so the scale is the scale of the whole image resize. */
+    band_start = (double) output_y / output_h;
+    band_size = (double) output_row_count / output_h;
+    band_end = band_start + band_size;
+    while (band_end - band_start < band_size) {
+        band_end = nextafter(band_end, 2.0);
+    }
+    while (band_end - band_start > band_size) {
+        band_end = nextafter(band_end, 0.0);
+    }
+    if (!stbir_set_output_pixel_subrect(&resize, 0, output_y, output_w, output_row_count) ||
+        !stbir_set_input_subrect(&resize, 0.0, band_start, 1.0, band_end)) {
+        return 0;
+    }
+    return stbir_resize_extended(&resize);
+}
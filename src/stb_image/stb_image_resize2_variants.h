@@ -0,0 +1,59 @@
+#ifndef VL_STB_IMAGE_RESIZE2_VARIANTS_H
+#define VL_STB_IMAGE_RESIZE2_VARIANTS_H
+
+/*
+ * stb_image_resize2 is compiled twice, once for the baseline target and once with AVX2, FMA and F16C enabled.
+ * Both copies are static inside their own file, these entry points are the only symbols they export.
+ */
+
+// The implementation part of stb_image_resize2.h has no include guard, only pull in the declarations if needed
+#ifndef STBIR_INCLUDE_STB_IMAGE_RESIZE2_H
+#include "stb_image_resize2.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VL_STBIR_MAX_SPLITS 64
+
+typedef void vl_stbir_split_task(void* task_context, int split_index);
+
+/*
+ * Runs task(task_context, i) for every i in [0, split_count) and returns once all of them have finished,
+ * the splits can run concurrently.
+ */
+typedef void vl_stbir_run_splits(void* executor_context, int split_count, vl_stbir_split_task* task, void* task_context);
+
+/*
+ * Resizes with the clamp edge mode and the default filters, like the stbir_resize_*_linear helpers.
+ * The output is split in at most max_splits pieces (capped at VL_STBIR_MAX_SPLITS), which are handed to run_splits.
+ * If run_splits is null or the resize cannot be split, it runs on the calling thread.
+ * Returns 1 on success and 0 on failure.
+ */
+typedef int vl_stbir_resize_function(const void* input_pixels, int input_w, int input_h, int input_stride_in_bytes,
+    void* output_pixels, int output_w, int output_h, int output_stride_in_bytes, stbir_pixel_layout pixel_layout,
+    stbir_datatype data_type, int max_splits, vl_stbir_run_splits* run_splits, void* executor_context);
+
+vl_stbir_resize_function vl_stbir_resize_baseline;
+vl_stbir_resize_function vl_stbir_resize_avx2;
+
+/*
+ * Resizes only the output rows [output_y, output_y + output_row_count) with the same filters as vl_stbir_resize_function.
+ * Only the input rows that contribute to these output rows are read through input_cb (y is the row of the whole input
+ * image, input_context is passed as the context). The rows are written tightly packed to output_pixels, which holds
+ * output_row_count rows. Runs on the calling thread.
+ * Returns 1 on success and 0 on failure.
+ */
+typedef int vl_stbir_resize_rows_function(int input_w, int input_h, int output_w, int output_h, int output_y,
+    int output_row_count, stbir_pixel_layout pixel_layout, stbir_datatype data_type, stbir_input_callback* input_cb,
+    void* input_context, void* output_pixels);
+
+vl_stbir_resize_rows_function vl_stbir_resize_rows_baseline;
+vl_stbir_resize_rows_function vl_stbir_resize_rows_avx2;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -257,7 +257,25 @@ int stbi_write_tga_with_rle = 1;
 int stbi_write_force_png_filter = -1;
 #endif
 
-static int stbi__flip_vertically_on_write = 0;
+// VelyraImage: the flip flag is thread local (like stbi_set_flip_vertically_on_load_thread in stb_image), so images
+// can be written concurrently with different flip settings
+#ifndef STBIW_THREAD_LOCAL
+   #if defined(__cplusplus) &&  __cplusplus >= 201103L
+      #define STBIW_THREAD_LOCAL      thread_local
+   #elif defined(__GNUC__) && __GNUC__ < 5
+      #define STBIW_THREAD_LOCAL      __thread
+   #elif defined(_MSC_VER)
+      #define STBIW_THREAD_LOCAL      __declspec(thread)
+   #elif defined (__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+      #define STBIW_THREAD_LOCAL      _Thread_local
+   #elif defined(__GNUC__)
+      #define STBIW_THREAD_LOCAL      __thread
+   #else
+      #define STBIW_THREAD_LOCAL
+   #endif
+#endif
+
+static STBIW_THREAD_LOCAL int stbi__flip_vertically_on_write = 0;
 
 STBIWDEF void stbi_flip_vertically_on_write(int flag)
 {
@@ -6,6 +6,7 @@
 #include <VelyraUtils/DevUtils/PrettyTypeFormatter.hpp>
 
 #include "../TypeUtils.hpp"
+#include "../../src/DataTypeConversion/DataTypeConversion.hpp"
 
 using namespace Velyra;
 using namespace Velyra::Image;
@@ -18,6 +19,7 @@ struct TargetTypeWrapper {
 
 using TargetDataTypes = Utils::TypeList<
     TargetTypeWrapper<VL_UINT8>,
+    TargetTypeWrapper<VL_UINT16>,
     TargetTypeWrapper<VL_FLOAT32>
 >;
 
@@ -35,6 +37,12 @@ public:
     static constexpr Size m_Height = 200;
 
 public:
+    void SetUp() override {
+        if (!isSimdModeSupported(SimdMode)) {
+            GTEST_SKIP() << "SIMD mode " << static_cast<int>(SimdMode) << " is not supported on this machine";
+        }
+    }
+
     template<typename T>
     std::vector<T> createImageData() {
         if constexpr (std::is_same_v<T, float>) {
@@ -57,6 +65,16 @@ public:
             }
             return data;
         }
+        else if constexpr (std::is_same_v<T, U16>) {
+            std::vector<T> data(m_Width * m_Height * 4);
+            for (Size i = 0; i < data.size(); i += 4) {
+                data[i] = 65535; // R
+                data[i + 1] = 0; // G
+                data[i + 2] = 65535; // B
+                data[i + 3] = 65535; // A
+            }
+            return data;
+        }
         else {
             VL_NOT_IMPLEMENTED();
         }
@@ -82,6 +100,15 @@ public:
             desc.data = data.data();
             return ImageFactory::createImageU8(desc);
         }
+        else if constexpr (std::is_same_v<T, U16>) {
+            ImageUI16Desc desc;
+            desc.width = m_Width;
+            desc.height = m_Height;
+            desc.format = VL_CHANNEL_RGBA;
+            auto data = createImageData<U16>();
+            desc.data = data.data();
+            return ImageFactory::createImageU16(desc);
+        }
         else {
             VL_NOT_IMPLEMENTED();
         }
@@ -110,4 +137,69 @@ TYPED_TEST(TestDataTypeConversion, ConvertDataType) {
             EXPECT_EQ(targetData[i], expectedData[i]);
         }
     }
-}
\ No newline at end of file
+}
+
+TYPED_TEST(TestDataTypeConversion, MatchesScalar) {
+    using SourceType = typename TestFixture::SourceType;
+    using TargetCppType = Utils::VLTypeToCpp<TestFixture::TargetDataType>::type;
+
+    // Every U8 value, a U16 ramp across the full range and a float ramp that hits the rounding boundaries, plus values
+    // outside [0.0, 1.0].
+    // The odd count exercises the scalar tails.
+    std::vector<SourceType> sourceData(1023);
+    for (Size i = 0; i < sourceData.size(); ++i) {
+        if constexpr (std::is_same_v<SourceType, U8>) {
+            sourceData[i] = static_cast<U8>(i % 256);
+        }
+        else if constexpr (std::is_same_v<SourceType, U16>) {
+            sourceData[i] = static_cast<U16>(i * 65535 / (sourceData.size() - 1));
+        }
+        else {
+            sourceData[i] = static_cast<float>(i) / 510.0f - 0.5f;
+        }
+    }
+    std::vector<TargetCppType> targetData(sourceData.size());
+    std::vector<TargetCppType> expectedData(sourceData.size());
+
+    TranslationDesc desc;
+    desc.targetType = TestFixture::TargetDataType;
+    desc.simdMode = TestFixture::SimdMode;
+    TranslateDataType::translateDataType<SourceType, TargetCppType>(sourceData, targetData, desc);
+    desc.simdMode = VL_SIMD_SCALAR;
+    TranslateDataType::translateDataType<SourceType, TargetCppType>(sourceData, expectedData, desc);
+
+    for (Size i = 0; i < targetData.size(); ++i) {
+        if constexpr (std::is_floating_point_v<TargetCppType>) {
+            EXPECT_FLOAT_EQ(targetData[i], expectedData[i]) << "at index " << i;
+        }
+        else {
+            EXPECT_EQ(targetData[i], expectedData[i]) << "at index " << i;
+        }
+    }
+}
+
+TEST(TestDataTypeConversionU16, RoundsToNearest) {
+    // U8 -> U16 -> U8 is lossless and U16 -> U8 rounds every value to the nearest U8
+    std::vector<U16> wide(65536);
+    for (Size i = 0; i < wide.size(); ++i) {
+        wide[i] = static_cast<U16>(i);
+    }
+    std::vector<U8> narrow(wide.size());
+    TranslationDesc desc;
+    desc.simdMode = VL_SIMD_SCALAR;
+    TranslateDataType::translateDataType<U16, U8>(wide, narrow, desc);
+    for (Size i = 0; i < wide.size(); ++i) {
+        EXPECT_EQ(narrow[i], static_cast<U8>(std::lround(static_cast<double>(i) / 257.0))) << "at value " << i;
+    }
+
+    std::vector<U8> bytes(256);
+    for (Size i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<U8>(i);
+    }
+    std::vector<U16> widened(bytes.size());
+    std::vector<U8> roundTrip(bytes.size());
+    TranslateDataType::translateDataType<U8, U16>(bytes, widened, desc);
+    TranslateDataType::translateDataType<U16, U8>(widened, roundTrip, desc);
+    EXPECT_EQ(widened[255], 65535);
+    EXPECT_EQ(roundTrip, bytes);
+}
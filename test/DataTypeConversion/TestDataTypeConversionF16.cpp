@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cmath>
+
+#include "../TypeUtils.hpp"
+#include "../../src/DataTypeConversion/DataTypeConversion.hpp"
+
+using namespace Velyra;
+using namespace Velyra::Image;
+using namespace Velyra::Test;
+
+namespace {
+
+    std::vector<F16> createAllHalves(const bool includeNaN) {
+        std::vector<F16> halves;
+        for (U32 bits = 0; bits <= 0xFFFF; ++bits) {
+            const F16 value{static_cast<U16>(bits)};
+            if (includeNaN || !std::isnan(f16ToFloat(value))) {
+                halves.push_back(value);
+            }
+        }
+        return halves;
+    }
+
+}
+
+TEST(TestF16, ConvertsSpecialValues) {
+    EXPECT_EQ(floatToF16(0.0f), F16{0x0000});
+    EXPECT_EQ(floatToF16(-0.0f), F16{0x8000});
+    EXPECT_EQ(floatToF16(1.0f), F16{0x3C00});
+    EXPECT_EQ(floatToF16(-2.0f), F16{0xC000});
+    EXPECT_EQ(floatToF16(65504.0f), F16{0x7BFF}); // Largest half
+    EXPECT_EQ(floatToF16(65519.0f), F16{0x7BFF});
+    EXPECT_EQ(floatToF16(65520.0f), F16{0x7C00}); // Rounds to infinity
+    EXPECT_EQ(floatToF16(INFINITY), F16{0x7C00});
+    EXPECT_EQ(floatToF16(std::ldexp(1.0f, -24)), F16{0x0001}); // Smallest subnormal
+    EXPECT_EQ(floatToF16(std::ldexp(1.0f, -26)), F16{0x0000});
+    EXPECT_TRUE(std::isnan(f16ToFloat(floatToF16(NAN))));
+
+    // Ties round to even
+    EXPECT_EQ(floatToF16(1.0f + std::ldexp(1.0f, -11)), F16{0x3C00});
+    EXPECT_EQ(floatToF16(1.0f + 3 * std::ldexp(1.0f, -11)), F16{0x3C02});
+    EXPECT_EQ(floatToF16(std::ldexp(1.0f, -25)), F16{0x0000});
+    EXPECT_EQ(floatToF16(3 * std::ldexp(1.0f, -25)), F16{0x0002});
+}
+
+TEST(TestF16, RoundTripsEveryHalf) {
+    for (const F16 value : createAllHalves(false)) {
+        EXPECT_EQ(floatToF16(f16ToFloat(value)), value) << "for bits " << value.bits;
+    }
+}
+
+template<typename SimdWrapper>
+class TestDataTypeConversionF16 : public ::testing::Test {
+public:
+    static constexpr VL_SIMD_MODE SimdMode = SimdWrapper::SimdMode;
+
+protected:
+    void SetUp() override {
+        if (!isSimdModeSupported(SimdMode)) {
+            GTEST_SKIP() << "SIMD mode " << static_cast<int>(SimdMode) << " is not supported on this machine";
+        }
+    }
+
+    template<typename SrcType, typename DstType>
+    static void expectMatchesScalar(const std::vector<SrcType>& sourceData) {
+        std::vector<DstType> targetData(sourceData.size());
+        std::vector<DstType> expectedData(sourceData.size());
+
+        TranslationDesc desc;
+        desc.simdMode = SimdMode;
+        TranslateDataType::translateDataType<SrcType, DstType>(sourceData, targetData, desc);
+        desc.simdMode = VL_SIMD_SCALAR;
+        TranslateDataType::translateDataType<SrcType, DstType>(sourceData, expectedData, desc);
+
+        for (Size i = 0; i < sourceData.size(); ++i) {
+            if constexpr (std::is_same_v<DstType, float>) {
+                // Compare the bits, so NaNs and signed zeros are checked as well
+                ASSERT_EQ(std::bit_cast<U32>(targetData[i]), std::bit_cast<U32>(expectedData[i])) << "at index " << i;
+            }
+            else {
+                ASSERT_EQ(targetData[i], expectedData[i]) << "at index " << i;
+            }
+        }
+    }
+};
+
+using F16SimdModes = Utils::ToGTestTypes<SimdModes>::type;
+TYPED_TEST_SUITE(TestDataTypeConversionF16, F16SimdModes);
+
+TYPED_TEST(TestDataTypeConversionF16, F16ToF32MatchesScalar) {
+    TestFixture::template expectMatchesScalar<F16, float>(createAllHalves(true));
+}
+
+TYPED_TEST(TestDataTypeConversionF16, F16ToU8MatchesScalar) {
+    // NaNs have no defined U8 value
+    TestFixture::template expectMatchesScalar<F16, U8>(createAllHalves(false));
+}
+
+TYPED_TEST(TestDataTypeConversionF16, F32ToF16MatchesScalar) {
+    // Every half and the values halfway between neighbouring halves (the rounding boundaries), plus values around
+    // the subnormal range and out of range values. The count is odd, which exercises the scalar tails.
+    std::vector<float> sourceData;
+    for (const F16 value : createAllHalves(true)) {
+        const float f = f16ToFloat(value);
+        sourceData.push_back(f);
+        sourceData.push_back(std::nextafter(f, INFINITY));
+        if (value.bits != 0x7BFF && value.bits != 0xFBFF && std::isfinite(f)) {
+            const float next = f16ToFloat(F16{static_cast<U16>(value.bits + 1)});
+            sourceData.push_back(std::isfinite(next) ? (f + next) * 0.5f : f);
+        }
+    }
+    sourceData.push_back(1e-40f); // Float subnormal
+    sourceData.push_back(1e10f);
+    TestFixture::template expectMatchesScalar<float, F16>(sourceData);
+}
+
+TYPED_TEST(TestDataTypeConversionF16, U8ToF16MatchesScalar) {
+    std::vector<U8> sourceData(1023);
+    for (Size i = 0; i < sourceData.size(); ++i) {
+        sourceData[i] = static_cast<U8>(i % 256);
+    }
+    TestFixture::template expectMatchesScalar<U8, F16>(sourceData);
+
+    // Every U8 value survives the round trip through F16
+    std::vector<F16> halves(sourceData.size());
+    std::vector<U8> roundTrip(sourceData.size());
+    TranslationDesc desc;
+    desc.simdMode = TestFixture::SimdMode;
+    TranslateDataType::translateDataType<U8, F16>(sourceData, halves, desc);
+    TranslateDataType::translateDataType<F16, U8>(halves, roundTrip, desc);
+    EXPECT_EQ(roundTrip, sourceData);
+}
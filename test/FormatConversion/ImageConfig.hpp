@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../../src/ImageU8.hpp"
+#include "../../src/ImageU16.hpp"
+#include "../../src/ImageF16.hpp"
 #include "../../src/ImageF32.hpp"
 
 using namespace Velyra;
@@ -9,8 +11,8 @@ using namespace Velyra::Image;
 template<typename IMAGE_TYPE, VL_SIMD_MODE simdMode>
 struct ImageConfig;
 
-template<>
-struct ImageConfig<ImageU8, VL_SIMD_SCALAR> {
+template<VL_SIMD_MODE SIMD_MODE>
+struct ImageConfig<ImageU8, SIMD_MODE> {
     using PixelType = U8;
     using ImageType = ImageU8;
     using ImageDesc = ImageU8Desc;
@@ -20,33 +22,51 @@ struct ImageConfig<ImageU8, VL_SIMD_SCALAR> {
     static constexpr PixelType a = 40;
     static constexpr PixelType fillMin = 0;
     static constexpr PixelType fillMax = 255;
-    static constexpr VL_SIMD_MODE simdMode = VL_SIMD_SCALAR;
+    static constexpr VL_SIMD_MODE simdMode = SIMD_MODE;
 
     static void expectEqual(const PixelType expected, const PixelType actual) {
         EXPECT_EQ(expected, actual);
     }
 };
 
-template<>
-struct ImageConfig<ImageU8, VL_SIMD_AVX2> {
-    using PixelType = U8;
-    using ImageType = ImageU8;
-    using ImageDesc = ImageU8Desc;
-    static constexpr PixelType r = 10;
-    static constexpr PixelType g = 20;
-    static constexpr PixelType b = 30;
-    static constexpr PixelType a = 40;
+template<VL_SIMD_MODE SIMD_MODE>
+struct ImageConfig<ImageU16, SIMD_MODE> {
+    using PixelType = U16;
+    using ImageType = ImageU16;
+    using ImageDesc = ImageUI16Desc;
+    static constexpr PixelType r = 1000;
+    static constexpr PixelType g = 2000;
+    static constexpr PixelType b = 3000;
+    static constexpr PixelType a = 4000;
     static constexpr PixelType fillMin = 0;
-    static constexpr PixelType fillMax = 255;
-    static constexpr VL_SIMD_MODE simdMode = VL_SIMD_AVX2;
+    static constexpr PixelType fillMax = 65535;
+    static constexpr VL_SIMD_MODE simdMode = SIMD_MODE;
 
     static void expectEqual(const PixelType expected, const PixelType actual) {
         EXPECT_EQ(expected, actual);
     }
 };
 
-template<>
-struct ImageConfig<ImageF32, VL_SIMD_SCALAR> {
+template<VL_SIMD_MODE SIMD_MODE>
+struct ImageConfig<ImageF16, SIMD_MODE> {
+    using PixelType = F16;
+    using ImageType = ImageF16;
+    using ImageDesc = ImageF16Desc;
+    static constexpr PixelType r = {0x3000}; // 0.125
+    static constexpr PixelType g = {0x3400}; // 0.25
+    static constexpr PixelType b = {0x3600}; // 0.375
+    static constexpr PixelType a = {0x3800}; // 0.5
+    static constexpr PixelType fillMin = {0x0000}; // 0.0
+    static constexpr PixelType fillMax = {0x3C00}; // 1.0
+    static constexpr VL_SIMD_MODE simdMode = SIMD_MODE;
+
+    static void expectEqual(const PixelType expected, const PixelType actual) {
+        EXPECT_EQ(expected.bits, actual.bits);
+    }
+};
+
+template<VL_SIMD_MODE SIMD_MODE>
+struct ImageConfig<ImageF32, SIMD_MODE> {
     using PixelType = float;
     using ImageType = ImageF32;
     using ImageDesc = ImageF32Desc;
@@ -56,9 +76,9 @@ struct ImageConfig<ImageF32, VL_SIMD_SCALAR> {
     static constexpr PixelType a = 0.4f;
     static constexpr PixelType fillMin = 0.0f;
     static constexpr PixelType fillMax = 1.0f;
-    static constexpr VL_SIMD_MODE simdMode = VL_SIMD_SCALAR;
+    static constexpr VL_SIMD_MODE simdMode = SIMD_MODE;
 
     static void expectEqual(const PixelType expected, const PixelType actual) {
         EXPECT_FLOAT_EQ(expected, actual);
     }
-};
\ No newline at end of file
+};
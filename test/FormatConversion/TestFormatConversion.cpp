@@ -18,6 +18,12 @@ public:
     static constexpr PixelType fillMax = IMAGE_CONFIG::fillMax;
 
 protected:
+    void SetUp() override {
+        if (!isSimdModeSupported(IMAGE_CONFIG::simdMode)) {
+            GTEST_SKIP() << "SIMD mode " << static_cast<int>(IMAGE_CONFIG::simdMode) << " is not supported on this machine";
+        }
+    }
+
     static ImageType createImage(const U32 width, const U32 height, const VL_CHANNEL_FORMAT format) {
         ImageDesc desc;
         desc.width = width;
@@ -64,7 +70,19 @@ protected:
     }
 };
 
-using TestTypes = ::testing::Types<ImageConfig<ImageU8, VL_SIMD_SCALAR>, ImageConfig<ImageF32, VL_SIMD_SCALAR>, ImageConfig<ImageU8, VL_SIMD_AVX2>>;
+using TestTypes = ::testing::Types<
+    ImageConfig<ImageU8, VL_SIMD_SCALAR>, ImageConfig<ImageU16, VL_SIMD_SCALAR>, ImageConfig<ImageF16, VL_SIMD_SCALAR>,
+    ImageConfig<ImageF32, VL_SIMD_SCALAR>,
+    ImageConfig<ImageU8, VL_SIMD_SSE2>, ImageConfig<ImageU16, VL_SIMD_SSE2>, ImageConfig<ImageF16, VL_SIMD_SSE2>,
+    ImageConfig<ImageF32, VL_SIMD_SSE2>,
+    ImageConfig<ImageU8, VL_SIMD_SSSE3>, ImageConfig<ImageU16, VL_SIMD_SSSE3>, ImageConfig<ImageF16, VL_SIMD_SSSE3>,
+    ImageConfig<ImageF32, VL_SIMD_SSSE3>,
+    ImageConfig<ImageU8, VL_SIMD_SSE41>, ImageConfig<ImageU16, VL_SIMD_SSE41>, ImageConfig<ImageF16, VL_SIMD_SSE41>,
+    ImageConfig<ImageF32, VL_SIMD_SSE41>,
+    ImageConfig<ImageU8, VL_SIMD_AVX2>, ImageConfig<ImageU16, VL_SIMD_AVX2>, ImageConfig<ImageF16, VL_SIMD_AVX2>,
+    ImageConfig<ImageF32, VL_SIMD_AVX2>,
+    ImageConfig<ImageU8, VL_SIMD_AVX512>, ImageConfig<ImageU16, VL_SIMD_AVX512>, ImageConfig<ImageF16, VL_SIMD_AVX512>,
+    ImageConfig<ImageF32, VL_SIMD_AVX512>>;
 TYPED_TEST_SUITE(TestFormatConversion, TestTypes);
 
 TYPED_TEST(TestFormatConversion, DefineSwizzle) {
@@ -88,6 +106,21 @@ TYPED_TEST(TestFormatConversion, DefineSwizzle) {
         const std::vector<int> expected = {0, -1, -1, -1};
         EXPECT_EQ(swizzle, expected);
     }
+    {
+        const std::vector<int> swizzle = defineSwizzle(VL_CHANNEL_FORMAT_MAX_VALUE, VL_CHANNEL_RGBA);
+        EXPECT_TRUE(swizzle.empty());
+    }
+}
+
+TYPED_TEST(TestFormatConversion, UnsupportedFormatThrows) {
+    using C = TypeParam;
+
+    std::vector<typename C::PixelType> sourceData(16);
+    std::vector<typename C::PixelType> targetData(16);
+    FormatConversionDesc desc;
+    desc.targetFormat = VL_CHANNEL_FORMAT_MAX_VALUE;
+    desc.simdMode = C::simdMode;
+    EXPECT_ANY_THROW(convertFormat<typename C::PixelType>(VL_CHANNEL_RGBA, sourceData, targetData, desc));
 }
 
 TYPED_TEST(TestFormatConversion, GetFillValue) {
@@ -187,3 +220,138 @@ TYPED_TEST(TestFormatConversion, R_2_BGRA) {
     }
 }
 
+TYPED_TEST(TestFormatConversion, AllFormatPairsMatchScalar) {
+    /*
+     * Convert between every pair of channel formats with the configured SIMD mode and compare against the scalar
+     * path. The odd image size makes sure the vector loops end with a partial block.
+     */
+    using C = TypeParam;
+    using PixelType = typename C::PixelType;
+    constexpr U32 width = 37;
+    constexpr U32 height = 5;
+    constexpr std::array<VL_CHANNEL_FORMAT, 6> formats = {
+        VL_CHANNEL_R, VL_CHANNEL_RG, VL_CHANNEL_RGB, VL_CHANNEL_RGBA, VL_CHANNEL_BGR, VL_CHANNEL_BGRA
+    };
+
+    for (const VL_CHANNEL_FORMAT sourceFormat : formats) {
+        typename C::ImageDesc sourceDesc;
+        sourceDesc.width = width;
+        sourceDesc.height = height;
+        sourceDesc.format = sourceFormat;
+        typename C::ImageType sourceImage(sourceDesc);
+        auto* sourceData = static_cast<PixelType*>(sourceImage.getData());
+        for (Size i = 0; i < sourceImage.getCount(); ++i) {
+            // Distinct value for every element, so any misplaced channel is detected
+            if constexpr (std::is_floating_point_v<PixelType>) {
+                sourceData[i] = static_cast<PixelType>(i) * 0.001f;
+            }
+            else {
+                sourceData[i] = static_cast<PixelType>(i % 251);
+            }
+        }
+
+        for (const VL_CHANNEL_FORMAT targetFormat : formats) {
+            for (const VL_FORMAT_CONVERSION_FILL fillMode : {VL_FILL_MIN, VL_FILL_MAX}) {
+                FormatConversionDesc desc;
+                desc.targetFormat = targetFormat;
+                desc.fillMode = fillMode;
+                desc.simdMode = C::simdMode;
+                auto targetImage = sourceImage.convertToFormat(desc);
+
+                desc.simdMode = VL_SIMD_SCALAR;
+                auto expectedImage = sourceImage.convertToFormat(desc);
+
+                ASSERT_EQ(targetImage->getCount(), expectedImage->getCount());
+                const auto* targetData = static_cast<const PixelType*>(targetImage->getData());
+                const auto* expectedData = static_cast<const PixelType*>(expectedImage->getData());
+                for (Size i = 0; i < targetImage->getCount(); ++i) {
+                    ASSERT_EQ(targetData[i], expectedData[i]) << "Conversion " << static_cast<int>(sourceFormat) << " -> " << static_cast<int>(targetFormat)
+                        << " differs at element " << i;
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(TestFormatConversion, InPlaceMatchesCopy) {
+    /*
+     * Converts every format pair in place and compares against convertToFormat. The pairs with the same channel count
+     * are reordered in place, the others fall back to a new buffer.
+     */
+    using C = TypeParam;
+    using PixelType = typename C::PixelType;
+    constexpr U32 width = 37;
+    constexpr U32 height = 5;
+    constexpr std::array<VL_CHANNEL_FORMAT, 6> formats = {
+        VL_CHANNEL_R, VL_CHANNEL_RG, VL_CHANNEL_RGB, VL_CHANNEL_RGBA, VL_CHANNEL_BGR, VL_CHANNEL_BGRA
+    };
+
+    for (const VL_CHANNEL_FORMAT sourceFormat : formats) {
+        for (const VL_CHANNEL_FORMAT targetFormat : formats) {
+            typename C::ImageDesc sourceDesc;
+            sourceDesc.width = width;
+            sourceDesc.height = height;
+            sourceDesc.format = sourceFormat;
+            typename C::ImageType image(sourceDesc);
+            auto* data = static_cast<PixelType*>(image.getData());
+            for (Size i = 0; i < image.getCount(); ++i) {
+                if constexpr (std::is_floating_point_v<PixelType>) {
+                    data[i] = static_cast<PixelType>(i) * 0.001f;
+                }
+                else {
+                    data[i] = static_cast<PixelType>(i % 251);
+                }
+            }
+
+            FormatConversionDesc desc;
+            desc.targetFormat = targetFormat;
+            desc.simdMode = C::simdMode;
+            auto expectedImage = image.convertToFormat(desc);
+            const void* dataBefore = image.getData();
+            image.convertToFormatInPlace(desc);
+
+            EXPECT_EQ(image.getChannelFormat(), targetFormat);
+            if (getChannelCountFromFormat(sourceFormat) == getChannelCountFromFormat(targetFormat)) {
+                EXPECT_EQ(image.getData(), dataBefore) << "Conversion " << static_cast<int>(sourceFormat) << " -> "
+                    << static_cast<int>(targetFormat) << " reallocated";
+            }
+            ASSERT_EQ(image.getCount(), expectedImage->getCount());
+            const auto* actualData = static_cast<const PixelType*>(image.getData());
+            const auto* expectedData = static_cast<const PixelType*>(expectedImage->getData());
+            for (Size i = 0; i < image.getCount(); ++i) {
+                ASSERT_EQ(actualData[i], expectedData[i]) << "Conversion " << static_cast<int>(sourceFormat) << " -> "
+                    << static_cast<int>(targetFormat) << " differs at element " << i;
+            }
+        }
+    }
+}
+
+TYPED_TEST(TestFormatConversion, InPlaceLargeImage) {
+    // Large enough to be split into blocks that run in parallel
+    using C = TypeParam;
+    using PixelType = typename C::PixelType;
+
+    typename C::ImageType image = this->createImage(1024, 512, VL_CHANNEL_BGR);
+    FormatConversionDesc desc;
+    desc.targetFormat = VL_CHANNEL_RGB;
+    desc.simdMode = C::simdMode;
+    image.convertToFormatInPlace(desc);
+    EXPECT_EQ(image.getChannelFormat(), VL_CHANNEL_RGB);
+
+    const auto* data = static_cast<const PixelType*>(image.getData());
+    for (Size i = 0; i < image.getCount(); i += 3) {
+        ASSERT_EQ(data[i + 0], C::r);
+        ASSERT_EQ(data[i + 1], C::g);
+        ASSERT_EQ(data[i + 2], C::b);
+    }
+}
+
+TYPED_TEST(TestFormatConversion, InPlaceUnsupportedFormatThrows) {
+    using C = TypeParam;
+
+    std::vector<typename C::PixelType> data(16);
+    FormatConversionDesc desc;
+    desc.targetFormat = VL_CHANNEL_RGB;
+    desc.simdMode = C::simdMode;
+    EXPECT_ANY_THROW(convertFormatInPlace<typename C::PixelType>(VL_CHANNEL_RGBA, data, desc));
+}
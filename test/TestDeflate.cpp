@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include "../src/Png/Deflate.hpp"
+#include "TypeUtils.hpp"
+
+#include <stb_image.h>
+
+using namespace Velyra;
+using namespace Velyra::Image;
+using namespace Velyra::Test;
+
+class TestDeflate : public ::testing::Test {
+protected:
+
+    /**
+     * Pixel like data: repeated rows with some noise, so matches at short and long distances occur.
+     */
+    static std::vector<U8> createData(const Size size) {
+        std::vector<U8> data(size);
+        fillNoise(data, 0x12345678);
+        for (Size i = 0; i < size; ++i) {
+            // Keep about every eighth noise byte
+            if ((data[i] & 0x7) != 0) {
+                data[i] = static_cast<U8>((i % 1000) * 7 / 3);
+            }
+        }
+        return data;
+    }
+
+    static std::vector<U8> inflate(const std::vector<U8>& compressed) {
+        int size = 0;
+        char* decoded = stbi_zlib_decode_noheader_malloc(reinterpret_cast<const char*>(compressed.data()),
+            static_cast<int>(compressed.size()), &size);
+        if (!decoded) {
+            ADD_FAILURE() << "Invalid deflate stream: " << stbi_failure_reason();
+            return {};
+        }
+        std::vector<U8> result(decoded, decoded + size);
+        stbi_image_free(decoded);
+        return result;
+    }
+};
+
+TEST_F(TestDeflate, RoundTripsEveryLevel) {
+    const std::vector<U8> data = createData(200000);
+    for (U32 level = 0; level <= 9; ++level) {
+        DeflateEncoder encoder(level);
+        encoder.write(data);
+        encoder.finish();
+        const std::vector<U8> compressed = encoder.getOutput();
+        if (level != 0) {
+            EXPECT_LT(compressed.size(), data.size()) << "level " << level;
+        }
+        EXPECT_EQ(inflate(compressed), data) << "level " << level;
+    }
+}
+
+TEST_F(TestDeflate, RoundTripsPiecewiseWritesAndFlushes) {
+    // Matches span the writes, the output is drained while writing
+    const std::vector<U8> data = createData(150000);
+    DeflateEncoder encoder(6);
+    std::vector<U8> compressed;
+    for (Size offset = 0, piece = 1; offset < data.size(); piece = piece * 3 + 1) {
+        const Size count = std::min(piece % 5000 + 1, data.size() - offset);
+        encoder.write(std::span(data).subspan(offset, count));
+        offset += count;
+        if (piece % 7 == 0) {
+            encoder.flush();
+        }
+        compressed.insert(compressed.end(), encoder.getOutput().begin(), encoder.getOutput().end());
+        encoder.getOutput().clear();
+    }
+    encoder.finish();
+    compressed.insert(compressed.end(), encoder.getOutput().begin(), encoder.getOutput().end());
+    EXPECT_EQ(inflate(compressed), data);
+}
+
+TEST_F(TestDeflate, ConcatenatesBlocksCompressedWithDictionary) {
+    // The blocks are compressed independently with the end of the previous block as dictionary, like pigz
+    const std::vector<U8> data = createData(100000);
+    const std::span<const U8> input(data);
+    constexpr Size blockSize = 30000;
+    std::vector<U8> compressed;
+    Size dictionaryCompressedSize = 0;
+    for (Size offset = 0; offset < data.size(); offset += blockSize) {
+        const std::span<const U8> block = input.subspan(offset, std::min(blockSize, data.size() - offset));
+        DeflateEncoder encoder(6);
+        encoder.setDictionary(input.first(offset));
+        encoder.write(block);
+        if (offset + blockSize >= data.size()) {
+            encoder.finish();
+        }
+        else {
+            encoder.flush();
+        }
+        compressed.insert(compressed.end(), encoder.getOutput().begin(), encoder.getOutput().end());
+        dictionaryCompressedSize += encoder.getOutput().size();
+    }
+    EXPECT_EQ(inflate(compressed), data);
+
+    // Without the dictionary the matches cannot reach into the previous block
+    Size plainCompressedSize = 0;
+    for (Size offset = 0; offset < data.size(); offset += blockSize) {
+        DeflateEncoder encoder(6);
+        encoder.write(input.subspan(offset, std::min(blockSize, data.size() - offset)));
+        encoder.flush();
+        plainCompressedSize += encoder.getOutput().size();
+    }
+    EXPECT_LT(dictionaryCompressedSize, plainCompressedSize);
+
+    DeflateEncoder encoder(6);
+    encoder.write(input.first(10));
+    EXPECT_ANY_THROW(encoder.setDictionary(input.first(10)));
+}
+
+TEST_F(TestDeflate, FlushEndsOnByteBoundary) {
+    const std::vector<U8> data = createData(1000);
+    DeflateEncoder encoder(9);
+    encoder.write(data);
+    encoder.flush();
+    const std::vector<U8>& output = encoder.getOutput();
+    ASSERT_GE(output.size(), 4);
+    EXPECT_EQ(std::vector<U8>(output.end() - 4, output.end()), (std::vector<U8>{0x00, 0x00, 0xFF, 0xFF}));
+}
+
+TEST_F(TestDeflate, EmptyStream) {
+    DeflateEncoder encoder(9);
+    encoder.finish();
+    EXPECT_TRUE(inflate(encoder.getOutput()).empty());
+}
+
+TEST_F(TestDeflate, Adler32) {
+    const std::string text = "Wikipedia";
+    const std::span bytes(reinterpret_cast<const U8*>(text.data()), text.size());
+    EXPECT_EQ(updateAdler32(1, bytes), 0x11E60398u);
+    // Updating piecewise gives the same checksum
+    EXPECT_EQ(updateAdler32(updateAdler32(1, bytes.first(4)), bytes.subspan(4)), 0x11E60398u);
+
+    const std::vector<U8> data(100000, 255);
+    U32 expectedA = 1;
+    U32 expectedB = 0;
+    for (const U8 value : data) {
+        expectedA = (expectedA + value) % 65521;
+        expectedB = (expectedB + expectedA) % 65521;
+    }
+    EXPECT_EQ(updateAdler32(1, data), expectedB << 16 | expectedA);
+
+}
+
+TEST_F(TestDeflate, CombinesAdler32) {
+    const std::vector<U8> data = createData(100000);
+    const std::span<const U8> bytes(data);
+    const U32 expected = updateAdler32(1, bytes);
+    for (const Size split : {Size{0}, Size{1}, Size{5552}, Size{65521}, Size{99999}, Size{100000}}) {
+        const U32 first = updateAdler32(1, bytes.first(split));
+        const U32 second = updateAdler32(1, bytes.subspan(split));
+        EXPECT_EQ(combineAdler32(first, second, data.size() - split), expected) << "split " << split;
+    }
+}
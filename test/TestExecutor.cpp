@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <VelyraImage/Executor.hpp>
+
+#include "../src/FormatConversion/FormatConversion.hpp"
+#include "../src/DataTypeConversion/DataTypeConversion.hpp"
+#include "../src/ImageUtils.hpp"
+
+#include <atomic>
+#include <numeric>
+
+using namespace Velyra;
+using namespace Velyra::Image;
+
+namespace {
+
+    // Runs the tasks inline and counts how often it was used
+    class CountingExecutor: public IExecutor {
+    public:
+        Size getConcurrency() const override { return 4; }
+
+        void parallelFor(const Size taskCount, const std::function<void(Size)>& task) override {
+            ++calls;
+            tasks += taskCount;
+            for (Size i = 0; i < taskCount; ++i) {
+                task(i);
+            }
+        }
+
+        Size calls = 0;
+        Size tasks = 0;
+    };
+
+}
+
+class TestExecutor : public ::testing::Test {
+protected:
+    void TearDown() override {
+        setExecutor(nullptr);
+    }
+};
+
+TEST_F(TestExecutor, RunsEveryTaskOnce) {
+    const SP<IExecutor> pool = createThreadPool(4);
+    EXPECT_EQ(pool->getConcurrency(), 4);
+
+    std::vector<std::atomic<int>> counts(1000);
+    pool->parallelFor(counts.size(), [&](const Size i) { ++counts[i]; });
+    for (const auto& count: counts) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST_F(TestExecutor, NestedParallelFor) {
+    const SP<IExecutor> pool = createThreadPool(3);
+    std::atomic<Size> total = 0;
+    pool->parallelFor(8, [&](Size) {
+        pool->parallelFor(16, [&](const Size j) { total += j; });
+    });
+    EXPECT_EQ(total.load(), 8 * (15 * 16 / 2));
+}
+
+TEST_F(TestExecutor, RethrowsTaskException) {
+    const SP<IExecutor> pool = createThreadPool(4);
+    std::atomic<Size> finished = 0;
+    EXPECT_ANY_THROW(pool->parallelFor(64, [&](const Size i) {
+        if (i == 13) {
+            throw std::runtime_error("task failed");
+        }
+        ++finished;
+    }));
+    EXPECT_EQ(finished.load(), 63);
+}
+
+TEST_F(TestExecutor, SingleThreadPoolRunsInline) {
+    const SP<IExecutor> pool = createThreadPool(1);
+    EXPECT_EQ(pool->getConcurrency(), 1);
+    const auto caller = std::this_thread::get_id();
+    pool->parallelFor(10, [&](Size) { EXPECT_EQ(std::this_thread::get_id(), caller); });
+}
+
+TEST_F(TestExecutor, SmallInputRunsInline) {
+    auto executor = createSP<CountingExecutor>();
+    setExecutor(executor);
+    Size calls = 0;
+    parallelForBlocks(VL_EXECUTION_PARALLEL, 16, 4, [&](const Size begin, const Size end) {
+        EXPECT_EQ(begin, 0);
+        EXPECT_EQ(end, 16);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(executor->calls, 0);
+}
+
+TEST_F(TestExecutor, BlocksCoverRange) {
+    auto executor = createSP<CountingExecutor>();
+    setExecutor(executor);
+    const Size itemCount = PARALLEL_MIN_BYTES + 12345;
+    std::vector<U8> visited(itemCount, 0);
+    parallelForBlocks(VL_EXECUTION_PARALLEL, itemCount, 1, [&](const Size begin, const Size end) {
+        EXPECT_LE(end - begin, PARALLEL_BLOCK_BYTES);
+        for (Size i = begin; i < end; ++i) {
+            ++visited[i];
+        }
+    });
+    EXPECT_EQ(executor->calls, 1);
+    EXPECT_GT(executor->tasks, 1);
+    EXPECT_TRUE(std::all_of(visited.begin(), visited.end(), [](const U8 v) { return v == 1; }));
+
+    // Sequential execution never uses the executor
+    parallelForBlocks(VL_EXECUTION_SEQUENTIAL, itemCount, 1, [](Size, Size) {});
+    EXPECT_EQ(executor->calls, 1);
+}
+
+TEST_F(TestExecutor, ParallelConversionMatchesSequential) {
+    setExecutor(createThreadPool(4));
+    constexpr Size pixelCount = 1024 * 1024 + 7;
+    std::vector<U8> source(pixelCount * 3);
+    std::iota(source.begin(), source.end(), static_cast<U8>(0));
+
+    FormatConversionDesc desc;
+    desc.targetFormat = VL_CHANNEL_BGRA;
+    desc.executionPolicy = VL_EXECUTION_SEQUENTIAL;
+    std::vector<U8> expected(pixelCount * 4);
+    convertFormat<U8>(VL_CHANNEL_RGB, source, expected, desc);
+
+    desc.executionPolicy = VL_EXECUTION_PARALLEL;
+    std::vector<U8> actual(pixelCount * 4);
+    convertFormat<U8>(VL_CHANNEL_RGB, source, actual, desc);
+    EXPECT_EQ(actual, expected);
+
+    TranslationDesc translationDesc;
+    translationDesc.targetType = VL_FLOAT32;
+    translationDesc.executionPolicy = VL_EXECUTION_SEQUENTIAL;
+    std::vector<float> expectedF32(source.size());
+    TranslateDataType::translateDataType<U8, float>(source, expectedF32, translationDesc);
+
+    translationDesc.executionPolicy = VL_EXECUTION_PARALLEL;
+    std::vector<float> actualF32(source.size());
+    TranslateDataType::translateDataType<U8, float>(source, actualF32, translationDesc);
+    EXPECT_EQ(actualF32, expectedF32);
+}
+
+TEST_F(TestExecutor, SplitResizeMatchesSingleThreaded) {
+    auto executor = createSP<CountingExecutor>();
+    setExecutor(executor);
+    constexpr Size width = 1024;
+    constexpr Size height = 768;
+    constexpr Size targetWidth = 300;
+    constexpr Size targetHeight = 200;
+    std::vector<U8> source(width * height * 4);
+    for (Size i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<U8>((i * 31 + i / 4096) % 256);
+    }
+
+    std::vector<U8> expected(targetWidth * targetHeight * 4);
+    ASSERT_TRUE(resizePixels(source.data(), width, height, expected.data(), targetWidth, targetHeight, VL_CHANNEL_RGBA,
+        STBIR_TYPE_UINT8, VL_EXECUTION_SEQUENTIAL));
+    EXPECT_EQ(executor->calls, 0);
+
+    std::vector<U8> actual(expected.size());
+    ASSERT_TRUE(resizePixels(source.data(), width, height, actual.data(), targetWidth, targetHeight, VL_CHANNEL_RGBA,
+        STBIR_TYPE_UINT8, VL_EXECUTION_PARALLEL));
+    EXPECT_EQ(executor->calls, 1);
+    EXPECT_GT(executor->tasks, 1);
+    EXPECT_EQ(actual, expected);
+}
@@ -27,4 +27,17 @@ TEST_F(TestImageDefs, TestGetChannelFormatFromCount) {
     EXPECT_EQ(getChannelFormatFromCount(5), VL_CHANNEL_FORMAT_MAX_VALUE);
 }
 
-
+TEST_F(TestImageDefs, TestIsSimdModeSupported) {
+    EXPECT_TRUE(isSimdModeSupported(VL_SIMD_BEST));
+    EXPECT_TRUE(isSimdModeSupported(VL_SIMD_SCALAR));
+    EXPECT_FALSE(isSimdModeSupported(VL_SIMD_MODE_MAX_VALUE));
+    // A wider instruction set implies the narrower ones
+    if (isSimdModeSupported(VL_SIMD_AVX2)) {
+        EXPECT_TRUE(isSimdModeSupported(VL_SIMD_SSE41));
+        EXPECT_TRUE(isSimdModeSupported(VL_SIMD_SSSE3));
+        EXPECT_TRUE(isSimdModeSupported(VL_SIMD_SSE2));
+    }
+    if (isSimdModeSupported(VL_SIMD_AVX512)) {
+        EXPECT_TRUE(isSimdModeSupported(VL_SIMD_AVX2));
+    }
+}
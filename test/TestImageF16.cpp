@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <VelyraImage/ImageDefs.hpp>
+#include <VelyraImage/ImageFactory.hpp>
+
+#include "../src/ImageF16.hpp"
+#include "../src/ImageF32.hpp"
+
+using namespace Velyra;
+using namespace Velyra::Image;
+
+class TestImageF16 : public ::testing::Test {
+protected:
+
+    static std::vector<float> createGradient(const Size count) {
+        std::vector<float> data(count);
+        for (Size i = 0; i < count; ++i) {
+            data[i] = static_cast<float>(i % 97) / 8.0f; // HDR values above 1.0
+        }
+        return data;
+    }
+
+    static void expectMatchesF32(const IImage& image, const IImage& expected) {
+        ASSERT_EQ(image.getDataType(), VL_FLOAT16);
+        ASSERT_EQ(image.getWidth(), expected.getWidth());
+        ASSERT_EQ(image.getHeight(), expected.getHeight());
+        ASSERT_EQ(image.getChannelFormat(), expected.getChannelFormat());
+        auto pixelPtr = static_cast<const F16*>(image.getData());
+        auto expectedPtr = static_cast<const float*>(expected.getData());
+        for (Size i = 0; i < image.getCount(); ++i) {
+            ASSERT_EQ(pixelPtr[i], floatToF16(expectedPtr[i])) << "at index " << i;
+        }
+    }
+};
+
+TEST_F(TestImageF16, ReadImageFromFile) {
+    /*
+     * Load the 100x100 red HDR image as F16, in the file format and in a different format, and compare it with the
+     * F32 image.
+     */
+    for (const VL_CHANNEL_FORMAT format : {VL_CHANNEL_FORMAT_MAX_VALUE, VL_CHANNEL_BGRA}) {
+        ImageLoadDesc desc;
+        desc.fileName = fs::current_path() / "Resources" / "Red-100x100-F32-RGB.hdr";
+        desc.flipOnLoad = true;
+        desc.requestedFormat = format;
+        UP<IImage> image = ImageFactory::createImageF16(desc);
+        ImageF32 expected(desc);
+        EXPECT_EQ(image->getSize(), image->getCount() * sizeof(F16));
+        expectMatchesF32(*image, expected);
+    }
+}
+
+TEST_F(TestImageF16, CreateImageFromData) {
+    ImageF16Desc desc;
+    desc.width = 3;
+    desc.height = 2;
+    desc.format = VL_CHANNEL_RG;
+    UP<IImage> emptyImage = ImageFactory::createImageF16(desc);
+    EXPECT_EQ(emptyImage->getDataType(), VL_FLOAT16);
+    EXPECT_EQ(emptyImage->getSize(), 3 * 2 * 2 * sizeof(F16));
+    auto emptyPtr = static_cast<const F16*>(emptyImage->getData());
+    for (Size i = 0; i < emptyImage->getCount(); ++i) {
+        EXPECT_EQ(f16ToFloat(emptyPtr[i]), 1.0f);
+    }
+
+    const std::vector<F16> data = {{0x3C00}, {0x3800}, {0x0000}, {0xC000}, {0x7BFF}, {0x0001},
+                                   {0x3555}, {0x4248}, {0x8000}, {0x3C01}, {0x2E66}, {0x5640}};
+    desc.data = data.data();
+    UP<IImage> image = ImageFactory::createImageF16(desc);
+    auto pixelPtr = static_cast<const F16*>(image->getData());
+    for (Size i = 0; i < image->getCount(); ++i) {
+        EXPECT_EQ(pixelPtr[i], data[i]);
+    }
+}
+
+TEST_F(TestImageF16, TranslateDataType) {
+    /*
+     * F32 -> F16 -> F32 and U8 -> F16 -> U8 round trips.
+     */
+    const std::vector<float> floatData = createGradient(17 * 5 * 4);
+    ImageF32Desc floatDesc;
+    floatDesc.width = 17;
+    floatDesc.height = 5;
+    floatDesc.data = floatData.data();
+    ImageF32 floatImage(floatDesc);
+
+    TranslationDesc desc;
+    desc.targetType = VL_FLOAT16;
+    UP<IImage> halfImage = floatImage.translateDataType(desc);
+    expectMatchesF32(*halfImage, floatImage);
+
+    desc.targetType = VL_FLOAT32;
+    UP<IImage> roundTrip = halfImage->translateDataType(desc);
+    auto roundTripPtr = static_cast<const float*>(roundTrip->getData());
+    for (Size i = 0; i < floatData.size(); ++i) {
+        EXPECT_EQ(roundTripPtr[i], floatData[i]); // Multiples of 1/8 below 2048 are exact halves
+    }
+
+    std::vector<U8> byteData(16 * 16);
+    for (Size i = 0; i < byteData.size(); ++i) {
+        byteData[i] = static_cast<U8>(i);
+    }
+    ImageU8Desc byteDesc;
+    byteDesc.width = 16;
+    byteDesc.height = 16;
+    byteDesc.format = VL_CHANNEL_R;
+    byteDesc.data = byteData.data();
+    UP<IImage> byteImage = ImageFactory::createImageU8(byteDesc);
+    desc.targetType = VL_FLOAT16;
+    halfImage = byteImage->translateDataType(desc);
+    desc.targetType = VL_UINT8;
+    UP<IImage> byteRoundTrip = halfImage->translateDataType(desc);
+    auto byteRoundTripPtr = static_cast<const U8*>(byteRoundTrip->getData());
+    for (Size i = 0; i < byteData.size(); ++i) {
+        EXPECT_EQ(byteRoundTripPtr[i], byteData[i]);
+    }
+
+    desc.targetType = VL_UINT16;
+    EXPECT_EQ(halfImage->translateDataType(desc), nullptr);
+}
+
+TEST_F(TestImageF16, Transform) {
+    /*
+     * A fused transform from F32 RGB to flipped F16 BGRA matches the conversion, the flip and the translation done
+     * one after the other.
+     */
+    const std::vector<float> floatData = createGradient(13 * 7 * 3);
+    ImageF32Desc floatDesc;
+    floatDesc.width = 13;
+    floatDesc.height = 7;
+    floatDesc.format = VL_CHANNEL_RGB;
+    floatDesc.data = floatData.data();
+    ImageF32 floatImage(floatDesc);
+
+    TransformDesc transformDesc;
+    transformDesc.targetFormat = VL_CHANNEL_BGRA;
+    transformDesc.fillMode = VL_FILL_MIN;
+    transformDesc.targetType = VL_FLOAT16;
+    transformDesc.flipVertical = true;
+    UP<IImage> halfImage = floatImage.transform(transformDesc);
+
+    FormatConversionDesc conversionDesc;
+    conversionDesc.targetFormat = VL_CHANNEL_BGRA;
+    conversionDesc.fillMode = VL_FILL_MIN;
+    conversionDesc.flipVertical = true;
+    UP<IImage> expected = floatImage.convertToFormat(conversionDesc);
+    expectMatchesF32(*halfImage, *expected);
+
+    // And back, with the F16 image as the source
+    transformDesc.targetFormat = VL_CHANNEL_RGB;
+    transformDesc.targetType = VL_FLOAT32;
+    UP<IImage> roundTrip = halfImage->transform(transformDesc);
+    auto roundTripPtr = static_cast<const float*>(roundTrip->getData());
+    for (Size i = 0; i < floatData.size(); ++i) {
+        EXPECT_EQ(roundTripPtr[i], floatData[i]);
+    }
+}
+
+TEST_F(TestImageF16, WriteImageToFile) {
+    const std::vector<float> floatData = createGradient(20 * 10 * 3);
+    ImageF32Desc floatDesc;
+    floatDesc.width = 20;
+    floatDesc.height = 10;
+    floatDesc.format = VL_CHANNEL_RGB;
+    floatDesc.data = floatData.data();
+    TranslationDesc translationDesc;
+    translationDesc.targetType = VL_FLOAT16;
+    UP<IImage> image = ImageF32(floatDesc).translateDataType(translationDesc);
+
+    ImageWriteDesc writeDesc;
+    writeDesc.fileName = fs::current_path() / "TestImageF16-WriteImageToFile.hdr";
+    writeDesc.fileType = VL_IMAGE_HDR;
+    image->write(writeDesc);
+
+    ImageLoadDesc loadDesc;
+    loadDesc.fileName = writeDesc.fileName;
+    loadDesc.flipOnLoad = false;
+    ImageF16 loadedImage(loadDesc);
+    EXPECT_EQ(loadedImage.getWidth(), 20);
+    EXPECT_EQ(loadedImage.getHeight(), 10);
+    EXPECT_EQ(loadedImage.getChannelFormat(), VL_CHANNEL_RGB);
+    auto pixelPtr = static_cast<const F16*>(loadedImage.getData());
+    for (Size i = 0; i < floatData.size(); ++i) {
+        // RGBE keeps 8 mantissa bits for the largest channel of a pixel
+        EXPECT_NEAR(f16ToFloat(pixelPtr[i]), floatData[i], floatData[i] / 64.0f + 0.1f);
+    }
+}
+
+TEST_F(TestImageF16, ResizeImage) {
+    ImageF16Desc desc;
+    desc.width = 30;
+    desc.height = 30;
+    desc.format = VL_CHANNEL_RGBA;
+    desc.defaultChannelValue = floatToF16(0.75f);
+    ImageF16 image(desc);
+
+    UP<IImage> resizedImage = image.resize(45, 60);
+    EXPECT_EQ(resizedImage->getWidth(), 45);
+    EXPECT_EQ(resizedImage->getHeight(), 60);
+    EXPECT_EQ(resizedImage->getDataType(), VL_FLOAT16);
+    auto pixelPtr = static_cast<const F16*>(resizedImage->getData());
+    for (Size i = 0; i < resizedImage->getCount(); ++i) {
+        EXPECT_NEAR(f16ToFloat(pixelPtr[i]), 0.75f, 0.001f);
+    }
+}
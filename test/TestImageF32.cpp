@@ -66,6 +66,27 @@ TEST_F(TestImageF32, ReadImageFromFileOtherFormat) {
     }
 }
 
+TEST_F(TestImageF32, ReadImageFromFileDecoderFormat) {
+    /*
+     * Request RGBA from an RGB HDR file, which the decoder produces directly.
+     */
+    ImageLoadDesc desc;
+    desc.fileName = fs::current_path() / "Resources" / "Red-100x100-F32-RGB.hdr";
+    desc.requestedFormat = VL_CHANNEL_RGBA;
+    desc.fillMode = VL_FILL_MAX;
+    ImageF32 image(desc);
+    EXPECT_EQ(image.getChannelFormat(), VL_CHANNEL_RGBA);
+    EXPECT_EQ(image.getCount(), 100 * 100 * 4);
+
+    auto pixelPtr = static_cast<float*>(image.getData());
+    for (Size i = 0; i < image.getCount(); i += 4) {
+        EXPECT_NEAR(pixelPtr[i], 1.0f, 0.01f);  // R
+        EXPECT_FLOAT_EQ(pixelPtr[i + 1], 0.0f); // G
+        EXPECT_FLOAT_EQ(pixelPtr[i + 2], 0.0f); // B
+        EXPECT_FLOAT_EQ(pixelPtr[i + 3], 1.0f); // A (filled by the decoder)
+    }
+}
+
 TEST_F(TestImageF32, CreateImageFromData) {
     /*
      * Create a 50x50 red image in F32 RGB format from raw data and verify its properties and pixel data.
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <VelyraImage/ImageFactory.hpp>
+#include <fstream>
 
 using namespace Velyra;
 using namespace Velyra::Image;
@@ -19,3 +20,147 @@ TEST_F(TestImageFactory, TestCreateImageUI8FromFile) {
     EXPECT_EQ(image->getChannelFormat(), VL_CHANNEL_RGB);
     EXPECT_EQ(image->getDataType(), VL_UINT8);
 }
+
+TEST_F(TestImageFactory, TestCreateImageMemoryMapped) {
+    /*
+     * Load both an LDR and an HDR image through a memory mapping of the file.
+     */
+    ImageLoadDesc desc;
+    desc.fileName = fs::current_path() / "Resources" / "Red-100x100-UI8-RGB.png";
+    desc.loadMode = VL_LOAD_MEMORY_MAP;
+    desc.requestedFormat = VL_CHANNEL_RGBA;
+    UP<IImage> image = ImageFactory::createImage(desc);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->getWidth(), 100);
+    EXPECT_EQ(image->getHeight(), 100);
+    EXPECT_EQ(image->getChannelFormat(), VL_CHANNEL_RGBA);
+    EXPECT_EQ(image->getDataType(), VL_UINT8);
+
+    desc.fileName = fs::current_path() / "Resources" / "Red-100x100-F32-RGB.hdr";
+    desc.requestedFormat = VL_CHANNEL_FORMAT_MAX_VALUE;
+    UP<IImage> hdrImage = ImageFactory::createImage(desc);
+    ASSERT_NE(hdrImage, nullptr);
+    EXPECT_EQ(hdrImage->getChannelFormat(), VL_CHANNEL_RGB);
+    EXPECT_EQ(hdrImage->getDataType(), VL_FLOAT32);
+}
+
+TEST_F(TestImageFactory, TestCreateImageFromMemory) {
+    /*
+     * Read the encoded file into memory ourselves and decode it from there.
+     */
+    const fs::path testImagePath = fs::current_path() / "Resources" / "Red-100x100-UI8-RGBA.png";
+    std::ifstream file(testImagePath, std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+    std::vector<std::byte> encoded(fs::file_size(testImagePath));
+    file.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+
+    ImageLoadDesc desc;
+    desc.fileName = testImagePath;
+    UP<IImage> image = ImageFactory::createImageFromMemory(encoded, desc);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->getWidth(), 100);
+    EXPECT_EQ(image->getHeight(), 100);
+    EXPECT_EQ(image->getChannelFormat(), VL_CHANNEL_RGBA);
+    EXPECT_EQ(image->getDataType(), VL_UINT8);
+
+    auto pixelPtr = static_cast<U8*>(image->getData());
+    EXPECT_EQ(pixelPtr[0], 255); // R
+    EXPECT_EQ(pixelPtr[1], 0);   // G
+    EXPECT_EQ(pixelPtr[2], 0);   // B
+}
+
+TEST_F(TestImageFactory, TestCreateImageFromInvalidMemory) {
+    const std::vector<std::byte> encoded(64, std::byte{0x42});
+    ImageLoadDesc desc;
+    desc.fileName = "Garbage";
+    UP<IImage> image = ImageFactory::createImageFromMemory(encoded, desc);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->getWidth(), 0);
+    EXPECT_EQ(image->getHeight(), 0);
+}
+
+TEST_F(TestImageFactory, TestCreateImagesBatch) {
+    /*
+     * Load a mix of UI8 and F32 images concurrently and verify they come back in input order. The red images look the
+     * same either way up, so a vertical gradient is included to check that every image got its own flipOnLoad.
+     */
+    constexpr Size gradientWidth = 4;
+    constexpr Size gradientHeight = 8;
+    std::vector<U8> gradientData(gradientWidth * gradientHeight * 3, 0);
+    for (Size i = 0; i < gradientData.size(); i += 3) {
+        gradientData[i] = static_cast<U8>(i / (gradientWidth * 3) * 30); // R grows with the row
+    }
+    ImageU8Desc gradientDesc;
+    gradientDesc.width = gradientWidth;
+    gradientDesc.height = gradientHeight;
+    gradientDesc.format = VL_CHANNEL_RGB;
+    gradientDesc.data = gradientData.data();
+    ImageWriteDesc writeDesc;
+    writeDesc.fileName = fs::current_path() / "TestImageFactory-TestCreateImagesBatch-Gradient-4x8-UI8-RGB.png";
+    writeDesc.fileType = VL_IMAGE_PNG;
+    ImageFactory::createImageU8(gradientDesc)->write(writeDesc);
+
+    const fs::path resources = fs::current_path() / "Resources";
+    const std::array<fs::path, 4> files = {
+        resources / "Red-100x100-UI8-RGB.png",
+        resources / "Red-100x100-F32-RGB.hdr",
+        resources / "Red-100x100-UI8-RGBA.png",
+        writeDesc.fileName
+    };
+    std::vector<ImageLoadDesc> descs;
+    for (Size i = 0; i < 16; ++i) {
+        ImageLoadDesc desc;
+        desc.fileName = files[i % files.size()];
+        desc.flipOnLoad = i / files.size() % 2 == 0; // Every file is loaded both flipped and unflipped
+        descs.push_back(desc);
+    }
+
+    const std::vector<UP<IImage>> images = ImageFactory::createImages(descs, 4);
+    ASSERT_EQ(images.size(), descs.size());
+    for (Size i = 0; i < images.size(); ++i) {
+        ASSERT_NE(images[i], nullptr);
+        switch (i % files.size()) {
+            case 0: {
+                EXPECT_EQ(images[i]->getWidth(), 100);
+                EXPECT_EQ(images[i]->getHeight(), 100);
+                EXPECT_EQ(images[i]->getDataType(), VL_UINT8);
+                EXPECT_EQ(images[i]->getChannelFormat(), VL_CHANNEL_RGB);
+                break;
+            }
+            case 1: {
+                EXPECT_EQ(images[i]->getWidth(), 100);
+                EXPECT_EQ(images[i]->getHeight(), 100);
+                EXPECT_EQ(images[i]->getDataType(), VL_FLOAT32);
+                EXPECT_EQ(images[i]->getChannelFormat(), VL_CHANNEL_RGB);
+                break;
+            }
+            case 2: {
+                EXPECT_EQ(images[i]->getWidth(), 100);
+                EXPECT_EQ(images[i]->getHeight(), 100);
+                EXPECT_EQ(images[i]->getDataType(), VL_UINT8);
+                EXPECT_EQ(images[i]->getChannelFormat(), VL_CHANNEL_RGBA);
+                break;
+            }
+            default: {
+                EXPECT_EQ(images[i]->getWidth(), gradientWidth);
+                EXPECT_EQ(images[i]->getHeight(), gradientHeight);
+                EXPECT_EQ(images[i]->getDataType(), VL_UINT8);
+                EXPECT_EQ(images[i]->getChannelFormat(), VL_CHANNEL_RGB);
+                // Row 0 is the last row of the file if the image was flipped on load
+                const U8 expectedRed = descs[i].flipOnLoad ? static_cast<U8>((gradientHeight - 1) * 30) : 0;
+                const auto pixelPtr = static_cast<const U8*>(images[i]->getData());
+                for (Size x = 0; x < gradientWidth; ++x) {
+                    EXPECT_EQ(pixelPtr[x * 3], expectedRed);
+                }
+                break;
+            }
+        }
+    }
+}
+
+TEST_F(TestImageFactory, TestCreateImagesBatchMissingFile) {
+    ImageLoadDesc desc;
+    desc.fileName = fs::current_path() / "Resources" / "DoesNotExist.png";
+    const std::vector<ImageLoadDesc> descs = {desc, desc};
+    EXPECT_ANY_THROW(ImageFactory::createImages(descs, 2));
+}
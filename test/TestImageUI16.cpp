@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <VelyraImage/ImageDefs.hpp>
+#include <VelyraImage/ImageFactory.hpp>
+
+#include "../src/ImageU16.hpp"
+
+using namespace Velyra;
+using namespace Velyra::Image;
+
+class TestImageUI16 : public ::testing::Test {
+protected:
+
+    static std::vector<U16> createGradient(const Size width, const Size height, const U32 channelCount) {
+        std::vector<U16> data(width * height * channelCount);
+        for (Size i = 0; i < data.size(); ++i) {
+            // Values that do not survive a round trip through 8 bits
+            data[i] = static_cast<U16>((i * 4099 + 1) % 65536);
+        }
+        return data;
+    }
+};
+
+TEST_F(TestImageUI16, ReadImageFromFile) {
+    /*
+     * Load the 8-bit red test image as a 16-bit image, every 8-bit value v becomes v * 257.
+     */
+    ImageLoadDesc desc;
+    desc.fileName = fs::current_path() / "Resources" / "Red-100x100-UI8-RGB.png";
+    ImageU16 image(desc);
+    EXPECT_EQ(image.getWidth(), 100);
+    EXPECT_EQ(image.getHeight(), 100);
+    EXPECT_EQ(image.getChannelFormat(), VL_CHANNEL_RGB);
+    EXPECT_EQ(image.getDataType(), VL_UINT16);
+    EXPECT_EQ(image.getSize(), 100 * 100 * 3 * sizeof(U16));
+    auto pixelPtr = static_cast<U16*>(image.getData());
+    for (Size i = 0; i < image.getCount(); i += 3) {
+        EXPECT_EQ(pixelPtr[i], 65535);   // R
+        EXPECT_EQ(pixelPtr[i + 1], 0);   // G
+        EXPECT_EQ(pixelPtr[i + 2], 0);   // B
+    }
+}
+
+TEST_F(TestImageUI16, WriteImageToFile) {
+    /*
+     * Write a 16-bit gradient to a PNG for every channel count, read it back and verify that all 16 bits survived.
+     */
+    constexpr U32 width = 23;
+    constexpr U32 height = 17;
+    for (const VL_CHANNEL_FORMAT format : {VL_CHANNEL_R, VL_CHANNEL_RG, VL_CHANNEL_RGB, VL_CHANNEL_RGBA}) {
+        const U32 channelCount = getChannelCountFromFormat(format);
+        const std::vector<U16> imageData = createGradient(width, height, channelCount);
+
+        ImageUI16Desc desc;
+        desc.width = width;
+        desc.height = height;
+        desc.format = format;
+        desc.data = imageData.data();
+        ImageU16 image(desc);
+
+        const fs::path outputImagePath = fs::current_path() / ("TestImageUI16-WriteImageToFile-" + std::to_string(channelCount) + ".png");
+        ImageWriteDesc writeDesc;
+        writeDesc.fileName = outputImagePath;
+        writeDesc.fileType = VL_IMAGE_PNG;
+        writeDesc.flipOnWrite = true;
+        image.write(writeDesc);
+
+        ImageLoadDesc loadDesc;
+        loadDesc.fileName = outputImagePath;
+        loadDesc.flipOnLoad = true;
+        UP<IImage> loadedImage = ImageFactory::createImage(loadDesc);
+        ASSERT_NE(loadedImage, nullptr);
+        EXPECT_EQ(loadedImage->getDataType(), VL_UINT16);
+        EXPECT_EQ(loadedImage->getWidth(), width);
+        EXPECT_EQ(loadedImage->getHeight(), height);
+        EXPECT_EQ(loadedImage->getChannelFormat(), format);
+        ASSERT_EQ(loadedImage->getCount(), imageData.size());
+        auto pixelPtr = static_cast<const U16*>(loadedImage->getData());
+        for (Size i = 0; i < imageData.size(); ++i) {
+            ASSERT_EQ(pixelPtr[i], imageData[i]) << "at index " << i << " with " << channelCount << " channels";
+        }
+    }
+}
+
+TEST_F(TestImageUI16, WriteUnsupportedFileType) {
+    ImageUI16Desc desc;
+    desc.width = 4;
+    desc.height = 4;
+    ImageU16 image(desc);
+
+    ImageWriteDesc writeDesc;
+    writeDesc.fileName = fs::current_path() / "TestImageUI16-WriteUnsupportedFileType.jpg";
+    writeDesc.fileType = VL_IMAGE_JPG;
+    fs::remove(writeDesc.fileName);
+    image.write(writeDesc); // Only PNG stores 16 bits per channel, other file types are not written
+    EXPECT_FALSE(fs::exists(writeDesc.fileName));
+}
+
+TEST_F(TestImageUI16, ResizeImage) {
+    ImageUI16Desc desc;
+    desc.width = 30;
+    desc.height = 30;
+    desc.format = VL_CHANNEL_RGB;
+    desc.defaultChannelValue = 40000;
+    ImageU16 image(desc);
+
+    UP<IImage> resizedImage = image.resize(60, 45);
+    EXPECT_EQ(resizedImage->getWidth(), 60);
+    EXPECT_EQ(resizedImage->getHeight(), 45);
+    EXPECT_EQ(resizedImage->getDataType(), VL_UINT16);
+    EXPECT_EQ(resizedImage->getCount(), 60 * 45 * 3);
+    auto pixelPtr = static_cast<const U16*>(resizedImage->getData());
+    for (Size i = 0; i < resizedImage->getCount(); ++i) {
+        EXPECT_NEAR(pixelPtr[i], 40000, 1);
+    }
+}
+
+TEST_F(TestImageUI16, TranslateDataType) {
+    ImageUI16Desc desc;
+    desc.width = 8;
+    desc.height = 8;
+    desc.format = VL_CHANNEL_RG;
+    const std::vector<U16> imageData = createGradient(desc.width, desc.height, 2);
+    desc.data = imageData.data();
+    ImageU16 image(desc);
+
+    TranslationDesc translationDesc;
+    translationDesc.targetType = VL_UINT8;
+    UP<IImage> imageU8 = image.translateDataType(translationDesc);
+    translationDesc.targetType = VL_FLOAT32;
+    UP<IImage> imageF32 = image.translateDataType(translationDesc);
+    translationDesc.targetType = VL_UINT16;
+    UP<IImage> imageU16 = imageF32->translateDataType(translationDesc);
+
+    auto u8Ptr = static_cast<const U8*>(imageU8->getData());
+    auto f32Ptr = static_cast<const float*>(imageF32->getData());
+    auto u16Ptr = static_cast<const U16*>(imageU16->getData());
+    for (Size i = 0; i < imageData.size(); ++i) {
+        EXPECT_EQ(u8Ptr[i], (imageData[i] + 128) / 257);
+        EXPECT_FLOAT_EQ(f32Ptr[i], static_cast<float>(imageData[i]) / 65535.0f);
+        EXPECT_EQ(u16Ptr[i], imageData[i]); // F32 holds every 16-bit value exactly enough to round back
+    }
+}
@@ -2,9 +2,14 @@
 #include <VelyraImage/ImageDefs.hpp>
 
 #include "../src/ImageU8.hpp"
+#include "TypeUtils.hpp"
+
+#include <cstring>
+#include <fstream>
 
 using namespace Velyra;
 using namespace Velyra::Image;
+using namespace Velyra::Test;
 
 class TestImageUI8 : public ::testing::Test {
 protected:
@@ -66,6 +71,56 @@ TEST_F(TestImageUI8, ReadImageFromFileOtherFormat) {
     }
 }
 
+TEST_F(TestImageUI8, ReadImageFromFileDecoderFormat) {
+    /*
+     * Request formats the decoder can produce directly: RGBA from an RGB file and RGB from an RGBA file.
+     */
+    {
+        ImageLoadDesc desc;
+        desc.fileName = fs::current_path() / "Resources" / "Red-100x100-UI8-RGB.png";
+        desc.requestedFormat = VL_CHANNEL_RGBA;
+        desc.fillMode = VL_FILL_MAX;
+        ImageU8 image(desc);
+        EXPECT_EQ(image.getChannelFormat(), VL_CHANNEL_RGBA);
+        EXPECT_EQ(image.getCount(), 100 * 100 * 4);
+
+        auto pixelPtr = static_cast<U8*>(image.getData());
+        for (Size i = 0; i < image.getCount(); i += 4) {
+            EXPECT_EQ(pixelPtr[i], 255);     // R
+            EXPECT_EQ(pixelPtr[i + 1], 0);   // G
+            EXPECT_EQ(pixelPtr[i + 2], 0);   // B
+            EXPECT_EQ(pixelPtr[i + 3], 255); // A (filled by the decoder)
+        }
+    }
+    {
+        ImageLoadDesc desc;
+        desc.fileName = fs::current_path() / "Resources" / "Red-100x100-UI8-RGBA.png";
+        desc.requestedFormat = VL_CHANNEL_RGB;
+        ImageU8 image(desc);
+        EXPECT_EQ(image.getChannelFormat(), VL_CHANNEL_RGB);
+        EXPECT_EQ(image.getCount(), 100 * 100 * 3);
+        checkRedImage(image);
+    }
+}
+
+TEST_F(TestImageUI8, ReadImageFromFileFillMin) {
+    /*
+     * The decoder always fills alpha with the max value, a min fill must still be honoured.
+     */
+    ImageLoadDesc desc;
+    desc.fileName = fs::current_path() / "Resources" / "Red-100x100-UI8-RGB.png";
+    desc.requestedFormat = VL_CHANNEL_RGBA;
+    desc.fillMode = VL_FILL_MIN;
+    ImageU8 image(desc);
+    EXPECT_EQ(image.getChannelFormat(), VL_CHANNEL_RGBA);
+
+    auto pixelPtr = static_cast<U8*>(image.getData());
+    for (Size i = 0; i < image.getCount(); i += 4) {
+        EXPECT_EQ(pixelPtr[i], 255);    // R
+        EXPECT_EQ(pixelPtr[i + 3], 0);  // A (filled with min value)
+    }
+}
+
 TEST_F(TestImageUI8, CreateImageFromData) {
     /*
      * Create a 50x50 red image in UI8 RGB format from raw data and verify its properties and pixel data.
@@ -96,6 +151,24 @@ TEST_F(TestImageUI8, CreateImageFromData) {
     checkRedImage(image);
 }
 
+TEST_F(TestImageUI8, CreateEmptyImage) {
+    /*
+     * Create an image without data, the buffer must be filled with the requested default channel value.
+     */
+    ImageU8Desc desc;
+    desc.width = 10;
+    desc.height = 10;
+    desc.format = VL_CHANNEL_RG;
+    desc.defaultChannelValue = 7;
+
+    ImageU8 image(desc);
+    EXPECT_EQ(image.getCount(), 10 * 10 * 2);
+    auto pixelPtr = static_cast<U8*>(image.getData());
+    for (Size i = 0; i < image.getCount(); ++i) {
+        EXPECT_EQ(pixelPtr[i], 7);
+    }
+}
+
 TEST_F(TestImageUI8, WriteImageToFile) {
     /*
      * Create a 20x20 red image in UI8 RGB format, write it to a file, then read it back and verify its properties and pixel data.
@@ -176,4 +249,285 @@ TEST_F(TestImageUI8, ResizeImage) {
     EXPECT_EQ(resizedImage->getCount(), newWidth * newHeight * 3);
     EXPECT_EQ(resizedImage->getSize(), newWidth * newHeight * 3 * sizeof(U8));
     checkRedImage(*resizedImage);
-}
\ No newline at end of file
+}
+
+TEST_F(TestImageUI8, FlipVertical) {
+    /*
+     * Flip images with an odd and an even number of rows in every SIMD mode, the middle row of the odd image stays in place.
+     */
+    constexpr U32 width = 45; // 135 bytes per row, so the SIMD kernels have a tail
+    for (const U32 height : {7u, 8u}) {
+        for (const VL_SIMD_MODE mode : {VL_SIMD_SCALAR, VL_SIMD_SSE2, VL_SIMD_AVX2, VL_SIMD_AVX512}) {
+            std::vector<U8> imageData(width * height * 3);
+            for (Size i = 0; i < imageData.size(); ++i) {
+                imageData[i] = static_cast<U8>(i % 251);
+            }
+            ImageU8Desc desc;
+            desc.width = width;
+            desc.height = height;
+            desc.format = VL_CHANNEL_RGB;
+            desc.data = imageData.data();
+            ImageU8 image(desc);
+
+            FlipDesc flipDesc;
+            flipDesc.simdMode = mode;
+            image.flipVertical(flipDesc);
+
+            const auto* pixelPtr = static_cast<const U8*>(image.getData());
+            for (Size y = 0; y < height; ++y) {
+                for (Size x = 0; x < width * 3; ++x) {
+                    ASSERT_EQ(pixelPtr[y * width * 3 + x], imageData[(height - 1 - y) * width * 3 + x]) << "Mode " << mode << ", row " << y;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(TestImageUI8, FlipDuringConversion) {
+    /*
+     * Converting with flipVertical gives the same pixels as converting and flipping afterwards.
+     */
+    constexpr U32 width = 19;
+    constexpr U32 height = 11;
+    std::vector<U8> imageData(width * height * 3);
+    for (Size i = 0; i < imageData.size(); ++i) {
+        imageData[i] = static_cast<U8>(i % 251);
+    }
+    ImageU8Desc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = VL_CHANNEL_RGB;
+    desc.data = imageData.data();
+    ImageU8 image(desc);
+
+    for (const VL_CHANNEL_FORMAT targetFormat : {VL_CHANNEL_RGB, VL_CHANNEL_BGR, VL_CHANNEL_BGRA, VL_CHANNEL_R}) {
+        FormatConversionDesc conversionDesc;
+        conversionDesc.targetFormat = targetFormat;
+        auto expectedImage = image.convertToFormat(conversionDesc);
+        expectedImage->flipVertical();
+
+        conversionDesc.flipVertical = true;
+        const auto flippedImage = image.convertToFormat(conversionDesc);
+        ImageU8 inPlaceImage(desc);
+        inPlaceImage.convertToFormatInPlace(conversionDesc);
+
+        ASSERT_EQ(flippedImage->getCount(), expectedImage->getCount());
+        ASSERT_EQ(inPlaceImage.getCount(), expectedImage->getCount());
+        const auto* expectedData = static_cast<const U8*>(expectedImage->getData());
+        const auto* flippedData = static_cast<const U8*>(flippedImage->getData());
+        const auto* inPlaceData = static_cast<const U8*>(inPlaceImage.getData());
+        for (Size i = 0; i < expectedImage->getCount(); ++i) {
+            ASSERT_EQ(flippedData[i], expectedData[i]) << "Format " << targetFormat << ", element " << i;
+            ASSERT_EQ(inPlaceData[i], expectedData[i]) << "Format " << targetFormat << ", element " << i;
+        }
+    }
+}
+
+TEST_F(TestImageUI8, FlipOnLoadAndWrite) {
+    /*
+     * Write an image with distinct rows, then load it with and without flip, with and without a format conversion.
+     */
+    constexpr U32 width = 16;
+    constexpr U32 height = 9;
+    std::vector<U8> imageData(width * height * 3);
+    for (Size i = 0; i < imageData.size(); ++i) {
+        imageData[i] = static_cast<U8>(i / (width * 3) * 20 + i % 3);
+    }
+    ImageU8Desc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = VL_CHANNEL_RGB;
+    desc.data = imageData.data();
+    ImageU8 image(desc);
+
+    const fs::path outputImagePath = fs::current_path() / "TestImageUI8-FlipOnLoadAndWrite.png";
+    ImageWriteDesc writeDesc;
+    writeDesc.fileName = outputImagePath;
+    writeDesc.fileType = VL_IMAGE_PNG;
+    writeDesc.flipOnWrite = true;
+    image.write(writeDesc);
+
+    for (const bool flip : {false, true}) {
+        for (const VL_CHANNEL_FORMAT requestedFormat : {VL_CHANNEL_FORMAT_MAX_VALUE, VL_CHANNEL_BGR}) {
+            ImageLoadDesc loadDesc;
+            loadDesc.fileName = outputImagePath;
+            loadDesc.flipOnLoad = flip;
+            loadDesc.requestedFormat = requestedFormat;
+            ImageU8 loadedImage(loadDesc);
+            ASSERT_EQ(loadedImage.getCount(), imageData.size());
+
+            const bool bgr = requestedFormat == VL_CHANNEL_BGR;
+            const auto* pixelPtr = static_cast<const U8*>(loadedImage.getData());
+            for (Size y = 0; y < height; ++y) {
+                // The file is stored upside down, loading with flip restores the original order
+                const Size sourceRow = flip ? y : height - 1 - y;
+                for (Size x = 0; x < width; ++x) {
+                    for (Size c = 0; c < 3; ++c) {
+                        const Size sourceChannel = bgr ? 2 - c : c;
+                        ASSERT_EQ(pixelPtr[(y * width + x) * 3 + c], imageData[(sourceRow * width + x) * 3 + sourceChannel])
+                            << "Flip " << flip << ", row " << y;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(TestImageUI8, WritePngCompressionLevels) {
+    /*
+     * Large enough to filter and compress in parallel: every level and both execution policies must round trip, and
+     * the file must not depend on the execution policy.
+     */
+    constexpr U32 width = 700;
+    constexpr U32 height = 500;
+    std::vector<U8> imageData(width * height * 4);
+    fillNoise(imageData, 0x2545F491);
+    for (Size i = 0; i < imageData.size(); ++i) {
+        imageData[i] = static_cast<U8>(i / (width * 4) + i % (width * 4) / 8 + (imageData[i] & 0x3));
+    }
+    ImageU8Desc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = VL_CHANNEL_RGBA;
+    desc.data = imageData.data();
+    ImageU8 image(desc);
+
+    const auto readFile = [](const fs::path& fileName) {
+        std::ifstream file(fileName, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    Size previousSize = std::numeric_limits<Size>::max();
+    for (const U32 level : {0u, 1u, 6u, 9u}) {
+        std::vector<char> files[2];
+        for (const VL_EXECUTION_POLICY policy : {VL_EXECUTION_SEQUENTIAL, VL_EXECUTION_PARALLEL}) {
+            ImageWriteDesc writeDesc;
+            writeDesc.fileName = fs::current_path() / ("TestImageUI8-WritePngCompressionLevels-" + std::to_string(level) +
+                "-" + std::to_string(policy) + ".png");
+            writeDesc.fileType = VL_IMAGE_PNG;
+            writeDesc.compressionLevel = level;
+            writeDesc.executionPolicy = policy;
+            image.write(writeDesc);
+
+            ImageLoadDesc loadDesc;
+            loadDesc.fileName = writeDesc.fileName;
+            loadDesc.flipOnLoad = false;
+            ImageU8 loadedImage(loadDesc);
+            ASSERT_EQ(loadedImage.getSize(), imageData.size()) << "Level " << level;
+            EXPECT_EQ(std::memcmp(loadedImage.getData(), imageData.data(), imageData.size()), 0) << "Level " << level;
+            files[policy] = readFile(writeDesc.fileName);
+        }
+        EXPECT_EQ(files[VL_EXECUTION_SEQUENTIAL], files[VL_EXECUTION_PARALLEL]) << "Level " << level;
+        EXPECT_LE(files[VL_EXECUTION_PARALLEL].size(), previousSize) << "Level " << level;
+        previousSize = files[VL_EXECUTION_PARALLEL].size();
+    }
+}
+
+TEST_F(TestImageUI8, WriteJpgQualityAndSubsampling) {
+    /*
+     * Large enough to encode in several bands: lower qualities and coarser chroma must give smaller files that still
+     * decode close to the source, and the file must not depend on the SIMD mode or the execution policy.
+     */
+    constexpr U32 width = 701;
+    constexpr U32 height = 499;
+    std::vector<U8> imageData(width * height * 3);
+    fillNoise(imageData, 0x2545F491);
+    for (U32 y = 0; y < height; ++y) {
+        for (U32 x = 0; x < width; ++x) {
+            for (U32 c = 0; c < 3; ++c) {
+                U8& value = imageData[(y * width + x) * 3 + c];
+                value = static_cast<U8>((x * (c + 1) + y * (3 - c)) / 8 + (value & 0x3));
+            }
+        }
+    }
+    ImageU8Desc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = VL_CHANNEL_RGB;
+    desc.data = imageData.data();
+    ImageU8 image(desc);
+
+    const auto readFile = [](const fs::path& fileName) {
+        std::ifstream file(fileName, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    constexpr std::array<U32, 3> qualities = {100, 90, 50};
+    std::array<Size, qualities.size()> fullChromaSizes{};
+    for (const VL_JPG_SUBSAMPLING subsampling : {VL_JPG_SUBSAMPLING_444, VL_JPG_SUBSAMPLING_422, VL_JPG_SUBSAMPLING_420}) {
+        Size previousSize = std::numeric_limits<Size>::max();
+        for (Size q = 0; q < qualities.size(); ++q) {
+            const U32 quality = qualities[q];
+            ImageWriteDesc writeDesc;
+            writeDesc.fileName = fs::current_path() / ("TestImageUI8-WriteJpgQualityAndSubsampling-" +
+                std::to_string(subsampling) + "-" + std::to_string(quality) + ".jpg");
+            writeDesc.fileType = VL_IMAGE_JPG;
+            writeDesc.jpgQuality = quality;
+            writeDesc.jpgSubsampling = subsampling;
+            image.write(writeDesc);
+            const std::vector<char> file = readFile(writeDesc.fileName);
+
+            ImageLoadDesc loadDesc;
+            loadDesc.fileName = writeDesc.fileName;
+            loadDesc.flipOnLoad = false;
+            ImageU8 loadedImage(loadDesc);
+            ASSERT_EQ(loadedImage.getSize(), imageData.size()) << "Quality " << quality;
+            const auto* loaded = static_cast<const U8*>(loadedImage.getData());
+            double error = 0.0;
+            for (Size i = 0; i < imageData.size(); ++i) {
+                error += std::abs(static_cast<int>(loaded[i]) - static_cast<int>(imageData[i]));
+            }
+            EXPECT_LT(error / static_cast<double>(imageData.size()), quality == 100 ? 2.0 : 3.0) << "Quality " << quality;
+            EXPECT_LT(file.size(), previousSize) << "Quality " << quality;
+            previousSize = file.size();
+            if (subsampling == VL_JPG_SUBSAMPLING_444) {
+                fullChromaSizes[q] = file.size();
+            }
+            else {
+                EXPECT_LT(file.size(), fullChromaSizes[q]) << "Quality " << quality;
+            }
+
+            writeDesc.simdMode = VL_SIMD_SCALAR;
+            writeDesc.executionPolicy = VL_EXECUTION_SEQUENTIAL;
+            image.write(writeDesc);
+            EXPECT_EQ(readFile(writeDesc.fileName), file) << "Quality " << quality;
+        }
+    }
+}
+
+TEST_F(TestImageUI8, WriteJpgGrey) {
+    /*
+     * Grey images are written as YCbCr with zero chroma like stb_image_write did, so they load back as RGB with equal
+     * channels. Sizes that are not a multiple of the block size repeat the last row and column.
+     */
+    constexpr U32 width = 37;
+    constexpr U32 height = 23;
+    for (const VL_CHANNEL_FORMAT format : {VL_CHANNEL_R, VL_CHANNEL_RG}) {
+        const Size channelCount = getChannelCountFromFormat(format);
+        std::vector<U8> imageData(width * height * channelCount, 0); // Alpha is dropped
+        for (Size i = 0; i < width * height; ++i) {
+            imageData[i * channelCount] = static_cast<U8>(i % width * 5 + i / width * 3);
+        }
+        ImageU8Desc desc;
+        desc.width = width;
+        desc.height = height;
+        desc.format = format;
+        desc.data = imageData.data();
+        ImageU8 image(desc);
+
+        ImageWriteDesc writeDesc;
+        writeDesc.fileName = fs::current_path() / ("TestImageUI8-WriteJpgGrey-" + std::to_string(channelCount) + ".jpg");
+        writeDesc.fileType = VL_IMAGE_JPG;
+        writeDesc.flipOnWrite = true;
+        image.write(writeDesc);
+
+        ImageLoadDesc loadDesc;
+        loadDesc.fileName = writeDesc.fileName;
+        loadDesc.flipOnLoad = true;
+        ImageU8 loadedImage(loadDesc);
+        ASSERT_EQ(loadedImage.getChannelFormat(), VL_CHANNEL_RGB) << "Format " << format;
+        ASSERT_EQ(loadedImage.getPixelCount(), width * height) << "Format " << format;
+        const auto* loaded = static_cast<const U8*>(loadedImage.getData());
+        for (Size i = 0; i < loadedImage.getCount(); ++i) {
+            EXPECT_NEAR(loaded[i], imageData[i / 3 * channelCount], 2) << "Format " << format << " at value " << i;
+        }
+    }
+}
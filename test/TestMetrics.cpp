@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <VelyraImage/ImageFactory.hpp>
+#include <VelyraImage/Metrics.hpp>
+
+#include "../src/ImageUtils.hpp"
+#include "../src/LoggerNames.hpp"
+
+#include <string>
+#include <thread>
+
+using namespace Velyra;
+using namespace Velyra::Image;
+
+class TestMetrics : public ::testing::Test {
+protected:
+    void SetUp() override {
+        resetMetrics();
+    }
+
+    static UP<IImage> createImage(const Size width, const Size height, const VL_CHANNEL_FORMAT format) {
+        ImageU8Desc desc;
+        desc.width = width;
+        desc.height = height;
+        desc.format = format;
+        return ImageFactory::createImageU8(desc);
+    }
+};
+
+TEST_F(TestMetrics, ResetClearsCounters) {
+    createImage(4, 4, VL_CHANNEL_RGBA);
+    EXPECT_EQ(getMetrics().imagesCreated, 1);
+
+    resetMetrics();
+    const ImageMetrics metrics = getMetrics();
+    EXPECT_EQ(metrics.imagesCreated, 0);
+    for (const auto& modes : metrics.operations) {
+        for (const OperationMetrics& operation : modes) {
+            EXPECT_EQ(operation.count, 0);
+            EXPECT_EQ(operation.bytes, 0);
+            EXPECT_EQ(operation.nanoseconds, 0);
+        }
+    }
+}
+
+TEST_F(TestMetrics, CountsCreatedImages) {
+    const UP<IImage> image = createImage(8, 8, VL_CHANNEL_RGB);
+    TranslationDesc translationDesc;
+    translationDesc.targetType = VL_FLOAT32;
+    const UP<IImage> translated = image->translateDataType(translationDesc);
+    FormatConversionDesc conversionDesc;
+    conversionDesc.targetFormat = VL_CHANNEL_RGBA;
+    const UP<IImage> converted = image->convertToFormat(conversionDesc);
+    EXPECT_EQ(getMetrics().imagesCreated, 3);
+}
+
+TEST_F(TestMetrics, CountsOperationsUnderResolvedSimdMode) {
+    const UP<IImage> image = createImage(8, 8, VL_CHANNEL_RGB);
+    FormatConversionDesc desc;
+    desc.targetFormat = VL_CHANNEL_RGBA;
+    desc.simdMode = VL_SIMD_SCALAR;
+    image->convertToFormat(desc);
+    desc.simdMode = VL_SIMD_BEST;
+    image->convertToFormat(desc);
+
+    const ImageMetrics metrics = getMetrics();
+    const VL_SIMD_MODE bestMode = findBestMode(VL_SIMD_BEST);
+    const OperationMetrics& scalar = metrics.get(VL_OPERATION_CONVERT_FORMAT, VL_SIMD_SCALAR);
+    const OperationMetrics& best = metrics.get(VL_OPERATION_CONVERT_FORMAT, bestMode);
+    if (bestMode == VL_SIMD_SCALAR) {
+        EXPECT_EQ(scalar.count, 2);
+    }
+    else {
+        EXPECT_EQ(scalar.count, 1);
+        EXPECT_EQ(best.count, 1);
+    }
+    EXPECT_EQ(metrics.get(VL_OPERATION_CONVERT_FORMAT, VL_SIMD_BEST).count, 0);
+
+    const OperationMetrics total = metrics.getTotal(VL_OPERATION_CONVERT_FORMAT);
+    EXPECT_EQ(total.count, 2);
+    EXPECT_EQ(total.bytes, 2 * (8 * 8 * 3 + 8 * 8 * 4));
+}
+
+TEST_F(TestMetrics, CountsBytesOfEveryOperation) {
+    const UP<IImage> image = createImage(16, 8, VL_CHANNEL_RGBA);
+    const Size imageBytes = 16 * 8 * 4;
+
+    TranslationDesc translationDesc;
+    translationDesc.targetType = VL_FLOAT32;
+    image->translateDataType(translationDesc);
+    image->flipVertical();
+    image->resize(8, 4);
+    TransformDesc transformDesc;
+    transformDesc.targetFormat = VL_CHANNEL_RGB;
+    transformDesc.targetType = VL_FLOAT32;
+    image->transform(transformDesc);
+
+    const ImageMetrics metrics = getMetrics();
+    EXPECT_EQ(metrics.getTotal(VL_OPERATION_TRANSLATE_DATA_TYPE).bytes, imageBytes + imageBytes * sizeof(float));
+    EXPECT_EQ(metrics.getTotal(VL_OPERATION_FLIP).bytes, 2 * imageBytes);
+    EXPECT_EQ(metrics.getTotal(VL_OPERATION_RESIZE).bytes, imageBytes + 8 * 4 * 4);
+    EXPECT_EQ(metrics.getTotal(VL_OPERATION_TRANSFORM).bytes, imageBytes + 16 * 8 * 3 * sizeof(float));
+    for (const VL_IMAGE_OPERATION operation : {VL_OPERATION_TRANSLATE_DATA_TYPE, VL_OPERATION_FLIP, VL_OPERATION_RESIZE, VL_OPERATION_TRANSFORM}) {
+        EXPECT_EQ(metrics.getTotal(operation).count, 1) << "operation " << operation;
+    }
+}
+
+TEST_F(TestMetrics, CountsLoadAndWrite) {
+    ImageLoadDesc loadDesc;
+    loadDesc.fileName = fs::current_path() / "Resources" / "Red-100x100-UI8-RGB.png";
+    const UP<IImage> image = ImageFactory::createImage(loadDesc);
+
+    ImageWriteDesc writeDesc;
+    writeDesc.fileName = fs::current_path() / "TestMetrics-CountsLoadAndWrite.bmp";
+    writeDesc.fileType = VL_IMAGE_BMP;
+    image->write(writeDesc);
+
+    const ImageMetrics metrics = getMetrics();
+    EXPECT_EQ(metrics.get(VL_OPERATION_LOAD, VL_SIMD_BEST).count, 1);
+    EXPECT_EQ(metrics.get(VL_OPERATION_LOAD, VL_SIMD_BEST).bytes, 100 * 100 * 3);
+    EXPECT_EQ(metrics.get(VL_OPERATION_WRITE, VL_SIMD_BEST).count, 1);
+    EXPECT_EQ(metrics.get(VL_OPERATION_WRITE, VL_SIMD_BEST).bytes, 100 * 100 * 3);
+}
+
+TEST_F(TestMetrics, CountsConcurrentOperations) {
+    constexpr Size threadCount = 4;
+    constexpr Size conversionsPerThread = 100;
+    const UP<IImage> image = createImage(8, 8, VL_CHANNEL_RGBA);
+
+    std::vector<std::thread> threads;
+    for (Size t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&image] {
+            FormatConversionDesc desc;
+            desc.targetFormat = VL_CHANNEL_BGRA;
+            for (Size i = 0; i < conversionsPerThread; ++i) {
+                image->convertToFormat(desc);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const ImageMetrics metrics = getMetrics();
+    EXPECT_EQ(metrics.imagesCreated, threadCount * conversionsPerThread + 1); // + 1 for the source image
+    EXPECT_EQ(metrics.getTotal(VL_OPERATION_CONVERT_FORMAT).count, threadCount * conversionsPerThread);
+    EXPECT_EQ(metrics.getTotal(VL_OPERATION_CONVERT_FORMAT).bytes, threadCount * conversionsPerThread * 2 * 8 * 8 * 4);
+}
+
+TEST_F(TestMetrics, CachesLoggers) {
+    spdlog::logger* logger = getCachedLogger(LOGGER_UI8);
+    ASSERT_NE(logger, nullptr);
+    EXPECT_EQ(getCachedLogger(LOGGER_UI8), logger);
+    EXPECT_NE(getCachedLogger(LOGGER_F32), logger);
+    // Names are compared by content, not by address
+    const std::string copiedName = LOGGER_UI8;
+    EXPECT_EQ(getCachedLogger(copiedName.c_str()), logger);
+    EXPECT_ANY_THROW(getCachedLogger("VL-IMG-UNKNOWN"));
+}
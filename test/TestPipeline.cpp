@@ -0,0 +1,349 @@
+#include <gtest/gtest.h>
+
+#include <VelyraImage/ImageFactory.hpp>
+#include <VelyraImage/Pipeline.hpp>
+
+#include "TypeUtils.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+using namespace Velyra;
+using namespace Velyra::Image;
+using namespace Velyra::Test;
+
+class TestPipeline : public ::testing::Test {
+protected:
+
+    /**
+     * Gradient with noise, so resizes and conversions produce different values for every pixel.
+     */
+    static UP<IImage> createImage(const VL_TYPE type, const Size width, const Size height, const VL_CHANNEL_FORMAT format) {
+        const Size count = width * height * getChannelCountFromFormat(format);
+        std::vector<U8> noise(count);
+        fillNoise(noise, 0x9E3779B9);
+        std::vector<float> values(count);
+        for (Size i = 0; i < count; ++i) {
+            values[i] = static_cast<float>(i % 251) / 251.0f * 0.75f + static_cast<float>(noise[i]) / 255.0f * 0.25f;
+        }
+        ImageF32Desc desc;
+        desc.width = width;
+        desc.height = height;
+        desc.format = format;
+        desc.data = values.data();
+        UP<IImage> image = ImageFactory::createImageF32(desc);
+        if (type == VL_FLOAT32) {
+            return image;
+        }
+        TranslationDesc translationDesc;
+        translationDesc.targetType = type;
+        return image->translateDataType(translationDesc);
+    }
+
+    static void expectEqualImages(const IImage& actual, const IImage& expected) {
+        ASSERT_EQ(actual.getWidth(), expected.getWidth());
+        ASSERT_EQ(actual.getHeight(), expected.getHeight());
+        ASSERT_EQ(actual.getChannelFormat(), expected.getChannelFormat());
+        ASSERT_EQ(actual.getDataType(), expected.getDataType());
+        ASSERT_EQ(actual.getSize(), expected.getSize());
+        EXPECT_EQ(std::memcmp(actual.getData(), expected.getData(), actual.getSize()), 0);
+    }
+
+    /**
+     * Resizing in strips changes the order of some float operations, so the values may differ in the last bits. Values
+     * that are divided by a small alpha are compared relative to their magnitude.
+     */
+    static void expectNearImages(const IImage& actual, const IImage& expected) {
+        ASSERT_EQ(actual.getWidth(), expected.getWidth());
+        ASSERT_EQ(actual.getHeight(), expected.getHeight());
+        ASSERT_EQ(actual.getChannelFormat(), expected.getChannelFormat());
+        ASSERT_EQ(actual.getDataType(), expected.getDataType());
+        float tolerance = 1e-5f;
+        switch (expected.getDataType()) {
+            case VL_UINT8:   tolerance = 1.01f / 255.0f; break;
+            case VL_UINT16:  tolerance = 1.01f / 65535.0f; break;
+            case VL_FLOAT16: tolerance = 2e-3f; break;
+            default: break;
+        }
+        TranslationDesc translationDesc;
+        translationDesc.targetType = VL_FLOAT32;
+        const UP<IImage> actualF32 = actual.translateDataType(translationDesc);
+        const UP<IImage> expectedF32 = expected.translateDataType(translationDesc);
+        const auto* actualValues = static_cast<const float*>(actualF32->getData());
+        const auto* expectedValues = static_cast<const float*>(expectedF32->getData());
+        Size mismatchCount = 0;
+        for (Size i = 0; i < expectedF32->getSize() / sizeof(float); ++i) {
+            if (std::abs(actualValues[i] - expectedValues[i]) > tolerance * std::max(1.0f, std::abs(expectedValues[i]))) {
+                ++mismatchCount;
+            }
+        }
+        EXPECT_EQ(mismatchCount, 0);
+    }
+
+    static UP<IImage> load(const fs::path& fileName) {
+        ImageLoadDesc loadDesc;
+        loadDesc.fileName = fileName;
+        loadDesc.flipOnLoad = false;
+        return ImageFactory::createImage(loadDesc);
+    }
+
+    static std::vector<char> readFile(const fs::path& fileName) {
+        std::ifstream file(fileName, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    static constexpr std::array<Size, 4> STRIP_ROW_COUNTS = {1, 3, 16, 1000};
+};
+
+TEST_F(TestPipeline, ImageSourceReadsStrips) {
+    const UP<IImage> image = createImage(VL_UINT8, 13, 10, VL_CHANNEL_RGB);
+    for (const bool flip : {false, true}) {
+        const UP<IRowSource> source = RowPipeline::createImageSource(*image, flip);
+        EXPECT_EQ(source->getLayout().getRowSize(), 13 * 3);
+        Size nextRow = 0;
+        for (RowStrip strip = source->readRows(4); strip.rowCount != 0; strip = source->readRows(4)) {
+            EXPECT_EQ(strip.firstRow, nextRow);
+            EXPECT_EQ(strip.rowCount, std::min<Size>(4, 10 - nextRow));
+            for (Size i = 0; i < strip.rowCount; ++i) {
+                const Size imageRow = flip ? 9 - (nextRow + i) : nextRow + i;
+                EXPECT_EQ(std::memcmp(static_cast<const U8*>(strip.data) + i * 13 * 3,
+                    static_cast<const U8*>(image->getData()) + imageRow * 13 * 3, 13 * 3), 0);
+            }
+            nextRow += strip.rowCount;
+        }
+        EXPECT_EQ(nextRow, 10);
+    }
+
+    const UP<IImage> flipped = RowPipeline::toImage(*RowPipeline::createImageSource(*image, true), 3);
+    image->flipVertical();
+    expectEqualImages(*flipped, *image);
+}
+
+TEST_F(TestPipeline, ConvertsLikeWholeImages) {
+    for (const VL_TYPE type : {VL_UINT8, VL_UINT16, VL_FLOAT16, VL_FLOAT32}) {
+        const UP<IImage> image = createImage(type, 37, 29, VL_CHANNEL_RGB);
+        FormatConversionDesc conversionDesc;
+        conversionDesc.targetFormat = VL_CHANNEL_BGRA;
+        conversionDesc.fillMode = VL_FILL_MIN;
+        const UP<IImage> expected = image->convertToFormat(conversionDesc);
+        for (const Size stripRowCount : STRIP_ROW_COUNTS) {
+            const UP<IRowSource> pipeline = RowPipeline::convertToFormat(RowPipeline::createImageSource(*image), conversionDesc);
+            expectEqualImages(*RowPipeline::toImage(*pipeline, stripRowCount), *expected);
+        }
+    }
+}
+
+TEST_F(TestPipeline, TranslatesLikeWholeImages) {
+    const std::array<std::pair<VL_TYPE, VL_TYPE>, 6> typePairs = {{
+        {VL_UINT8, VL_FLOAT32}, {VL_FLOAT32, VL_UINT8}, {VL_UINT16, VL_UINT8},
+        {VL_UINT8, VL_UINT16}, {VL_FLOAT32, VL_FLOAT16}, {VL_FLOAT16, VL_UINT8}
+    }};
+    for (const auto& [sourceType, targetType] : typePairs) {
+        const UP<IImage> image = createImage(sourceType, 41, 23, VL_CHANNEL_RGBA);
+        TranslationDesc translationDesc;
+        translationDesc.targetType = targetType;
+        const UP<IImage> expected = image->translateDataType(translationDesc);
+        for (const Size stripRowCount : STRIP_ROW_COUNTS) {
+            const UP<IRowSource> pipeline = RowPipeline::translateDataType(RowPipeline::createImageSource(*image), translationDesc);
+            expectEqualImages(*RowPipeline::toImage(*pipeline, stripRowCount), *expected);
+        }
+    }
+
+    const UP<IImage> image = createImage(VL_UINT16, 4, 4, VL_CHANNEL_RGBA);
+    TranslationDesc translationDesc;
+    translationDesc.targetType = VL_FLOAT16;
+    EXPECT_ANY_THROW(RowPipeline::translateDataType(RowPipeline::createImageSource(*image), translationDesc));
+}
+
+TEST_F(TestPipeline, TransformsLikeWholeImages) {
+    const UP<IImage> image = createImage(VL_UINT8, 31, 17, VL_CHANNEL_BGR);
+    TransformDesc transformDesc;
+    transformDesc.targetFormat = VL_CHANNEL_RGBA;
+    transformDesc.targetType = VL_FLOAT32;
+    const UP<IImage> expected = image->transform(transformDesc);
+    for (const Size stripRowCount : STRIP_ROW_COUNTS) {
+        const UP<IRowSource> pipeline = RowPipeline::transform(RowPipeline::createImageSource(*image), transformDesc);
+        expectEqualImages(*RowPipeline::toImage(*pipeline, stripRowCount), *expected);
+    }
+
+    transformDesc.flipVertical = true;
+    EXPECT_ANY_THROW(RowPipeline::transform(RowPipeline::createImageSource(*image), transformDesc));
+}
+
+TEST_F(TestPipeline, ResizesLikeWholeImages) {
+    const std::array<std::pair<Size, Size>, 5> targetSizes = {{{19, 11}, {97, 83}, {40, 7}, {5, 120}, {1, 1}}};
+    for (const VL_TYPE type : {VL_UINT8, VL_UINT16, VL_FLOAT16, VL_FLOAT32}) {
+        const UP<IImage> image = createImage(type, 47, 53, VL_CHANNEL_RGBA);
+        for (const auto& [width, height] : targetSizes) {
+            const UP<IImage> expected = image->resize(width, height);
+            for (const Size stripRowCount : STRIP_ROW_COUNTS) {
+                const UP<IRowSource> pipeline = RowPipeline::resize(RowPipeline::createImageSource(*image), width, height);
+                SCOPED_TRACE(::testing::Message() << "type " << type << " size " << width << "x" << height << " strip " << stripRowCount);
+                expectNearImages(*RowPipeline::toImage(*pipeline, stripRowCount), *expected);
+            }
+        }
+    }
+}
+
+TEST_F(TestPipeline, ResizeReadsInputInBoundedWindow) {
+    /*
+     * A source that checks that the resize never holds much more than the rows its filter needs: it counts the rows
+     * read ahead of the output.
+     */
+    class CountingSource : public IRowSource {
+    public:
+        explicit CountingSource(UP<IRowSource> source): m_Source(std::move(source)) {}
+
+        const RowLayout& getLayout() const override { return m_Source->getLayout(); }
+
+        RowStrip readRows(const Size maxRowCount) override {
+            const RowStrip strip = m_Source->readRows(maxRowCount);
+            rowsRead += strip.rowCount;
+            return strip;
+        }
+
+        UP<IRowSource> m_Source;
+        Size rowsRead = 0;
+    };
+
+    const UP<IImage> image = createImage(VL_UINT8, 16, 1000, VL_CHANNEL_R);
+    auto counting = createUP<CountingSource>(RowPipeline::createImageSource(*image));
+    CountingSource& countingSource = *counting;
+    const UP<IRowSource> pipeline = RowPipeline::resize(std::move(counting), 16, 500);
+    Size outputRows = 0;
+    for (RowStrip strip = pipeline->readRows(10); strip.rowCount != 0; strip = pipeline->readRows(10)) {
+        outputRows += strip.rowCount;
+        // Every output row needs about two input rows plus the reach of the filter, plus one pulled strip
+        EXPECT_LE(countingSource.rowsRead, std::min<Size>(2 * outputRows + 20, 1000));
+    }
+    EXPECT_EQ(outputRows, 500);
+    EXPECT_EQ(countingSource.rowsRead, 1000);
+}
+
+TEST_F(TestPipeline, WritesPng) {
+    for (const VL_TYPE type : {VL_UINT8, VL_UINT16}) {
+        for (const VL_CHANNEL_FORMAT format : {VL_CHANNEL_R, VL_CHANNEL_RG, VL_CHANNEL_RGB, VL_CHANNEL_RGBA}) {
+            // Large enough for several IDAT chunks
+            const UP<IImage> image = createImage(type, 301, 157, format);
+            ImageWriteDesc writeDesc;
+            writeDesc.fileName = fs::current_path() / ("TestPipeline-WritesPng-" + std::to_string(Utils::getTypeSize(type)) + "-" +
+                std::to_string(getChannelCountFromFormat(format)) + ".png");
+            writeDesc.fileType = VL_IMAGE_PNG;
+            RowPipeline::write(*RowPipeline::createImageSource(*image), writeDesc, 7);
+            expectEqualImages(*load(writeDesc.fileName), *image);
+        }
+    }
+}
+
+TEST_F(TestPipeline, WritesBmpLikeImageWrite) {
+    for (const VL_CHANNEL_FORMAT format : {VL_CHANNEL_R, VL_CHANNEL_RG, VL_CHANNEL_RGB, VL_CHANNEL_RGBA}) {
+        for (const bool flip : {false, true}) {
+            const UP<IImage> image = createImage(VL_UINT8, 23, 19, format);
+            const std::string suffix = std::to_string(getChannelCountFromFormat(format)) + (flip ? "-flipped" : "") + ".bmp";
+            ImageWriteDesc writeDesc;
+            writeDesc.fileType = VL_IMAGE_BMP;
+            writeDesc.flipOnWrite = flip;
+            writeDesc.fileName = fs::current_path() / ("TestPipeline-WritesBmp-Expected-" + suffix);
+            image->write(writeDesc);
+            const fs::path expectedFile = writeDesc.fileName;
+            writeDesc.fileName = fs::current_path() / ("TestPipeline-WritesBmp-" + suffix);
+            RowPipeline::write(*RowPipeline::createImageSource(*image), writeDesc, 5);
+            EXPECT_EQ(readFile(writeDesc.fileName), readFile(expectedFile)) << suffix;
+        }
+    }
+}
+
+TEST_F(TestPipeline, WritesHdrLikeImageWrite) {
+    for (const Size width : {5, 37}) { // Narrow scanlines are not run length encoded
+        for (const VL_CHANNEL_FORMAT format : {VL_CHANNEL_R, VL_CHANNEL_RGB, VL_CHANNEL_RGBA}) {
+            const UP<IImage> image = createImage(VL_FLOAT32, width, 21, format);
+            const std::string suffix = std::to_string(width) + "-" + std::to_string(getChannelCountFromFormat(format)) + ".hdr";
+            ImageWriteDesc writeDesc;
+            writeDesc.fileType = VL_IMAGE_HDR;
+            writeDesc.fileName = fs::current_path() / ("TestPipeline-WritesHdr-Expected-" + suffix);
+            image->write(writeDesc);
+            const fs::path expectedFile = writeDesc.fileName;
+            writeDesc.fileName = fs::current_path() / ("TestPipeline-WritesHdr-" + suffix);
+            RowPipeline::write(*RowPipeline::createImageSource(*image), writeDesc, 4);
+            expectEqualImages(*load(writeDesc.fileName), *load(expectedFile));
+
+            // Half float rows are translated while writing
+            TranslationDesc translationDesc;
+            translationDesc.targetType = VL_FLOAT16;
+            RowPipeline::write(*RowPipeline::translateDataType(RowPipeline::createImageSource(*image), translationDesc), writeDesc);
+            EXPECT_NE(load(writeDesc.fileName), nullptr);
+        }
+    }
+}
+
+TEST_F(TestPipeline, WritesJpg) {
+    const UP<IImage> image = createImage(VL_UINT8, 33, 21, VL_CHANNEL_RGB);
+    ImageWriteDesc writeDesc;
+    writeDesc.fileType = VL_IMAGE_JPG;
+    writeDesc.fileName = fs::current_path() / "TestPipeline-WritesJpg-Expected.jpg";
+    image->write(writeDesc);
+    const fs::path expectedFile = writeDesc.fileName;
+    writeDesc.fileName = fs::current_path() / "TestPipeline-WritesJpg.jpg";
+    RowPipeline::write(*RowPipeline::createImageSource(*image), writeDesc, 8);
+    EXPECT_EQ(readFile(writeDesc.fileName), readFile(expectedFile));
+}
+
+TEST_F(TestPipeline, WritesJpgBandsFromUnalignedStrips) {
+    // Four bands with both subsamplings, the last MCU row is incomplete. The strips do not end at MCU rows.
+    const UP<IImage> image = createImage(VL_UINT8, 300, 700, VL_CHANNEL_RGBA);
+    for (const VL_JPG_SUBSAMPLING subsampling : {VL_JPG_SUBSAMPLING_444, VL_JPG_SUBSAMPLING_420}) {
+        ImageWriteDesc writeDesc;
+        writeDesc.fileType = VL_IMAGE_JPG;
+        writeDesc.jpgQuality = 90;
+        writeDesc.jpgSubsampling = subsampling;
+        writeDesc.fileName = fs::current_path() / "TestPipeline-WritesJpgBandsFromUnalignedStrips-Expected.jpg";
+        image->write(writeDesc);
+        const fs::path expectedFile = writeDesc.fileName;
+        writeDesc.fileName = fs::current_path() / "TestPipeline-WritesJpgBandsFromUnalignedStrips.jpg";
+        for (const Size stripRowCount : {1, 5, 37}) {
+            RowPipeline::write(*RowPipeline::createImageSource(*image), writeDesc, stripRowCount);
+            EXPECT_EQ(readFile(writeDesc.fileName), readFile(expectedFile));
+        }
+    }
+}
+
+TEST_F(TestPipeline, RejectsUnsupportedWrites) {
+    const UP<IImage> imageF32 = createImage(VL_FLOAT32, 4, 4, VL_CHANNEL_RGBA);
+    ImageWriteDesc writeDesc;
+    writeDesc.fileName = fs::current_path() / "TestPipeline-RejectsUnsupportedWrites.png";
+    writeDesc.fileType = VL_IMAGE_PNG;
+    EXPECT_ANY_THROW(RowPipeline::write(*RowPipeline::createImageSource(*imageF32), writeDesc));
+
+    const UP<IImage> imageU8 = createImage(VL_UINT8, 4, 4, VL_CHANNEL_RGBA);
+    writeDesc.flipOnWrite = true;
+    EXPECT_ANY_THROW(RowPipeline::write(*RowPipeline::createImageSource(*imageU8), writeDesc));
+    writeDesc.fileType = VL_IMAGE_JPG;
+    EXPECT_ANY_THROW(RowPipeline::write(*RowPipeline::createImageSource(*imageU8), writeDesc));
+
+    writeDesc.flipOnWrite = false;
+    writeDesc.fileType = VL_IMAGE_HDR;
+    EXPECT_ANY_THROW(RowPipeline::write(*RowPipeline::createImageSource(*imageU8), writeDesc));
+    EXPECT_ANY_THROW(RowPipeline::run(*RowPipeline::createImageSource(*imageU8), *RowPipeline::createFileSink(writeDesc), 0));
+}
+
+TEST_F(TestPipeline, StreamsFileThroughAllStages) {
+    ImageLoadDesc loadDesc;
+    loadDesc.fileName = fs::current_path() / "Resources" / "Red-100x100-UI8-RGB.png";
+    const UP<IImage> image = ImageFactory::createImage(loadDesc);
+    FormatConversionDesc conversionDesc;
+    conversionDesc.targetFormat = VL_CHANNEL_RGBA;
+    TranslationDesc translationDesc;
+    translationDesc.targetType = VL_UINT16;
+    const UP<IImage> expected = image->resize(64, 48)->convertToFormat(conversionDesc)->translateDataType(translationDesc);
+
+    UP<IRowSource> pipeline = RowPipeline::createFileSource(loadDesc);
+    pipeline = RowPipeline::resize(std::move(pipeline), 64, 48);
+    pipeline = RowPipeline::convertToFormat(std::move(pipeline), conversionDesc);
+    pipeline = RowPipeline::translateDataType(std::move(pipeline), translationDesc);
+    ImageWriteDesc writeDesc;
+    writeDesc.fileName = fs::current_path() / "TestPipeline-StreamsFileThroughAllStages.png";
+    writeDesc.fileType = VL_IMAGE_PNG;
+    RowPipeline::write(*pipeline, writeDesc, 10);
+    expectEqualImages(*load(writeDesc.fileName), *expected);
+}
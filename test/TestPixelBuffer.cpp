@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "../src/PixelBuffer.hpp"
+
+using namespace Velyra;
+using namespace Velyra::Image;
+
+class TestPixelBuffer : public ::testing::Test {
+};
+
+TEST_F(TestPixelBuffer, OwnedBuffer) {
+    PixelBuffer<U8> buffer(16, 255);
+    EXPECT_EQ(buffer.size(), 16);
+    EXPECT_FALSE(buffer.isAdopted());
+    for (const U8 value : buffer) {
+        EXPECT_EQ(value, 255);
+    }
+}
+
+TEST_F(TestPixelBuffer, AdoptCallsDeleterOnce) {
+    /*
+     * Adopt a foreign buffer, the deleter must be called exactly once, after the last owner is gone.
+     */
+    Size deleteCount = 0;
+    {
+        auto* data = new float[8]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+        PixelBuffer<float> buffer = PixelBuffer<float>::adopt(data, 8, [&deleteCount](float* pixels) {
+            delete[] pixels;
+            deleteCount++;
+        });
+        EXPECT_TRUE(buffer.isAdopted());
+        EXPECT_EQ(buffer.data(), data); // No copy was made
+        EXPECT_EQ(buffer.size(), 8);
+
+        PixelBuffer<float> moved = std::move(buffer);
+        EXPECT_EQ(moved.data(), data);
+        EXPECT_EQ(buffer.data(), nullptr);
+        EXPECT_EQ(deleteCount, 0);
+
+        // A copy of an adopted buffer is owned by the copy
+        const PixelBuffer<float> copy = moved;
+        EXPECT_FALSE(copy.isAdopted());
+        EXPECT_NE(copy.data(), data);
+        EXPECT_FLOAT_EQ(copy[7], 8.0f);
+    }
+    EXPECT_EQ(deleteCount, 1);
+}
+
+TEST_F(TestPixelBuffer, ResizeReleasesAdoptedBuffer) {
+    Size deleteCount = 0;
+    auto* data = new U8[4]{1, 2, 3, 4};
+    PixelBuffer<U8> buffer = PixelBuffer<U8>::adopt(data, 4, [&deleteCount](U8* pixels) {
+        delete[] pixels;
+        deleteCount++;
+    });
+    buffer.resize(32);
+    EXPECT_EQ(deleteCount, 1);
+    EXPECT_FALSE(buffer.isAdopted());
+    EXPECT_EQ(buffer.size(), 32);
+}
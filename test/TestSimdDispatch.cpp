@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include "../src/SimdDispatch.hpp"
+#include "../src/ImageUtils.hpp"
+
+using namespace Velyra;
+using namespace Velyra::Image;
+
+class TestSimdDispatch : public ::testing::Test {
+};
+
+TEST_F(TestSimdDispatch, ParseSimdMode) {
+    EXPECT_EQ(parseSimdMode("best"), VL_SIMD_BEST);
+    EXPECT_EQ(parseSimdMode("scalar"), VL_SIMD_SCALAR);
+    EXPECT_EQ(parseSimdMode("sse2"), VL_SIMD_SSE2);
+    EXPECT_EQ(parseSimdMode("ssse3"), VL_SIMD_SSSE3);
+    EXPECT_EQ(parseSimdMode("SSE41"), VL_SIMD_SSE41);
+    EXPECT_EQ(parseSimdMode("Avx2"), VL_SIMD_AVX2);
+    EXPECT_EQ(parseSimdMode("avx512"), VL_SIMD_AVX512);
+    EXPECT_EQ(parseSimdMode("neon"), VL_SIMD_MODE_MAX_VALUE);
+    EXPECT_EQ(parseSimdMode(""), VL_SIMD_MODE_MAX_VALUE);
+}
+
+TEST_F(TestSimdDispatch, FindBestModeIsSupported) {
+    for (int i = 0; i < VL_SIMD_MODE_MAX_VALUE; ++i) {
+        const auto mode = static_cast<VL_SIMD_MODE>(i);
+        const VL_SIMD_MODE resolved = findBestMode(mode);
+        EXPECT_NE(resolved, VL_SIMD_BEST);
+        EXPECT_TRUE(isSimdModeSupported(resolved));
+        if (isSimdModeSupported(mode) && mode != VL_SIMD_BEST) {
+            EXPECT_EQ(resolved, mode);
+        }
+    }
+    EXPECT_EQ(findBestMode(VL_SIMD_MODE_MAX_VALUE), VL_SIMD_SCALAR);
+}
+
+TEST_F(TestSimdDispatch, TablesMatchResolvedMode) {
+    for (int i = 0; i < VL_SIMD_MODE_MAX_VALUE; ++i) {
+        const auto mode = static_cast<VL_SIMD_MODE>(i);
+        const SimdDispatchTable& table = getDispatchTable(mode);
+        EXPECT_EQ(table.mode, findBestMode(mode));
+        EXPECT_NE(table.convertFormatU8, nullptr);
+        EXPECT_NE(table.convertFormatF32, nullptr);
+        EXPECT_NE(table.translateU8ToF32, nullptr);
+        EXPECT_NE(table.translateF32ToU8, nullptr);
+        EXPECT_NE(table.resize, nullptr);
+        EXPECT_NE(table.resizeRows, nullptr);
+        EXPECT_NE(table.jpgConvertColor, nullptr);
+        EXPECT_NE(table.jpgForwardDct, nullptr);
+    }
+    // The table is built once, repeated lookups return the same instance
+    EXPECT_EQ(&getDispatchTable(VL_SIMD_SCALAR), &getDispatchTable(VL_SIMD_SCALAR));
+}
+
+TEST_F(TestSimdDispatch, ResizeMatchesBaseline) {
+    constexpr int width = 67;
+    constexpr int height = 41;
+    constexpr int targetWidth = 29;
+    constexpr int targetHeight = 53;
+    std::vector<U8> sourceU8(width * height * 4);
+    std::vector<float> sourceF32(sourceU8.size());
+    for (Size i = 0; i < sourceU8.size(); ++i) {
+        sourceU8[i] = static_cast<U8>((i * 37 + i / 7) % 256);
+        sourceF32[i] = static_cast<float>(sourceU8[i]) / 255.0f;
+    }
+
+    // The scalar table always uses the baseline build of stb_image_resize2
+    const SimdDispatchTable& baseline = getDispatchTable(VL_SIMD_SCALAR);
+    const SimdDispatchTable& best = getDispatchTable(VL_SIMD_BEST);
+
+    std::vector<U8> expectedU8(targetWidth * targetHeight * 4);
+    std::vector<U8> actualU8(expectedU8.size());
+    ASSERT_TRUE(baseline.resize(sourceU8.data(), width, height, 0, expectedU8.data(), targetWidth, targetHeight, 0,
+        STBIR_RGBA, STBIR_TYPE_UINT8, 1, nullptr, nullptr));
+    ASSERT_TRUE(best.resize(sourceU8.data(), width, height, 0, actualU8.data(), targetWidth, targetHeight, 0,
+        STBIR_RGBA, STBIR_TYPE_UINT8, 1, nullptr, nullptr));
+    for (Size i = 0; i < expectedU8.size(); ++i) {
+        EXPECT_NEAR(actualU8[i], expectedU8[i], 1) << "at index " << i;
+    }
+
+    std::vector<float> expectedF32(expectedU8.size());
+    std::vector<float> actualF32(expectedU8.size());
+    ASSERT_TRUE(baseline.resize(sourceF32.data(), width, height, 0, expectedF32.data(), targetWidth, targetHeight, 0,
+        STBIR_RGBA, STBIR_TYPE_FLOAT, 1, nullptr, nullptr));
+    ASSERT_TRUE(best.resize(sourceF32.data(), width, height, 0, actualF32.data(), targetWidth, targetHeight, 0,
+        STBIR_RGBA, STBIR_TYPE_FLOAT, 1, nullptr, nullptr));
+    for (Size i = 0; i < expectedF32.size(); ++i) {
+        EXPECT_NEAR(actualF32[i], expectedF32[i], 1e-5f) << "at index " << i;
+    }
+}
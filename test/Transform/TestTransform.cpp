@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <VelyraImage/ImageFactory.hpp>
+#include <VelyraUtils/TypeTraits.hpp>
+
+#include "../TypeUtils.hpp"
+
+using namespace Velyra;
+using namespace Velyra::Image;
+using namespace Velyra::Test;
+
+template<VL_TYPE TargetType>
+struct TargetTypeWrapper {
+    static constexpr VL_TYPE Type = TargetType;
+};
+
+using TargetDataTypes = Utils::TypeList<
+    TargetTypeWrapper<VL_UINT8>,
+    TargetTypeWrapper<VL_UINT16>,
+    TargetTypeWrapper<VL_FLOAT32>
+>;
+
+using Combinations = Utils::CartesianProduct<ImageDataTypes, SimdModes, TargetDataTypes>;
+using TransformCases = Utils::ToGTestTypes<Combinations::type>::type;
+
+template<typename Case>
+class TestTransform : public ::testing::Test {
+public:
+    using SourceType = std::tuple_element_t<0, Case>;
+    using TargetType = typename Utils::VLTypeToCpp<std::tuple_element_t<2, Case>::Type>::type;
+    static constexpr VL_SIMD_MODE SimdMode = std::tuple_element_t<1, Case>::SimdMode;
+    static constexpr VL_TYPE TargetDataType = std::tuple_element_t<2, Case>::Type;
+
+    // Odd sizes so every row ends in the scalar tails of the kernels
+    static constexpr Size m_Width = 37;
+    static constexpr Size m_Height = 9;
+
+    static constexpr std::array<VL_CHANNEL_FORMAT, 6> m_Formats = {
+        VL_CHANNEL_R, VL_CHANNEL_RG, VL_CHANNEL_RGB, VL_CHANNEL_RGBA, VL_CHANNEL_BGR, VL_CHANNEL_BGRA
+    };
+
+public:
+    void SetUp() override {
+        if (!isSimdModeSupported(SimdMode)) {
+            GTEST_SKIP() << "SIMD mode " << static_cast<int>(SimdMode) << " is not supported on this machine";
+        }
+    }
+
+    static UP<IImage> createImage(const VL_CHANNEL_FORMAT format) {
+        std::vector<SourceType> data(m_Width * m_Height * getChannelCountFromFormat(format));
+        for (Size i = 0; i < data.size(); ++i) {
+            if constexpr (std::is_same_v<SourceType, float>) {
+                data[i] = static_cast<float>(i % 311) / 310.0f;
+            }
+            else if constexpr (std::is_same_v<SourceType, U16>) {
+                data[i] = static_cast<U16>((i % 263) * 249);
+            }
+            else {
+                data[i] = static_cast<U8>(i % 251);
+            }
+        }
+        if constexpr (std::is_same_v<SourceType, float>) {
+            ImageF32Desc desc;
+            desc.width = m_Width;
+            desc.height = m_Height;
+            desc.format = format;
+            desc.data = data.data();
+            return ImageFactory::createImageF32(desc);
+        }
+        else if constexpr (std::is_same_v<SourceType, U16>) {
+            ImageUI16Desc desc;
+            desc.width = m_Width;
+            desc.height = m_Height;
+            desc.format = format;
+            desc.data = data.data();
+            return ImageFactory::createImageU16(desc);
+        }
+        else {
+            ImageU8Desc desc;
+            desc.width = m_Width;
+            desc.height = m_Height;
+            desc.format = format;
+            desc.data = data.data();
+            return ImageFactory::createImageU8(desc);
+        }
+    }
+
+    // The two step conversion that transform replaces
+    static UP<IImage> createExpectedImage(const IImage& image, const VL_CHANNEL_FORMAT targetFormat,
+        const VL_FORMAT_CONVERSION_FILL fillMode) {
+        FormatConversionDesc conversionDesc;
+        conversionDesc.targetFormat = targetFormat;
+        conversionDesc.fillMode = fillMode;
+        conversionDesc.simdMode = SimdMode;
+        const auto convertedImage = image.convertToFormat(conversionDesc);
+
+        TranslationDesc translationDesc;
+        translationDesc.targetType = TargetDataType;
+        translationDesc.simdMode = SimdMode;
+        return convertedImage->translateDataType(translationDesc);
+    }
+
+    static void expectEqualImages(const IImage& expected, const IImage& actual, const bool flipped) {
+        ASSERT_EQ(expected.getWidth(), actual.getWidth());
+        ASSERT_EQ(expected.getHeight(), actual.getHeight());
+        ASSERT_EQ(expected.getChannelFormat(), actual.getChannelFormat());
+        ASSERT_EQ(expected.getDataType(), actual.getDataType());
+
+        const Size rowCount = expected.getWidth() * getChannelCountFromFormat(expected.getChannelFormat());
+        const auto* expectedData = static_cast<const TargetType*>(expected.getData());
+        const auto* actualData = static_cast<const TargetType*>(actual.getData());
+        for (Size y = 0; y < expected.getHeight(); ++y) {
+            const Size expectedRow = flipped ? expected.getHeight() - 1 - y : y;
+            for (Size x = 0; x < rowCount; ++x) {
+                ASSERT_EQ(expectedData[expectedRow * rowCount + x], actualData[y * rowCount + x]) << "Row " << y << ", element " << x;
+            }
+        }
+    }
+};
+
+TYPED_TEST_SUITE(TestTransform, TransformCases);
+
+TYPED_TEST(TestTransform, MatchesConvertAndTranslate) {
+    for (const VL_CHANNEL_FORMAT sourceFormat : TestFixture::m_Formats) {
+        const auto image = TestFixture::createImage(sourceFormat);
+        for (const VL_CHANNEL_FORMAT targetFormat : TestFixture::m_Formats) {
+            for (const VL_FORMAT_CONVERSION_FILL fillMode : {VL_FILL_MIN, VL_FILL_MAX}) {
+                const auto expectedImage = TestFixture::createExpectedImage(*image, targetFormat, fillMode);
+                for (const bool flip : {false, true}) {
+                    SCOPED_TRACE(testing::Message() << "Transform " << static_cast<int>(sourceFormat) << " -> "
+                        << static_cast<int>(targetFormat) << ", fill " << static_cast<int>(fillMode) << ", flip " << flip);
+                    TransformDesc desc;
+                    desc.targetFormat = targetFormat;
+                    desc.fillMode = fillMode;
+                    desc.targetType = TestFixture::TargetDataType;
+                    desc.flipVertical = flip;
+                    desc.simdMode = TestFixture::SimdMode;
+                    const auto transformedImage = image->transform(desc);
+                    ASSERT_NE(transformedImage, nullptr);
+                    TestFixture::expectEqualImages(*expectedImage, *transformedImage, flip);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(TestTransform, UnsetFieldsKeepImage) {
+    // Only flips, format and type stay the same
+    const auto image = TestFixture::createImage(VL_CHANNEL_RGB);
+    TransformDesc desc;
+    desc.flipVertical = true;
+    desc.simdMode = TestFixture::SimdMode;
+    const auto transformedImage = image->transform(desc);
+    ASSERT_NE(transformedImage, nullptr);
+    EXPECT_EQ(transformedImage->getChannelFormat(), VL_CHANNEL_RGB);
+    EXPECT_EQ(transformedImage->getDataType(), image->getDataType());
+
+    const Size rowCount = image->getWidth() * 3;
+    const auto* sourceData = static_cast<const typename TestFixture::SourceType*>(image->getData());
+    const auto* targetData = static_cast<const typename TestFixture::SourceType*>(transformedImage->getData());
+    for (Size y = 0; y < image->getHeight(); ++y) {
+        for (Size x = 0; x < rowCount; ++x) {
+            ASSERT_EQ(sourceData[(image->getHeight() - 1 - y) * rowCount + x], targetData[y * rowCount + x]);
+        }
+    }
+}
+
+TYPED_TEST(TestTransform, UnsupportedFormatThrows) {
+    const auto image = TestFixture::createImage(VL_CHANNEL_RGB);
+    TransformDesc desc;
+    desc.targetFormat = static_cast<VL_CHANNEL_FORMAT>(0);
+    desc.targetType = TestFixture::TargetDataType;
+    desc.simdMode = TestFixture::SimdMode;
+    EXPECT_ANY_THROW(image->transform(desc));
+}
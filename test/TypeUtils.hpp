@@ -5,9 +5,11 @@
 
 #include <VelyraImage/ImageDefs.hpp>
 
+#include <span>
+
 namespace Velyra::Test {
 
-    using ImageDataTypes = Utils::TypeList<float, U8>;
+    using ImageDataTypes = Utils::TypeList<float, U8, U16>;
 
     template<VL_SIMD_MODE Mode>
     struct SimdWrapper {
@@ -16,7 +18,24 @@ namespace Velyra::Test {
 
     using SimdModes = Utils::TypeList<
         SimdWrapper<VL_SIMD_SCALAR>,
-        SimdWrapper<VL_SIMD_AVX2>
+        SimdWrapper<VL_SIMD_SSE2>,
+        SimdWrapper<VL_SIMD_SSSE3>,
+        SimdWrapper<VL_SIMD_SSE41>,
+        SimdWrapper<VL_SIMD_AVX2>,
+        SimdWrapper<VL_SIMD_AVX512>
     >;
 
+    /**
+     * @brief Fills data with xorshift64 noise, the same bytes for the same seed on every platform.
+     * @param seed Must not be zero
+     */
+    inline void fillNoise(const std::span<U8> data, U64 seed) {
+        for (U8& value : data) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            value = static_cast<U8>(seed >> 56);
+        }
+    }
+
 }